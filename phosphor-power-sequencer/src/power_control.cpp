@@ -27,6 +27,8 @@
 #include <phosphor-logging/log.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
+#include <sys/epoll.h>
+
 #include <exception>
 #include <string>
 
@@ -43,7 +45,8 @@ const std::string namePropertyName = "Name";
 PowerControl::PowerControl(sdbusplus::bus::bus& bus,
                            const sdeventplus::Event& event) :
     PowerObject{bus, POWER_OBJ_PATH, PowerObject::action::defer_emit},
-    bus{bus}, device{std::make_unique<PowerSequencerMonitor>(bus)},
+    bus{bus}, event{event},
+    device{std::make_unique<PowerSequencerMonitor>(bus)},
     match{bus,
           sdbusplus::bus::match::rules::interfacesAdded() +
               sdbusplus::bus::match::rules::sender(
@@ -51,13 +54,14 @@ PowerControl::PowerControl(sdbusplus::bus::bus& bus,
           std::bind(&PowerControl::interfacesAddedHandler, this,
                     std::placeholders::_1)},
     powerOnAllowedTime{std::chrono::steady_clock::now() + minimumColdStartTime},
-    timer{event, std::bind(&PowerControl::pollPgood, this), pollInterval}
+    timer{event, std::bind(&PowerControl::pgoodTimeoutExpired, this)},
+    stateTimer{event, std::bind(&PowerControl::setPendingState, this)}
 {
     // Obtain dbus service name
     bus.request_name(POWER_IFACE);
 
     setUpDevice();
-    setUpGpio();
+    setUpGpio(event);
 }
 
 void PowerControl::getDeviceProperties(util::DbusPropertyMap& properties)
@@ -96,7 +100,8 @@ void PowerControl::getDeviceProperties(util::DbusPropertyMap& properties)
                 *name, *i2cBus, *i2cAddress)
                 .c_str());
         // Create device object
-        device = std::make_unique<UCD90320Monitor>(bus, *i2cBus, *i2cAddress);
+        device = std::make_unique<UCD90320Monitor>(bus, event, *i2cBus,
+                                                   *i2cAddress);
         deviceFound = true;
     }
 }
@@ -147,38 +152,8 @@ void PowerControl::interfacesAddedHandler(sdbusplus::message::message& msg)
     }
 }
 
-void PowerControl::pollPgood()
+void PowerControl::checkPgood()
 {
-    if (inStateTransition)
-    {
-        // In transition between power on and off, check for timeout
-        const auto now = std::chrono::steady_clock::now();
-        if (now > pgoodTimeoutTime)
-        {
-            log<level::ERR>(
-                fmt::format("Power state transition timeout, state: {}", state)
-                    .c_str());
-            inStateTransition = false;
-
-            if (state)
-            {
-                // Time out powering on
-                device->onFailure(true, powerSupplyError);
-            }
-            else
-            {
-                // Time out powering off
-                std::map<std::string, std::string> additionalData{};
-                device->logError(
-                    "xyz.openbmc_project.Power.Error.PowerOffTimeout",
-                    additionalData);
-            }
-
-            failureFound = true;
-            return;
-        }
-    }
-
     int pgoodState = pgoodLine.get_value();
     if (pgoodState != pgood)
     {
@@ -201,15 +176,26 @@ void PowerControl::pollPgood()
     {
         // Power good matches requested state
         inStateTransition = false;
+        timer.setEnabled(false);
     }
     else if (!inStateTransition && (pgoodState == 0) && !failureFound)
     {
         // Not in power off state, not changing state, and power good is off
         log<level::ERR>("Chassis pgood failure");
-        device->onFailure(false, powerSupplyError);
         failureFound = true;
 
-        // Power good has failed, call for chassis hard power off
+        // Power good has failed, call for chassis hard power off once the
+        // device has been analyzed. Powering off first would change the
+        // device rail status and GPIO values being analyzed.
+        device->onFailure(false, powerSupplyError,
+                          std::bind(&PowerControl::hardPowerOff, this));
+    }
+}
+
+void PowerControl::hardPowerOff()
+{
+    try
+    {
         auto method =
             bus.new_method_call(util::SYSTEMD_SERVICE, util::SYSTEMD_ROOT,
                                 util::SYSTEMD_INTERFACE, "StartUnit");
@@ -217,6 +203,52 @@ void PowerControl::pollPgood()
         method.append("replace");
         bus.call_noreply(method);
     }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>(
+            fmt::format("Unable to start chassis hard power off, error: {}",
+                        e.what())
+                .c_str());
+    }
+}
+
+void PowerControl::pgoodEventReceived()
+{
+    // Drain all pending events.  Only the current line value matters.
+    while (pgoodLine.event_wait(std::chrono::nanoseconds(0)))
+    {
+        pgoodLine.event_read();
+    }
+
+    checkPgood();
+}
+
+void PowerControl::pgoodTimeoutExpired()
+{
+    if (!inStateTransition)
+    {
+        return;
+    }
+
+    log<level::ERR>(
+        fmt::format("Power state transition timeout, state: {}", state)
+            .c_str());
+    inStateTransition = false;
+
+    if (state)
+    {
+        // Time out powering on
+        device->onFailure(true, powerSupplyError, nullptr);
+    }
+    else
+    {
+        // Time out powering off
+        std::map<std::string, std::string> additionalData{};
+        device->logError("xyz.openbmc_project.Power.Error.PowerOffTimeout",
+                         additionalData);
+    }
+
+    failureFound = true;
 }
 
 void PowerControl::setPgoodTimeout(int t)
@@ -235,34 +267,68 @@ void PowerControl::setPowerSupplyError(const std::string& error)
 
 void PowerControl::setState(int s)
 {
+    if (pendingState && (*pendingState == s))
+    {
+        log<level::INFO>(
+            fmt::format("Power state already requested: {}", s).c_str());
+        return;
+    }
     if (state == s)
     {
+        if (pendingState)
+        {
+            // The earlier request has not been set yet, drop it
+            log<level::INFO>(
+                fmt::format("Canceling requested power state: {}",
+                            *pendingState)
+                    .c_str());
+            pendingState.reset();
+            stateTimer.setEnabled(false);
+        }
         log<level::INFO>(
             fmt::format("Power already at requested state: {}", state).c_str());
         return;
     }
+
+    // Wait on a timer so D-Bus requests and power good events are still
+    // handled in the meantime
+    std::chrono::microseconds delay{0};
     if (s == 0)
     {
         // Wait for two seconds when powering down. This is to allow host and
         // other BMC applications time to complete power off processing
-        std::this_thread::sleep_for(std::chrono::seconds(2));
+        delay = std::chrono::seconds(2);
     }
     else
     {
         // If minimum power off time has not passed, wait
-        if (powerOnAllowedTime > std::chrono::steady_clock::now())
+        const auto now = std::chrono::steady_clock::now();
+        if (powerOnAllowedTime > now)
         {
+            delay = std::chrono::duration_cast<std::chrono::microseconds>(
+                powerOnAllowedTime - now);
             log<level::INFO>(
                 fmt::format(
                     "Waiting {} seconds until power on allowed",
-                    std::chrono::duration_cast<std::chrono::seconds>(
-                        powerOnAllowedTime - std::chrono::steady_clock::now())
+                    std::chrono::duration_cast<std::chrono::seconds>(delay)
                         .count())
                     .c_str());
         }
-        std::this_thread::sleep_until(powerOnAllowedTime);
     }
 
+    pendingState = s;
+    stateTimer.restartOnce(delay);
+}
+
+void PowerControl::setPendingState()
+{
+    if (!pendingState)
+    {
+        return;
+    }
+    int s = *pendingState;
+    pendingState.reset();
+
     log<level::INFO>(fmt::format("setState: {}", s).c_str());
     powerControlLine.request(
         {"phosphor-power-control", gpiod::line_request::DIRECTION_OUTPUT, 0});
@@ -276,10 +342,13 @@ void PowerControl::setState(int s)
             std::chrono::steady_clock::now() + minimumPowerOffTime;
     }
 
-    pgoodTimeoutTime = std::chrono::steady_clock::now() + timeout;
     inStateTransition = true;
+    timer.restartOnce(timeout);
     state = s;
     emitPropertyChangedSignal("state");
+
+    // Power good may have changed while the control line was being set
+    checkPgood();
 }
 
 void PowerControl::setUpDevice()
@@ -312,7 +381,7 @@ void PowerControl::setUpDevice()
     }
 }
 
-void PowerControl::setUpGpio()
+void PowerControl::setUpGpio(const sdeventplus::Event& event)
 {
     const std::string powerControlLineName = "power-chassis-control";
     const std::string pgoodLineName = "power-chassis-good";
@@ -337,8 +406,15 @@ void PowerControl::setUpGpio()
         throw std::runtime_error(errorString);
     }
 
+    // Handle power good changes as soon as they occur instead of polling
     pgoodLine.request(
-        {"phosphor-power-control", gpiod::line_request::DIRECTION_INPUT, 0});
+        {"phosphor-power-control", gpiod::line_request::EVENT_BOTH_EDGES, 0});
+    pgoodEventSource = std::make_unique<sdeventplus::source::IO>(
+        event, pgoodLine.event_get_fd(), EPOLLIN,
+        [this](sdeventplus::source::IO&, int, uint32_t) {
+            this->pgoodEventReceived();
+        });
+
     int pgoodState = pgoodLine.get_value();
     pgood = pgoodState;
     state = pgoodState;
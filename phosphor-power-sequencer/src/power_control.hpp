@@ -11,9 +11,12 @@
 #include <sdbusplus/server/object.hpp>
 #include <sdeventplus/clock.hpp>
 #include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
 #include <sdeventplus/utility/timer.hpp>
 
 #include <chrono>
+#include <memory>
+#include <optional>
 
 namespace phosphor::power::sequencer
 {
@@ -72,6 +75,11 @@ class PowerControl : public PowerObject
      */
     sdbusplus::bus::bus& bus;
 
+    /**
+     * The event object
+     */
+    sdeventplus::Event event;
+
     /**
      * The power sequencer device to monitor.
      */
@@ -113,24 +121,20 @@ class PowerControl : public PowerObject
     int pgood{0};
 
     /**
-     * GPIO line object for chassis power good
+     * GPIO line object for chassis power good, requested for events on both
+     * edges
      */
     gpiod::line pgoodLine;
 
     /**
-     * Power good timeout constant
-     */
-    static constexpr std::chrono::seconds pgoodTimeout{10};
-
-    /**
-     * Point in time at which power good timeout will take place
+     * Event source for the chassis power good GPIO line events
      */
-    std::chrono::time_point<std::chrono::steady_clock> pgoodTimeoutTime;
+    std::unique_ptr<sdeventplus::source::IO> pgoodEventSource;
 
     /**
-     * Poll interval constant
+     * Power good timeout constant
      */
-    static constexpr std::chrono::milliseconds pollInterval{3000};
+    static constexpr std::chrono::seconds pgoodTimeout{10};
 
     /**
      * GPIO line object for power on / power off control
@@ -158,10 +162,20 @@ class PowerControl : public PowerObject
     std::chrono::seconds timeout{pgoodTimeout};
 
     /**
-     * Timer to poll the pgood
+     * Timer for the power good timeout of a state transition
      */
     sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
 
+    /**
+     * Requested power state waiting for the state timer
+     */
+    std::optional<int> pendingState;
+
+    /**
+     * Timer for the delay before a requested power state is set
+     */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> stateTimer;
+
     /**
      * Get the device properties
      * @param properties A map of property names and values
@@ -169,9 +183,29 @@ class PowerControl : public PowerObject
     void getDeviceProperties(util::DbusPropertyMap& properties);
 
     /**
-     * Polling method for monitoring the system power good
+     * Checks the system power good against the requested state
+     */
+    void checkPgood();
+
+    /**
+     * Calls for a chassis hard power off after a power good failure
+     */
+    void hardPowerOff();
+
+    /**
+     * Callback for events on the chassis power good GPIO line
+     */
+    void pgoodEventReceived();
+
+    /**
+     * Callback for the power good timeout of a state transition
+     */
+    void pgoodTimeoutExpired();
+
+    /**
+     * Sets the requested power state once its delay has passed
      */
-    void pollPgood();
+    void setPendingState();
 
     /**
      * Set up power sequencer device
@@ -180,8 +214,9 @@ class PowerControl : public PowerObject
 
     /**
      * Set up GPIOs
+     * @param event event object to monitor the power good GPIO line with
      */
-    void setUpGpio();
+    void setUpGpio(const sdeventplus::Event& event);
 };
 
 } // namespace phosphor::power::sequencer
@@ -83,7 +83,8 @@ void PowerSequencerMonitor::logError(
 }
 
 void PowerSequencerMonitor::onFailure(bool timeout,
-                                      const std::string& powerSupplyError)
+                                      const std::string& powerSupplyError,
+                                      std::function<void()> analyzed)
 {
     std::map<std::string, std::string> additionalData{};
     if (!powerSupplyError.empty())
@@ -106,6 +107,10 @@ void PowerSequencerMonitor::onFailure(bool timeout,
     {
         createBmcDump();
     }
+    if (analyzed)
+    {
+        analyzed();
+    }
 }
 
 } // namespace phosphor::power::sequencer
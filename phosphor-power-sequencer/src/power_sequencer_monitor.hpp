@@ -2,6 +2,7 @@
 
 #include <sdbusplus/bus.hpp>
 
+#include <functional>
 #include <map>
 #include <string>
 
@@ -43,8 +44,11 @@ class PowerSequencerMonitor
      * @param powerSupplyError The power supply error to log. A default
      * std:string, i.e. empty string (""), is passed when there is no power
      * supply error to log.
+     * @param analyzed Function to call once the device has been analyzed,
+     * such as to power off the chassis. May be empty.
      */
-    virtual void onFailure(bool timeout, const std::string& powerSupplyError);
+    virtual void onFailure(bool timeout, const std::string& powerSupplyError,
+                           std::function<void()> analyzed);
 
   protected:
     /**
@@ -47,7 +47,9 @@ const std::string compatibleNamesProperty = "Names";
 
 namespace device_error = sdbusplus::xyz::openbmc_project::Common::Device::Error;
 
-UCD90320Monitor::UCD90320Monitor(sdbusplus::bus::bus& bus, std::uint8_t i2cBus,
+UCD90320Monitor::UCD90320Monitor(sdbusplus::bus::bus& bus,
+                                 const sdeventplus::Event& event,
+                                 std::uint8_t i2cBus,
                                  std::uint16_t i2cAddress) :
     PowerSequencerMonitor(bus),
     match{bus,
@@ -59,8 +61,8 @@ UCD90320Monitor::UCD90320Monitor(sdbusplus::bus::bus& bus, std::uint8_t i2cBus,
     pmbusInterface{
         fmt::format("/sys/bus/i2c/devices/{}-{:04x}", i2cBus, i2cAddress)
             .c_str(),
-        "ucd9000", 0}
-
+        "ucd9000", 0},
+    failureTimer{event, std::bind(&UCD90320Monitor::analyzeFailures, this)}
 {
     // Use the compatible system types information, if already available, to
     // load the configuration file
@@ -321,11 +323,42 @@ void UCD90320Monitor::parseConfigFile(const std::filesystem::path& pathName)
 }
 
 void UCD90320Monitor::onFailure(bool timeout,
-                                const std::string& powerSupplyError)
+                                const std::string& powerSupplyError,
+                                std::function<void()> analyzed)
+{
+    // Wait before reading device data without blocking the event loop. This
+    // is to allow the power supplies and other hardware time to complete
+    // failure processing.
+    failures.push_back({timeout, powerSupplyError,
+                        std::chrono::steady_clock::now(), std::move(analyzed)});
+    if (!failureTimer.isEnabled())
+    {
+        failureTimer.restartOnce(failureDelay);
+    }
+}
+
+void UCD90320Monitor::analyzeFailures()
+{
+    auto now = std::chrono::steady_clock::now();
+    while (!failures.empty() && (failures.front().time + failureDelay <= now))
+    {
+        auto failure = std::move(failures.front());
+        failures.pop_front();
+        analyzeFailure(failure);
+    }
+
+    if (!failures.empty())
+    {
+        failureTimer.restartOnce(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                failures.front().time + failureDelay - now));
+    }
+}
+
+void UCD90320Monitor::analyzeFailure(const Failure& failure)
 {
-    // Wait before reading device data. This is to allow the
-    // power supplies and other hardware time to complete failure processing.
-    std::this_thread::sleep_for(std::chrono::seconds(7));
+    bool timeout = failure.timeout;
+    const std::string& powerSupplyError = failure.powerSupplyError;
 
     std::string message;
     std::map<std::string, std::string> additionalData{};
@@ -355,6 +388,10 @@ void UCD90320Monitor::onFailure(bool timeout,
     {
         createBmcDump();
     }
+    if (failure.analyzed)
+    {
+        failure.analyzed();
+    }
 }
 
 void UCD90320Monitor::onFailureCheckPins(
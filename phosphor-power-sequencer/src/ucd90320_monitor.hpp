@@ -6,8 +6,14 @@
 #include <gpiod.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/bus/match.hpp>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
+#include <chrono>
+#include <deque>
 #include <filesystem>
+#include <functional>
 #include <vector>
 
 namespace phosphor::power::sequencer
@@ -26,6 +32,17 @@ struct Rail
     std::string presence;
 };
 
+/**
+ * A failure waiting to be analyzed
+ */
+struct Failure
+{
+    bool timeout;
+    std::string powerSupplyError;
+    std::chrono::steady_clock::time_point time;
+    std::function<void()> analyzed;
+};
+
 /**
  * @class UCD90320Monitor
  * This class implements fault analysis for the UCD90320
@@ -44,11 +61,12 @@ class UCD90320Monitor : public PowerSequencerMonitor
     /**
      * Create a device object for UCD90320 monitoring.
      * @param bus D-Bus bus object
+     * @param event event object
      * @param i2cBus The bus number of the power sequencer device
      * @param i2cAddress The I2C address of the power sequencer device
      */
-    UCD90320Monitor(sdbusplus::bus::bus& bus, std::uint8_t i2cBus,
-                    std::uint16_t i2cAddress);
+    UCD90320Monitor(sdbusplus::bus::bus& bus, const sdeventplus::Event& event,
+                    std::uint8_t i2cBus, std::uint16_t i2cAddress);
 
     /**
      * Callback function to handle interfacesAdded D-Bus signals
@@ -56,10 +74,45 @@ class UCD90320Monitor : public PowerSequencerMonitor
      */
     void interfacesAddedHandler(sdbusplus::message::message& msg);
 
-    /** @copydoc PowerSequencerMonitor::onFailure() */
-    void onFailure(bool timeout, const std::string& powerSupplyError) override;
+    /**
+     * Queues the failure to be analyzed after failureDelay, so the power
+     * supplies and other hardware have time to complete failure processing.
+     * The analyzed function is called after the analysis, so the chassis is
+     * not powered off before the device rails and GPIOs have been read.
+     * @copydoc PowerSequencerMonitor::onFailure()
+     */
+    void onFailure(bool timeout, const std::string& powerSupplyError,
+                   std::function<void()> analyzed) override;
 
   private:
+    /**
+     * Time to wait after a failure before reading device data
+     */
+    static constexpr std::chrono::seconds failureDelay{7};
+
+    /**
+     * Failures waiting to be analyzed, oldest first
+     */
+    std::deque<Failure> failures;
+
+    /**
+     * Timer to analyze the oldest failure once its delay has passed
+     */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> failureTimer;
+
+    /**
+     * Analyzes the failures whose delay has passed, and restarts the timer
+     * for the next one.
+     */
+    void analyzeFailures();
+
+    /**
+     * Analyzes the device for errors, creates a log, and then calls the
+     * analyzed function of the failure.
+     * @param failure The failure to analyze
+     */
+    void analyzeFailure(const Failure& failure);
+
     /**
      * The match to Entity Manager interfaces added.
      */
@@ -0,0 +1 @@
+../power-supply/appended.hpp
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "energy_accumulator.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace phosphor::power::psu
+{
+
+EnergyAccumulator::Reading
+    EnergyAccumulator::parse(const std::vector<uint8_t>& data)
+{
+    if (data.size() != RAW_SIZE)
+    {
+        throw std::invalid_argument{"Invalid energy accumulator block"};
+    }
+
+    Reading reading;
+    reading.accumulator = data[0] | (data[1] << 8);
+    reading.rolloverCount = data[2];
+    reading.sampleCount = data[3] | (data[4] << 8) | (data[5] << 16);
+    return reading;
+}
+
+bool EnergyAccumulator::add(const std::vector<uint8_t>& data,
+                            std::chrono::steady_clock::time_point time)
+{
+    auto reading = parse(data);
+
+    if (!last)
+    {
+        last.emplace(reading, time);
+        return false;
+    }
+
+    auto& [lastReading, lastTime] = *last;
+
+    // Both counts wrap, so take the differences modulo their ranges.
+    constexpr uint64_t totalModulus = static_cast<uint64_t>(ROLLOVER_MODULUS) *
+                                      ACCUMULATOR_MODULUS;
+    auto total = [](const Reading& r) {
+        return static_cast<uint64_t>(r.rolloverCount) * ACCUMULATOR_MODULUS +
+               (r.accumulator % ACCUMULATOR_MODULUS);
+    };
+    auto accumulated =
+        (total(reading) + totalModulus - total(lastReading)) % totalModulus;
+    auto samples =
+        (reading.sampleCount + SAMPLE_MODULUS - lastReading.sampleCount) %
+        SAMPLE_MODULUS;
+
+    if (samples == 0)
+    {
+        return false;
+    }
+
+    // The average of direct format values converts like a single value
+    auto average = static_cast<double>(accumulated) / samples;
+    averagePower = (average * std::pow(10.0, -coefficients.R) -
+                    coefficients.b) /
+                   coefficients.m;
+
+    std::chrono::duration<double> seconds = time - lastTime;
+    energy += averagePower * seconds.count();
+
+    last.emplace(reading, time);
+    return true;
+}
+
+} // namespace phosphor::power::psu
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace phosphor::power::psu
+{
+
+/**
+ * @class EnergyAccumulator
+ *
+ * Tracks the energy reported by the PMBus READ_EIN or READ_EOUT command.
+ *
+ * The command returns a 6 byte block: a 2 byte energy accumulator in the
+ * direct format of READ_PIN/READ_POUT, a 1 byte rollover count, and a 3 byte
+ * sample count, all little endian.  The device adds the power of every sample
+ * to the accumulator, which rolls over after 0x7FFF and increments the
+ * rollover count.
+ *
+ * The difference between two readings divided by the difference in their
+ * sample counts is the exact average power of the samples between them, so
+ * the power does not have to be sampled and integrated by the BMC. That
+ * average times the time between the readings is added to the energy.
+ */
+class EnergyAccumulator
+{
+  public:
+    /** @brief The size of a READ_EIN or READ_EOUT block */
+    static constexpr size_t RAW_SIZE = 6;
+
+    /** @brief The accumulator rolls over after 0x7FFF */
+    static constexpr uint32_t ACCUMULATOR_MODULUS = 0x8000;
+
+    /** @brief The rollover count is 1 byte */
+    static constexpr uint32_t ROLLOVER_MODULUS = 0x100;
+
+    /** @brief The sample count is 3 bytes */
+    static constexpr uint32_t SAMPLE_MODULUS = 0x1000000;
+
+    /**
+     * @brief The direct format coefficients of the power values,
+     *        X = (Y * 10^-R - b) / m
+     *
+     * They come from the power supply data sheet.  The defaults leave the
+     * raw values unconverted.
+     */
+    struct Coefficients
+    {
+        int m = 1;
+        int b = 0;
+        int R = 0;
+    };
+
+    /**
+     * @brief A parsed READ_EIN or READ_EOUT block
+     */
+    struct Reading
+    {
+        uint16_t accumulator;
+        uint8_t rolloverCount;
+        uint32_t sampleCount;
+    };
+
+    EnergyAccumulator() = default;
+    ~EnergyAccumulator() = default;
+    EnergyAccumulator(const EnergyAccumulator&) = default;
+    EnergyAccumulator& operator=(const EnergyAccumulator&) = default;
+    EnergyAccumulator(EnergyAccumulator&&) = default;
+    EnergyAccumulator& operator=(EnergyAccumulator&&) = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] coefficients - The direct format coefficients of the power
+     */
+    explicit EnergyAccumulator(const Coefficients& coefficients) :
+        coefficients(coefficients)
+    {}
+
+    /**
+     * @brief Parses a raw READ_EIN or READ_EOUT block.
+     *
+     * Throws std::invalid_argument if the block is not RAW_SIZE bytes.
+     *
+     * @param[in] data - The raw block
+     *
+     * @return Reading - The parsed values
+     */
+    static Reading parse(const std::vector<uint8_t>& data);
+
+    /**
+     * @brief Adds a reading.
+     *
+     * The first reading, and the first one after reset(), only sets the
+     * starting point.  A reading whose sample count did not change is
+     * ignored, so the interval continues to the next reading.
+     *
+     * Throws std::invalid_argument if the block is not RAW_SIZE bytes.
+     *
+     * @param[in] data - The raw READ_EIN or READ_EOUT block
+     * @param[in] time - When the block was read
+     *
+     * @return bool - If an interval completed, updating the energy and the
+     *                average power.
+     */
+    bool add(const std::vector<uint8_t>& data,
+             std::chrono::steady_clock::time_point time);
+
+    /**
+     * @brief Forgets the last reading, such as when the power supply is
+     *        removed.  The energy is kept.
+     */
+    void reset()
+    {
+        last.reset();
+    }
+
+    /**
+     * @brief Returns the energy of all of the intervals, in joules.
+     */
+    double getEnergy() const
+    {
+        return energy;
+    }
+
+    /**
+     * @brief Returns the average power of the last interval, in watts.
+     */
+    double getAveragePower() const
+    {
+        return averagePower;
+    }
+
+  private:
+    /** @brief The direct format coefficients of the power */
+    Coefficients coefficients;
+
+    /** @brief The last reading and when it was read */
+    std::optional<std::pair<Reading, std::chrono::steady_clock::time_point>>
+        last;
+
+    /** @brief The energy of all of the intervals, in joules */
+    double energy = 0;
+
+    /** @brief The average power of the last interval, in watts */
+    double averagePower = 0;
+};
+
+} // namespace phosphor::power::psu
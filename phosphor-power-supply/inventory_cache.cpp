@@ -0,0 +1,167 @@
+#include "inventory_cache.hpp"
+
+#include "types.hpp"
+#include "utility.hpp"
+
+#include <fmt/format.h>
+
+#include <phosphor-logging/log.hpp>
+
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+
+namespace phosphor::power::psu
+{
+
+using namespace phosphor::logging;
+
+InventoryCache& getInventoryCache()
+{
+    static InventoryCache cache;
+    return cache;
+}
+
+bool InventoryCache::update(sdbusplus::bus::bus& bus, const std::string& path,
+                            const InterfaceMap& interfaces)
+{
+    const sdbusplus::message::object_path objPath{path};
+    auto publishedObj = published.find(objPath);
+
+    for (const auto& [interface, properties] : interfaces)
+    {
+        const PropertyMap* publishedProps = nullptr;
+        if (publishedObj != published.end())
+        {
+            auto it = publishedObj->second.find(interface);
+            if (it != publishedObj->second.end())
+            {
+                publishedProps = &it->second;
+            }
+        }
+
+        if (publishedProps == nullptr)
+        {
+            // New interface, send it even if it has no properties.
+            auto& pendingProps = pending[objPath][interface];
+            for (const auto& [property, value] : properties)
+            {
+                pendingProps[property] = value;
+            }
+            continue;
+        }
+
+        for (const auto& [property, value] : properties)
+        {
+            auto it = publishedProps->find(property);
+            if ((it != publishedProps->end()) && (it->second == value))
+            {
+                // Unchanged, but a pending older value must not be sent.
+                auto pendingObj = pending.find(objPath);
+                if (pendingObj != pending.end())
+                {
+                    auto pendingIntf = pendingObj->second.find(interface);
+                    if (pendingIntf != pendingObj->second.end())
+                    {
+                        pendingIntf->second.erase(property);
+                        if (pendingIntf->second.empty())
+                        {
+                            pendingObj->second.erase(pendingIntf);
+                        }
+                    }
+                    if (pendingObj->second.empty())
+                    {
+                        pending.erase(pendingObj);
+                    }
+                }
+                continue;
+            }
+            pending[objPath][interface][property] = value;
+        }
+    }
+
+    if (pending.empty())
+    {
+        return true;
+    }
+
+    return sendPending(bus);
+}
+
+bool InventoryCache::retryPending(sdbusplus::bus::bus& bus)
+{
+    if (pending.empty())
+    {
+        return true;
+    }
+
+    log<level::DEBUG>(
+        fmt::format("Retrying inventory update of {} objects", pending.size())
+            .c_str());
+
+    return sendPending(bus);
+}
+
+void InventoryCache::invalidate()
+{
+    for (auto& [path, interfaces] : published)
+    {
+        for (auto& [interface, properties] : interfaces)
+        {
+            // insert() keeps a pending value that is already there
+            pending[path][interface].insert(
+                std::make_move_iterator(properties.begin()),
+                std::make_move_iterator(properties.end()));
+        }
+    }
+    published.clear();
+}
+
+void InventoryCache::notify(sdbusplus::bus::bus& bus, const ObjectMap& objects)
+{
+    auto service =
+        util::getService(INVENTORY_OBJ_PATH, INVENTORY_MGR_IFACE, bus);
+    if (service.empty())
+    {
+        throw std::runtime_error{"Unable to get inventory manager service"};
+    }
+
+    auto method = bus.new_method_call(service.c_str(), INVENTORY_OBJ_PATH,
+                                      INVENTORY_MGR_IFACE, "Notify");
+    method.append(objects);
+    bus.call(method);
+}
+
+bool InventoryCache::sendPending(sdbusplus::bus::bus& bus)
+{
+    try
+    {
+        notify(bus, pending);
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>(
+            fmt::format("Error in inventory manager call to update "
+                        "inventory: {}",
+                        e.what())
+                .c_str());
+        return false;
+    }
+
+    for (auto& [path, interfaces] : pending)
+    {
+        for (auto& [interface, properties] : interfaces)
+        {
+            auto& publishedProps = published[path][interface];
+            for (auto& [property, value] : properties)
+            {
+                publishedProps[property] = std::move(value);
+            }
+        }
+    }
+    pending.clear();
+
+    return true;
+}
+
+} // namespace phosphor::power::psu
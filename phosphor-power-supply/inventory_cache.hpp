@@ -0,0 +1,131 @@
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace phosphor::power::psu
+{
+
+/**
+ * @class InventoryCache
+ *
+ * Keeps a local copy of the properties this application has sent to the
+ * inventory manager.
+ *
+ * Only the properties that differ from the local copy are sent in the Notify
+ * method call.  If the call fails, the changed properties are kept as pending
+ * and are sent again, together with any other pending properties, in a single
+ * Notify method call by the next update or by retryPending().
+ *
+ * If the inventory manager restarts, invalidate() must be called so that all
+ * properties are sent to it again.
+ */
+class InventoryCache
+{
+  public:
+    using Value = std::variant<bool, std::string, std::vector<uint8_t>>;
+    using PropertyMap = std::map<std::string, Value>;
+    using InterfaceMap = std::map<std::string, PropertyMap>;
+    using ObjectMap = std::map<sdbusplus::message::object_path, InterfaceMap>;
+
+    InventoryCache() = default;
+    virtual ~InventoryCache() = default;
+    InventoryCache(const InventoryCache&) = delete;
+    InventoryCache& operator=(const InventoryCache&) = delete;
+    InventoryCache(InventoryCache&&) = delete;
+    InventoryCache& operator=(InventoryCache&&) = delete;
+
+    /**
+     * Sends the changed properties of an inventory object to the inventory
+     * manager.
+     *
+     * An interface that has not been sent before is always included, even if
+     * it has no properties, so that it is added to the object.
+     *
+     * Failures are logged and the properties are retried later; no exception
+     * is thrown.
+     *
+     * @param[in] bus - D-Bus object
+     * @param[in] path - Object path passed to the Notify method
+     * @param[in] interfaces - Interfaces and properties of the object
+     *
+     * @return true if the inventory manager has the given values
+     */
+    bool update(sdbusplus::bus::bus& bus, const std::string& path,
+                const InterfaceMap& interfaces);
+
+    /**
+     * Sends all pending properties to the inventory manager in a single
+     * Notify method call.
+     *
+     * Does nothing if there are no pending properties.
+     *
+     * @param[in] bus - D-Bus object
+     *
+     * @return true if no properties are pending after the call
+     */
+    bool retryPending(sdbusplus::bus::bus& bus);
+
+    /**
+     * Returns whether any properties are waiting to be sent.
+     */
+    bool hasPending() const
+    {
+        return !pending.empty();
+    }
+
+    /**
+     * Forgets what the inventory manager is known to have, e.g. because it
+     * restarted, and makes all properties pending so that they are sent again
+     * by the next update or by retryPending().
+     *
+     * A pending value takes precedence over the local copy.
+     */
+    void invalidate();
+
+  protected:
+    /**
+     * Calls the Notify method of the inventory manager.
+     *
+     * Throws an exception if the call fails.
+     *
+     * @param[in] bus - D-Bus object
+     * @param[in] objects - Objects, interfaces and properties to send
+     */
+    virtual void notify(sdbusplus::bus::bus& bus, const ObjectMap& objects);
+
+  private:
+    /**
+     * Sends the pending properties and moves them to the local copy of the
+     * inventory on success.
+     *
+     * @param[in] bus - D-Bus object
+     *
+     * @return true if the Notify method call succeeded
+     */
+    bool sendPending(sdbusplus::bus::bus& bus);
+
+    /**
+     * Properties that the inventory manager is known to have.
+     */
+    ObjectMap published;
+
+    /**
+     * Changed properties that still need to be sent.
+     */
+    ObjectMap pending;
+};
+
+/**
+ * Returns the InventoryCache shared by all inventory updates of this
+ * application.
+ */
+InventoryCache& getInventoryCache();
+
+} // namespace phosphor::power::psu
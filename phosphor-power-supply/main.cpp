@@ -20,11 +20,13 @@
 #include <sdbusplus/bus.hpp>
 #include <sdeventplus/event.hpp>
 
+#include <chrono>
 #include <filesystem>
+#include <string>
 
 using namespace phosphor::power;
 
-int main(void)
+int main(int argc, char** argv)
 {
     try
     {
@@ -32,6 +34,25 @@ int main(void)
 
         CLI::App app{"OpenBMC Power Supply Unit Monitor"};
 
+        auto fastPollInterval = manager::defaultFastPollInterval.count();
+        auto slowPollInterval = manager::defaultSlowPollInterval.count();
+        app.add_option("--fast-poll-interval", fastPollInterval,
+                       "Milliseconds between power supply checks while a "
+                       "fault or transition is occurring")
+            ->check(CLI::PositiveNumber);
+        app.add_option("--slow-poll-interval", slowPollInterval,
+                       "Milliseconds between power supply checks otherwise")
+            ->check(CLI::PositiveNumber);
+        std::string telemetrySocket;
+        app.add_option("--telemetry-socket", telemetrySocket,
+                       "Unix domain socket to stream power supply telemetry "
+                       "on every check");
+        uint32_t historyRefreshInterval = 0;
+        app.add_option("--history-refresh-interval", historyRefreshInterval,
+                       "Minimum seconds between updates of the input history "
+                       "properties, 0 to update them with every record");
+        CLI11_PARSE(app, argc, argv);
+
         auto bus = sdbusplus::bus::new_default();
         auto event = sdeventplus::Event::get_default();
 
@@ -39,7 +60,17 @@ int main(void)
         // handle both sd_events (for the timers) and dbus signals.
         bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
 
-        manager::PSUManager manager(bus, event);
+        manager::PSUManager manager(
+            bus, event, std::chrono::milliseconds(fastPollInterval),
+            std::chrono::milliseconds(slowPollInterval));
+
+        if (!telemetrySocket.empty())
+        {
+            manager.enableTelemetry(telemetrySocket);
+        }
+
+        manager.setHistoryRefreshInterval(
+            std::chrono::seconds(historyRefreshInterval));
 
         return manager.run();
     }
@@ -6,36 +6,199 @@
 #include "util.hpp"
 
 #include <fmt/format.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
 
 #include <xyz/openbmc_project/Common/Device/error.hpp>
 
+#include <algorithm>
+#include <array>
 #include <chrono> // sleep_for()
 #include <cmath>
 #include <cstdint> // uint8_t...
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
+#include <limits>
+#include <string_view>
 #include <thread> // sleep_for()
+#include <tuple>
 
 namespace phosphor::power::psu
 {
-// Amount of time in milliseconds to delay between power supply going from
-// missing to present before running the bind command(s).
-constexpr auto bindDelay = 1000;
-
 // The number of INPUT_HISTORY records to keep on D-Bus.
 // Each record covers a 30-second span. That means two records are needed to
 // cover a minute of time. If we want one (1) hour of data, that would be 120
 // records.
 constexpr auto INPUT_HISTORY_MAX_RECORDS = 120;
 
+// The lower resolution INPUT_HISTORY rollup tiers.  Each tier is built from
+// the records of the tier before it, starting with the 30-second records:
+// name, number of records of the previous tier, number of records to keep.
+// That keeps one (1) day of 5-minute, one (1) week of 1-hour, and 90 days of
+// 1-day records.
+const std::array<std::tuple<const char*, size_t, size_t>, 3>
+    INPUT_HISTORY_TIERS{{{"per_5m", 10, 288},
+                         {"per_1h", 12, 168},
+                         {"per_1d", 24, 90}}};
+
+// The energy accumulators: the file name of the block and the name of the
+// sensors, such as ps0_input_energy and ps0_input_power_average.
+const std::array<std::pair<const char*, const char*>, 2> ENERGY_ACCUMULATORS{
+    {{phosphor::pmbus::READ_EIN, "input"},
+     {phosphor::pmbus::READ_EOUT, "output"}}};
+
+constexpr auto ENERGY_SENSOR_ROOT = "/xyz/openbmc_project/sensors/energy";
+constexpr auto POWER_SENSOR_ROOT = "/xyz/openbmc_project/sensors/power";
+
+namespace status_word = phosphor::pmbus::status_word;
+
+// The faults every power supply reports in STATUS_WORD.
+constexpr std::array<StatusFaultDescriptor, 10> commonStatusFaults{{
+    {.fault = StatusFault::cml,
+     .wordMask = status_word::CML_FAULT,
+     .severity = FaultSeverity::communication,
+     .deglitchLimit = DEGLITCH_LIMIT,
+     .text = "CML fault",
+     .traceReg = StatusRegister::cml},
+    {.fault = StatusFault::input,
+     .wordMask = status_word::INPUT_FAULT_WARN,
+     .deglitchLimit = DEGLITCH_LIMIT,
+     .text = "INPUT fault",
+     .traceReg = StatusRegister::input,
+     .traceClear = true},
+    {.fault = StatusFault::voutOV,
+     .wordMask = status_word::VOUT_OV_FAULT,
+     .deglitchLimit = DEGLITCH_LIMIT,
+     .text = "VOUT_OV_FAULT fault",
+     .traceReg = StatusRegister::vout},
+    {.fault = StatusFault::ioutOC,
+     .wordMask = status_word::IOUT_OC_FAULT,
+     .deglitchLimit = DEGLITCH_LIMIT,
+     .text = "IOUT fault",
+     .traceReg = StatusRegister::iout},
+    // VOUT on without VOUT_OV_FAULT is an output under-voltage fault
+    {.fault = StatusFault::voutUV,
+     .wordMask = status_word::VOUT_FAULT,
+     .excludeWordMask = status_word::VOUT_OV_FAULT,
+     .deglitchLimit = DEGLITCH_LIMIT,
+     .text = "VOUT_UV_FAULT fault",
+     .traceReg = StatusRegister::vout},
+    {.fault = StatusFault::fan,
+     .wordMask = status_word::FAN_FAULT,
+     .deglitchLimit = DEGLITCH_LIMIT,
+     .text = "FANS fault/warning",
+     .traceReg = StatusRegister::fans12},
+    {.fault = StatusFault::temperature,
+     .wordMask = status_word::TEMPERATURE_FAULT_WARN,
+     .deglitchLimit = DEGLITCH_LIMIT,
+     .text = "TEMPERATURE fault/warning",
+     .traceReg = StatusRegister::temperature},
+    {.fault = StatusFault::pgood,
+     .wordMask = status_word::POWER_GOOD_NEGATED | status_word::UNIT_IS_OFF,
+     .deglitchLimit = PGOOD_DEGLITCH_LIMIT,
+     .text = "PGOOD fault"},
+    {.fault = StatusFault::mfr,
+     .wordMask = status_word::MFR_SPECIFIC_FAULT,
+     .deglitchLimit = DEGLITCH_LIMIT,
+     .text = "MFR fault"},
+    {.fault = StatusFault::vinUV,
+     .wordMask = status_word::VIN_UV_FAULT,
+     .deglitchLimit = DEGLITCH_LIMIT,
+     .text = "VIN_UV fault",
+     .traceReg = StatusRegister::input,
+     .traceClear = true},
+}};
+
+// The IBM power supply STATUS_MFR_SPECIFIC bits.  They are only examined when
+// the MFRSPECIFIC bit is on in STATUS_WORD.
+constexpr std::array<StatusFaultDescriptor, 3> ibmCFFPSStatusFaults{{
+    // MFR_SPECIFIC[4] is PS_Kill fault
+    {.fault = StatusFault::psKill,
+     .requiredWordMask = status_word::MFR_SPECIFIC_FAULT,
+     .reg = StatusRegister::mfr,
+     .regMask = 0x10,
+     .severity = FaultSeverity::detail,
+     .deglitchLimit = DEGLITCH_LIMIT},
+    // MFR_SPECIFIC[6] is 12Vcs fault
+    {.fault = StatusFault::ps12Vcs,
+     .requiredWordMask = status_word::MFR_SPECIFIC_FAULT,
+     .reg = StatusRegister::mfr,
+     .regMask = 0x40,
+     .severity = FaultSeverity::detail,
+     .deglitchLimit = DEGLITCH_LIMIT},
+    // MFR_SPECIFIC[7] is 12V Current-Share fault
+    {.fault = StatusFault::psCS12V,
+     .requiredWordMask = status_word::MFR_SPECIFIC_FAULT,
+     .reg = StatusRegister::mfr,
+     .regMask = 0x80,
+     .severity = FaultSeverity::detail,
+     .deglitchLimit = DEGLITCH_LIMIT},
+}};
+
+// The hwmon alarm attributes that can be monitored for events, and the faults
+// they latch.
+constexpr std::array<std::pair<const char*, StatusFault>, 2> ALARM_ATTRIBUTES{
+    {{"in1_lcrit_alarm", StatusFault::vinUV},
+     {"power1_alarm", StatusFault::input}}};
+
+// The faults that make isFaulted() true
+constexpr StatusFaults faultedStatusFaults =
+    faultsWithSeverity(commonStatusFaults, FaultSeverity::fault);
+
+/**
+ * @brief Reads a sysfs alarm attribute from the start, which also rearms
+ * poll() on it.
+ *
+ * @param[in] fd - The open attribute
+ *
+ * @return The alarm value, or -1 if the read failed
+ */
+int readAlarm(int fd)
+{
+    char data[8]{};
+    if (pread(fd, data, sizeof(data) - 1, 0) <= 0)
+    {
+        return -1;
+    }
+    return std::atoi(data);
+}
+
+/**
+ * @brief Returns the trace text of a fault.
+ *
+ * @param[in] shortName - The power supply short name
+ * @param[in] desc - The fault descriptor
+ * @param[in] regs - The status register values
+ * @param[in] cleared - Whether the fault went away
+ */
+std::string faultTrace(const std::string& shortName,
+                       const StatusFaultDescriptor& desc,
+                       const StatusRegisters& regs, bool cleared)
+{
+    auto text = fmt::format(
+        "{} {}{}: STATUS_WORD = {:#06x}, STATUS_MFR_SPECIFIC = {:#04x}",
+        shortName, desc.text, (cleared ? " cleared" : ""), regs.word, regs.mfr);
+    if (desc.traceReg != StatusRegister::none)
+    {
+        text += fmt::format(", {} = {:#04x}", registerName(desc.traceReg),
+                            regs.get(desc.traceReg));
+    }
+    return text;
+}
+
 using namespace phosphor::logging;
 using namespace sdbusplus::xyz::openbmc_project::Common::Device::Error;
 
 PowerSupply::PowerSupply(sdbusplus::bus::bus& bus, const std::string& invpath,
                          std::uint8_t i2cbus, std::uint16_t i2caddr,
                          const std::string& driver,
-                         const std::string& gpioLineName) :
+                         const std::string& gpioLineName,
+                         const std::string& historyDir) :
     bus(bus),
-    inventoryPath(invpath), bindPath("/sys/bus/i2c/drivers/" + driver)
+    inventoryPath(invpath), bindPath("/sys/bus/i2c/drivers/" + driver),
+    historyDir(historyDir)
 {
     if (inventoryPath.empty())
     {
@@ -49,6 +212,11 @@ PowerSupply::PowerSupply(sdbusplus::bus::bus& bus, const std::string& invpath,
 
     shortName = findShortName(inventoryPath);
 
+    if (bindPath.string().find("ibm-cffps") != std::string::npos)
+    {
+        modelFaults = ibmCFFPSStatusFaults;
+    }
+
     log<level::DEBUG>(
         fmt::format("{} gpioLineName: {}", shortName, gpioLineName).c_str());
     presenceGPIO = createGPIO(gpioLineName);
@@ -56,6 +224,7 @@ PowerSupply::PowerSupply(sdbusplus::bus::bus& bus, const std::string& invpath,
     std::ostringstream ss;
     ss << std::hex << std::setw(4) << std::setfill('0') << i2caddr;
     std::string addrStr = ss.str();
+    i2cBus = i2cbus;
     std::string busStr = std::to_string(i2cbus);
     bindDevice = busStr;
     bindDevice.append("-");
@@ -92,6 +261,7 @@ PowerSupply::PowerSupply(sdbusplus::bus::bus& bus, const std::string& invpath,
         updatePresence();
         updateInventory();
         setupInputHistory();
+        setupEnergy();
     }
 }
 
@@ -102,7 +272,7 @@ void PowerSupply::bindOrUnbindDriver(bool present)
 
     if (present)
     {
-        std::this_thread::sleep_for(std::chrono::milliseconds(bindDelay));
+        std::this_thread::sleep_for(bindDelay);
         log<level::INFO>(
             fmt::format("Binding device driver. path: {} device: {}",
                         path.string(), bindDevice)
@@ -141,7 +311,7 @@ void PowerSupply::updatePresence()
 {
     try
     {
-        present = getPresence(bus, inventoryPath);
+        setPresent(getPresence(bus, inventoryPath));
     }
     catch (const sdbusplus::exception::exception& e)
     {
@@ -160,14 +330,7 @@ void PowerSupply::updatePresenceGPIO()
 
     try
     {
-        if (presenceGPIO->read() > 0)
-        {
-            present = true;
-        }
-        else
-        {
-            present = false;
-        }
+        setPresent(presenceGPIO->read() > 0);
     }
     catch (const std::exception& e)
     {
@@ -193,8 +356,18 @@ void PowerSupply::updatePresenceGPIO()
             pmbusIntf->findHwmonDir();
         }
 
+        if (present && !alarms.empty())
+        {
+            openAlarms();
+        }
+        else if (!present)
+        {
+            closeAlarms();
+        }
+
         setPresence(bus, invpath, present, shortName);
         setupInputHistory();
+        setupEnergy();
         updateInventory();
 
         // Need Functional to already be correct before calling this.
@@ -212,460 +385,519 @@ void PowerSupply::updatePresenceGPIO()
     }
 }
 
-void PowerSupply::analyzeCMLFault()
+bool PowerSupply::isDeglitchUpdateDue(
+    bool isNewFault, std::chrono::steady_clock::time_point& lastUpdate)
 {
-    if (statusWord & phosphor::pmbus::status_word::CML_FAULT)
-    {
-        if (cmlFault < DEGLITCH_LIMIT)
-        {
-            if (statusWord != statusWordOld)
-            {
-                log<level::ERR>(
-                    fmt::format("{} CML fault: STATUS_WORD = {:#06x}, "
-                                "STATUS_CML = {:#02x}",
-                                shortName, statusWord, statusCML)
-                        .c_str());
-            }
-            cmlFault++;
-        }
-    }
-    else
+    auto now = std::chrono::steady_clock::now();
+    if (isNewFault || ((now - lastUpdate) >= deglitchInterval))
     {
-        cmlFault = 0;
+        lastUpdate = now;
+        return true;
     }
+    return false;
 }
 
-void PowerSupply::analyzeInputFault()
+void PowerSupply::monitorPresenceEvents(const sdeventplus::Event& event)
 {
-    if (statusWord & phosphor::pmbus::status_word::INPUT_FAULT_WARN)
+    if (!presenceGPIO || presenceEventSource)
     {
-        if (inputFault < DEGLITCH_LIMIT)
-        {
-            if (statusWord != statusWordOld)
-            {
-                log<level::ERR>(
-                    fmt::format("{} INPUT fault: STATUS_WORD = {:#06x}, "
-                                "STATUS_MFR_SPECIFIC = {:#04x}, "
-                                "STATUS_INPUT = {:#04x}",
-                                shortName, statusWord, statusMFR, statusInput)
-                        .c_str());
-            }
-            inputFault++;
-        }
+        return;
     }
 
-    // If had INPUT/VIN_UV fault, and now off.
-    // Trace that odd behavior.
-    if (inputFault &&
-        !(statusWord & phosphor::pmbus::status_word::INPUT_FAULT_WARN))
+    try
+    {
+        int fd = presenceGPIO->requestEvents();
+        presenceEventSource = std::make_unique<sdeventplus::source::IO>(
+            event, fd, EPOLLIN,
+            [this](sdeventplus::source::IO&, int, uint32_t) {
+                this->presenceEventReceived();
+            });
+    }
+    catch (const std::exception& e)
     {
         log<level::INFO>(
-            fmt::format("{} INPUT fault cleared: STATUS_WORD = {:#06x}, "
-                        "STATUS_MFR_SPECIFIC = {:#04x}, "
-                        "STATUS_INPUT = {:#04x}",
-                        shortName, statusWord, statusMFR, statusInput)
+            fmt::format("{} presence GPIO events not available, polling "
+                        "instead: {}",
+                        shortName, e.what())
                 .c_str());
-        inputFault = 0;
+        presenceEventSource = nullptr;
+        return;
     }
-}
 
-void PowerSupply::analyzeVoutOVFault()
-{
-    if (statusWord & phosphor::pmbus::status_word::VOUT_OV_FAULT)
+    // The presence may have changed before the events were requested.
+    try
     {
-        if (voutOVFault < DEGLITCH_LIMIT)
-        {
-            if (statusWord != statusWordOld)
-            {
-                log<level::ERR>(
-                    fmt::format(
-                        "{} VOUT_OV_FAULT fault: STATUS_WORD = {:#06x}, "
-                        "STATUS_MFR_SPECIFIC = {:#04x}, "
-                        "STATUS_VOUT = {:#02x}",
-                        shortName, statusWord, statusMFR, statusVout)
-                        .c_str());
-            }
-
-            voutOVFault++;
-        }
+        updatePresenceGPIO();
     }
-    else
+    catch (...)
     {
-        voutOVFault = 0;
+        // Error already logged.  The next event will retry.
     }
 }
 
-void PowerSupply::analyzeIoutOCFault()
+void PowerSupply::monitorAlarmEvents(const sdeventplus::Event& event,
+                                     std::function<void(PowerSupply&)> callback)
 {
-    if (statusWord & phosphor::pmbus::status_word::IOUT_OC_FAULT)
+    if (!alarms.empty())
     {
-        if (ioutOCFault < DEGLITCH_LIMIT)
-        {
-            if (statusWord != statusWordOld)
-            {
-                log<level::ERR>(
-                    fmt::format("{} IOUT fault: STATUS_WORD = {:#06x}, "
-                                "STATUS_MFR_SPECIFIC = {:#04x}, "
-                                "STATUS_IOUT = {:#04x}",
-                                shortName, statusWord, statusMFR, statusIout)
-                        .c_str());
-            }
+        return;
+    }
 
-            ioutOCFault++;
-        }
+    alarmEvent = event;
+    alarmCallback = std::move(callback);
+    alarms.reserve(ALARM_ATTRIBUTES.size());
+    for (const auto& [name, fault] : ALARM_ATTRIBUTES)
+    {
+        alarms.push_back({name, fault, {}, nullptr});
     }
-    else
+
+    if (present)
     {
-        ioutOCFault = 0;
+        openAlarms();
     }
 }
 
-void PowerSupply::analyzeVoutUVFault()
+void PowerSupply::openAlarms()
 {
-    if ((statusWord & phosphor::pmbus::status_word::VOUT_FAULT) &&
-        !(statusWord & phosphor::pmbus::status_word::VOUT_OV_FAULT))
+    auto hwmonPath = pmbusIntf->getPath(phosphor::pmbus::Type::Hwmon);
+
+    for (size_t i = 0; i < alarms.size(); i++)
     {
-        if (voutUVFault < DEGLITCH_LIMIT)
+        auto& alarm = alarms[i];
+        auto path = hwmonPath / alarm.name;
+        phosphor::power::util::FileDescriptor fd{
+            open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (!fd)
         {
-            if (statusWord != statusWordOld)
+            log<level::DEBUG>(fmt::format("{} {} not available for events",
+                                          shortName, path.string())
+                                  .c_str());
+            if (alarm.source)
             {
-                log<level::ERR>(
-                    fmt::format(
-                        "{} VOUT_UV_FAULT fault: STATUS_WORD = {:#06x}, "
-                        "STATUS_MFR_SPECIFIC = {:#04x}, "
-                        "STATUS_VOUT = {:#04x}",
-                        shortName, statusWord, statusMFR, statusVout)
-                        .c_str());
+                alarm.source->set_enabled(sdeventplus::source::Enabled::Off);
             }
-            voutUVFault++;
+            alarm.fd.close();
+            continue;
+        }
+
+        // POLLPRI is only reported for changes after the attribute was read.
+        readAlarm(fd());
+
+        try
+        {
+            if (alarm.source)
+            {
+                alarm.source->set_fd(fd());
+                alarm.source->set_enabled(sdeventplus::source::Enabled::On);
+            }
+            else
+            {
+                alarm.source = std::make_unique<sdeventplus::source::IO>(
+                    *alarmEvent, fd(), EPOLLPRI,
+                    [this, i](sdeventplus::source::IO&, int, uint32_t) {
+                        this->alarmEventReceived(alarms[i]);
+                    });
+            }
+            alarm.fd = std::move(fd);
+        }
+        catch (const std::exception& e)
+        {
+            log<level::INFO>(
+                fmt::format("{} {} events not available: {}", shortName,
+                            path.string(), e.what())
+                    .c_str());
         }
-    }
-    else
-    {
-        voutUVFault = 0;
     }
 }
 
-void PowerSupply::analyzeFanFault()
+void PowerSupply::closeAlarms()
 {
-    if (statusWord & phosphor::pmbus::status_word::FAN_FAULT)
+    for (auto& alarm : alarms)
     {
-        if (fanFault < DEGLITCH_LIMIT)
+        // The attributes go away when the device driver is unbound.
+        if (alarm.source)
         {
-            if (statusWord != statusWordOld)
-            {
-                log<level::ERR>(fmt::format("{} FANS fault/warning: "
-                                            "STATUS_WORD = {:#06x}, "
-                                            "STATUS_MFR_SPECIFIC = {:#04x}, "
-                                            "STATUS_FANS_1_2 = {:#04x}",
-                                            shortName, statusWord, statusMFR,
-                                            statusFans12)
-                                    .c_str());
-            }
-            fanFault++;
+            alarm.source->set_enabled(sdeventplus::source::Enabled::Off);
         }
+        alarm.fd.close();
     }
-    else
+}
+
+void PowerSupply::alarmEventReceived(AlarmMonitor& alarm)
+{
+    auto value = readAlarm(alarm.fd());
+    if (value < 0)
     {
-        fanFault = 0;
+        log<level::INFO>(
+            fmt::format("{} {} read failed, no longer monitoring events",
+                        shortName, alarm.name)
+                .c_str());
+        alarm.source->set_enabled(sdeventplus::source::Enabled::Off);
+        return;
     }
+
+    log<level::DEBUG>(
+        fmt::format("{} {} = {}", shortName, alarm.name, value).c_str());
+
+    alarmChanged(alarm.fault, value > 0);
 }
 
-void PowerSupply::analyzeTemperatureFault()
+void PowerSupply::alarmChanged(StatusFault fault, bool on)
 {
-    if (statusWord & phosphor::pmbus::status_word::TEMPERATURE_FAULT_WARN)
+    if (on)
     {
-        if (tempFault < DEGLITCH_LIMIT)
-        {
-            if (statusWord != statusWordOld)
-            {
-                log<level::ERR>(fmt::format("{} TEMPERATURE fault/warning: "
-                                            "STATUS_WORD = {:#06x}, "
-                                            "STATUS_MFR_SPECIFIC = {:#04x}, "
-                                            "STATUS_TEMPERATURE = {:#04x}",
-                                            shortName, statusWord, statusMFR,
-                                            statusTemperature)
-                                    .c_str());
-            }
-            tempFault++;
-        }
+        alarmFaults |= faultBit(fault);
     }
-    else
+    alarmAnalysisDue = true;
+
+    if (alarmCallback)
     {
-        tempFault = 0;
+        alarmCallback(*this);
     }
 }
 
-void PowerSupply::analyzePgoodFault()
+void PowerSupply::presenceEventReceived()
 {
-    if ((statusWord & phosphor::pmbus::status_word::POWER_GOOD_NEGATED) ||
-        (statusWord & phosphor::pmbus::status_word::UNIT_IS_OFF))
+    try
     {
-        if (pgoodFault < PGOOD_DEGLITCH_LIMIT)
-        {
-            if (statusWord != statusWordOld)
-            {
-                log<level::ERR>(fmt::format("{} PGOOD fault: "
-                                            "STATUS_WORD = {:#06x}, "
-                                            "STATUS_MFR_SPECIFIC = {:#04x}",
-                                            shortName, statusWord, statusMFR)
-                                    .c_str());
-            }
-            pgoodFault++;
-        }
+        presenceGPIO->readEvents();
+        updatePresenceGPIO();
     }
-    else
+    catch (const std::exception& e)
     {
-        pgoodFault = 0;
+        log<level::ERR>(
+            fmt::format("{} presence GPIO event failure: {}", shortName,
+                        e.what())
+                .c_str());
     }
 }
 
-void PowerSupply::determineMFRFault()
+bool PowerSupply::isFaulted() const
 {
-    if (bindPath.string().find("ibm-cffps") != std::string::npos)
+    return (hasCommFault() || ((presentFaults & faultedStatusFaults) != 0));
+}
+
+void PowerSupply::analyzeFaults()
+{
+    const StatusRegisters regs{.word = statusWord,
+                               .input = statusInput,
+                               .mfr = statusMFR,
+                               .cml = statusCML,
+                               .vout = statusVout,
+                               .iout = statusIout,
+                               .fans12 = statusFans12,
+                               .temperature = statusTemperature};
+
+    DecodedStatus decoded;
+    decodeStatus(commonStatusFaults, regs, decoded);
+    decodeStatus(modelFaults, regs, decoded);
+
+    // The faults that came on or went off since the last analysis
+    StatusFaults changed = (decoded.active ^ activeFaults) & ~decoded.held;
+
+    for (auto table : {std::span<const StatusFaultDescriptor>{
+                           commonStatusFaults},
+                       modelFaults})
     {
-        // IBM MFR_SPECIFIC[4] is PS_Kill fault
-        if (statusMFR & 0x10)
+        for (const auto& desc : table)
         {
-            if (psKillFault < DEGLITCH_LIMIT)
-            {
-                psKillFault++;
-            }
-        }
-        else
-        {
-            psKillFault = 0;
-        }
-        // IBM MFR_SPECIFIC[6] is 12Vcs fault.
-        if (statusMFR & 0x40)
-        {
-            if (ps12VcsFault < DEGLITCH_LIMIT)
+            auto bit = faultBit(desc.fault);
+            auto& count = faultCounts[static_cast<size_t>(desc.fault)];
+
+            if (decoded.active & bit)
             {
-                ps12VcsFault++;
+                if ((changed & bit) && (desc.text != nullptr))
+                {
+                    log<level::ERR>(
+                        faultTrace(shortName, desc, regs, false).c_str());
+                }
+                if (alarmFaults & bit)
+                {
+                    // Latched by the device driver, so already deglitched
+                    count = desc.deglitchLimit;
+                }
+                else if (count < desc.deglitchLimit)
+                {
+                    count++;
+                }
+                if (count >= desc.deglitchLimit)
+                {
+                    presentFaults |= bit;
+                }
             }
-        }
-        else
-        {
-            ps12VcsFault = 0;
-        }
-        // IBM MFR_SPECIFIC[7] is 12V Current-Share fault.
-        if (statusMFR & 0x80)
-        {
-            if (psCS12VFault < DEGLITCH_LIMIT)
+            else if (!(decoded.held & bit))
             {
-                psCS12VFault++;
+                // If had INPUT/VIN_UV fault, and now off.
+                // Trace that odd behavior.
+                if (count && desc.traceClear)
+                {
+                    log<level::INFO>(
+                        faultTrace(shortName, desc, regs, true).c_str());
+                }
+                count = 0;
+                presentFaults &= ~bit;
             }
         }
-        else
-        {
-            psCS12VFault = 0;
-        }
     }
+
+    activeFaults = decoded.active | (activeFaults & decoded.held);
 }
 
-void PowerSupply::analyzeMFRFault()
+void PowerSupply::analyze()
 {
-    if (statusWord & phosphor::pmbus::status_word::MFR_SPECIFIC_FAULT)
-    {
-        if (mfrFault < DEGLITCH_LIMIT)
-        {
-            if (statusWord != statusWordOld)
-            {
-                log<level::ERR>(fmt::format("{} MFR fault: "
-                                            "STATUS_WORD = {:#06x} "
-                                            "STATUS_MFR_SPECIFIC = {:#04x}",
-                                            shortName, statusWord, statusMFR)
-                                    .c_str());
-            }
-            mfrFault++;
-        }
+    pollPresence();
+    readStatus();
+    analyzeStatus();
+}
 
-        determineMFRFault();
-    }
-    else
+void PowerSupply::pollPresence()
+{
+    // Presence is updated by the GPIO event callback when monitoring events.
+    if (presenceGPIO && !presenceEventSource)
     {
-        mfrFault = 0;
+        updatePresenceGPIO();
     }
 }
 
-void PowerSupply::analyzeVinUVFault()
+void PowerSupply::readStatus()
 {
-    if (statusWord & phosphor::pmbus::status_word::VIN_UV_FAULT)
+    using namespace phosphor::pmbus;
+
+    statusRead = false;
+    statusWordRead = false;
+    statusReadFailed = false;
+    historyRead = false;
+    historyReadFailed = false;
+    for (auto& meter : energyMeters)
     {
-        if (vinUVFault < DEGLITCH_LIMIT)
-        {
-            if (statusWord != statusWordOld)
-            {
-                log<level::ERR>(
-                    fmt::format("{} VIN_UV fault: STATUS_WORD = {:#06x}, "
-                                "STATUS_MFR_SPECIFIC = {:#04x}, "
-                                "STATUS_INPUT = {:#04x}",
-                                shortName, statusWord, statusMFR, statusInput)
-                        .c_str());
-            }
-            vinUVFault++;
-        }
+        meter.data.clear();
     }
 
-    if (vinUVFault &&
-        !(statusWord & phosphor::pmbus::status_word::VIN_UV_FAULT))
+    if (!present)
     {
-        log<level::INFO>(
-            fmt::format("{} VIN_UV fault cleared: STATUS_WORD = {:#06x}, "
-                        "STATUS_MFR_SPECIFIC = {:#04x}, "
-                        "STATUS_INPUT = {:#04x}",
-                        shortName, statusWord, statusMFR, statusInput)
-                .c_str());
-        vinUVFault = 0;
+        return;
     }
-}
+    statusRead = true;
 
-void PowerSupply::analyze()
-{
-    using namespace phosphor::pmbus;
+    try
+    {
+        statusWordOld = statusWord;
+        statusWord = pmbusIntf->read(STATUS_WORD, Type::Debug,
+                                     (readFail < LOG_LIMIT));
+        statusWordRead = true;
+
+        if (statusWord)
+        {
+            statusInput = pmbusIntf->read(STATUS_INPUT, Type::Debug);
+            statusMFR = pmbusIntf->read(STATUS_MFR, Type::Debug);
+            statusCML = pmbusIntf->read(STATUS_CML, Type::Debug);
+            auto status0Vout = pmbusIntf->insertPageNum(STATUS_VOUT, 0);
+            statusVout = pmbusIntf->read(status0Vout, Type::Debug);
+            statusIout = pmbusIntf->read(STATUS_IOUT, Type::Debug);
+            statusFans12 = pmbusIntf->read(STATUS_FANS_1_2, Type::Debug);
+            statusTemperature =
+                pmbusIntf->read(STATUS_TEMPERATURE, Type::Debug);
+        }
 
-    if (presenceGPIO)
+        // Note: getInputVoltage() has its own try/catch.
+        getInputVoltage(readActualInputVoltage, readInputVoltage);
+    }
+    catch (const ReadFailure& e)
     {
-        updatePresenceGPIO();
+        statusReadFailed = true;
+        return;
     }
 
-    if (present)
+    // The history and energy blocks are not needed at the fast poll rate
+    auto now = std::chrono::steady_clock::now();
+    if (lastTelemetryRead && (now - *lastTelemetryRead < telemetryReadInterval))
+    {
+        return;
+    }
+    lastTelemetryRead = now;
+
+    if (inputHistorySupported && recordManager)
     {
         try
         {
-            statusWordOld = statusWord;
-            statusWord = pmbusIntf->read(STATUS_WORD, Type::Debug,
-                                         (readFail < LOG_LIMIT));
-            // Read worked, reset the fail count.
-            readFail = 0;
+            // Read just the most recent average/max record
+            historyData = pmbusIntf->readBinary(
+                INPUT_HISTORY, Type::HwmonDeviceDebug,
+                history::RecordManager::RAW_RECORD_SIZE);
+            historyRead = true;
+        }
+        catch (const ReadFailure& e)
+        {
+            historyReadFailed = true;
+        }
+    }
 
-            if (statusWord)
+    if (!energyMeters.empty())
+    {
+        energyReadTime = now;
+        for (auto& meter : energyMeters)
+        {
+            try
             {
-                statusInput = pmbusIntf->read(STATUS_INPUT, Type::Debug);
-                statusMFR = pmbusIntf->read(STATUS_MFR, Type::Debug);
-                statusCML = pmbusIntf->read(STATUS_CML, Type::Debug);
-                auto status0Vout = pmbusIntf->insertPageNum(STATUS_VOUT, 0);
-                statusVout = pmbusIntf->read(status0Vout, Type::Debug);
-                statusIout = pmbusIntf->read(STATUS_IOUT, Type::Debug);
-                statusFans12 = pmbusIntf->read(STATUS_FANS_1_2, Type::Debug);
-                statusTemperature =
-                    pmbusIntf->read(STATUS_TEMPERATURE, Type::Debug);
-
-                analyzeCMLFault();
-
-                analyzeInputFault();
-
-                analyzeVoutOVFault();
-
-                analyzeIoutOCFault();
-
-                analyzeVoutUVFault();
+                meter.data = pmbusIntf->readBinary(
+                    meter.file, Type::HwmonDeviceDebug,
+                    EnergyAccumulator::RAW_SIZE);
+            }
+            catch (const ReadFailure& e)
+            {
+                // Continue the interval on the next read
+                meter.data.clear();
+            }
+        }
+    }
+}
 
-                analyzeFanFault();
+void PowerSupply::analyzeStatus()
+{
+    using namespace phosphor::pmbus;
 
-                analyzeTemperatureFault();
+    if (!statusRead)
+    {
+        return;
+    }
+    statusRead = false;
 
-                analyzePgoodFault();
+    if (statusWordRead)
+    {
+        // Read worked, reset the fail count.
+        readFail = 0;
+    }
 
-                analyzeMFRFault();
+    if (statusReadFailed)
+    {
+        countReadFailure();
+        return;
+    }
 
-                analyzeVinUVFault();
+    try
+    {
+        if (statusWord)
+        {
+            // Only update the fault counts once per deglitchInterval, unless
+            // an alarm event asked for this analysis.
+            if (isDeglitchUpdateDue((statusWordOld == 0) || alarmAnalysisDue,
+                                    lastFaultAnalysis))
+            {
+                analyzeFaults();
             }
-            else
+        }
+        else
+        {
+            if (statusWord != statusWordOld)
             {
-                if (statusWord != statusWordOld)
-                {
-                    log<level::INFO>(fmt::format("{} STATUS_WORD = {:#06x}",
-                                                 shortName, statusWord)
-                                         .c_str());
-                }
-
-                // if INPUT/VIN_UV fault was on, it cleared, trace it.
-                if (inputFault)
-                {
-                    log<level::INFO>(
-                        fmt::format(
-                            "{} INPUT fault cleared: STATUS_WORD = {:#06x}",
-                            shortName, statusWord)
-                            .c_str());
-                }
-
-                if (vinUVFault)
-                {
-                    log<level::INFO>(
-                        fmt::format("{} VIN_UV cleared: STATUS_WORD = {:#06x}",
-                                    shortName, statusWord)
-                            .c_str());
-                }
-
-                if (pgoodFault > 0)
-                {
-                    log<level::INFO>(
-                        fmt::format("{} pgoodFault cleared", shortName)
-                            .c_str());
-                }
-
-                clearFaultFlags();
+                log<level::INFO>(fmt::format("{} STATUS_WORD = {:#06x}",
+                                             shortName, statusWord)
+                                     .c_str());
             }
 
-            // Save off old inputVoltage value.
-            // Get latest inputVoltage.
-            // If voltage went from below minimum, and now is not, clear faults.
-            // Note: getInputVoltage() has its own try/catch.
-            int inputVoltageOld = inputVoltage;
-            double actualInputVoltageOld = actualInputVoltage;
-            getInputVoltage(actualInputVoltage, inputVoltage);
-            if ((inputVoltageOld == in_input::VIN_VOLTAGE_0) &&
-                (inputVoltage != in_input::VIN_VOLTAGE_0))
+            // if INPUT/VIN_UV fault was on, it cleared, trace it.
+            if (faultCount(StatusFault::input))
             {
                 log<level::INFO>(
-                    fmt::format(
-                        "{} READ_VIN back in range: actualInputVoltageOld = {} "
-                        "actualInputVoltage = {}",
-                        shortName, actualInputVoltageOld, actualInputVoltage)
+                    fmt::format("{} INPUT fault cleared: STATUS_WORD = {:#06x}",
+                                shortName, statusWord)
                         .c_str());
-                clearVinUVFault();
             }
-            else if (vinUVFault && (inputVoltage != in_input::VIN_VOLTAGE_0))
+
+            if (faultCount(StatusFault::vinUV))
             {
                 log<level::INFO>(
-                    fmt::format(
-                        "{} CLEAR_FAULTS: vinUVFault {} actualInputVoltage {}",
-                        shortName, vinUVFault, actualInputVoltage)
+                    fmt::format("{} VIN_UV cleared: STATUS_WORD = {:#06x}",
+                                shortName, statusWord)
                         .c_str());
-                // Do we have a VIN_UV fault latched that can now be cleared
-                // due to voltage back in range? Attempt to clear the fault(s),
-                // re-check faults on next call.
-                clearVinUVFault();
             }
-            else if (std::abs(actualInputVoltageOld - actualInputVoltage) >
-                     10.0)
+
+            if (faultCount(StatusFault::pgood) > 0)
             {
                 log<level::INFO>(
-                    fmt::format(
-                        "{} actualInputVoltageOld = {} actualInputVoltage = {}",
-                        shortName, actualInputVoltageOld, actualInputVoltage)
-                        .c_str());
+                    fmt::format("{} pgoodFault cleared", shortName).c_str());
             }
 
-            checkAvailability();
-
-            if (inputHistorySupported)
-            {
-                updateHistory();
-            }
+            clearFaultFlags();
         }
-        catch (const ReadFailure& e)
+        alarmAnalysisDue = false;
+        alarmFaults = 0;
+
+        // Save off old inputVoltage value.
+        // Get latest inputVoltage.
+        // If voltage went from below minimum, and now is not, clear faults.
+        // Note: readStatus() got the latest values from getInputVoltage(),
+        // which has its own try/catch.
+        int inputVoltageOld = inputVoltage;
+        double actualInputVoltageOld = actualInputVoltage;
+        inputVoltage = readInputVoltage;
+        actualInputVoltage = readActualInputVoltage;
+        if ((inputVoltageOld == in_input::VIN_VOLTAGE_0) &&
+            (inputVoltage != in_input::VIN_VOLTAGE_0))
         {
-            if (readFail < SIZE_MAX)
+            log<level::INFO>(
+                fmt::format(
+                    "{} READ_VIN back in range: actualInputVoltageOld = {} "
+                    "actualInputVoltage = {}",
+                    shortName, actualInputVoltageOld, actualInputVoltage)
+                    .c_str());
+            clearVinUVFault();
+        }
+        else if (faultCount(StatusFault::vinUV) &&
+                 (inputVoltage != in_input::VIN_VOLTAGE_0))
+        {
+            log<level::INFO>(
+                fmt::format(
+                    "{} CLEAR_FAULTS: vinUVFault {} actualInputVoltage {}",
+                    shortName, faultCount(StatusFault::vinUV),
+                    actualInputVoltage)
+                    .c_str());
+            // Do we have a VIN_UV fault latched that can now be cleared
+            // due to voltage back in range? Attempt to clear the fault(s),
+            // re-check faults on next call.
+            clearVinUVFault();
+        }
+        else if (std::abs(actualInputVoltageOld - actualInputVoltage) > 10.0)
+        {
+            log<level::INFO>(
+                fmt::format(
+                    "{} actualInputVoltageOld = {} actualInputVoltage = {}",
+                    shortName, actualInputVoltageOld, actualInputVoltage)
+                    .c_str());
+        }
+
+        checkAvailability();
+
+        if (inputHistorySupported)
+        {
+            if (historyReadFailed)
             {
-                readFail++;
+                countReadFailure();
             }
-            if (readFail == LOG_LIMIT)
+            else if (historyRead)
             {
-                phosphor::logging::commit<ReadFailure>();
+                updateHistory();
             }
         }
+
+        updateEnergy();
+    }
+    catch (const ReadFailure& e)
+    {
+        countReadFailure();
+    }
+}
+
+void PowerSupply::countReadFailure()
+{
+    if ((readFail < SIZE_MAX) &&
+        isDeglitchUpdateDue((readFail == 0), lastReadFailCount))
+    {
+        readFail++;
+    }
+    if (readFail == LOG_LIMIT)
+    {
+        phosphor::logging::commit<ReadFailure>();
     }
 }
 
@@ -703,7 +935,8 @@ void PowerSupply::clearVinUVFault()
     // Do not care about return value. Should be 1 if active, 0 if not.
     static_cast<void>(
         pmbusIntf->read("in1_lcrit_alarm", phosphor::pmbus::Type::Hwmon));
-    vinUVFault = 0;
+    faultCounts[static_cast<size_t>(StatusFault::vinUV)] = 0;
+    presentFaults &= ~faultBit(StatusFault::vinUV);
 }
 
 void PowerSupply::clearFaults()
@@ -751,22 +984,29 @@ void PowerSupply::inventoryChanged(sdbusplus::message::message& msg)
     {
         if (std::get<bool>(valPropMap->second))
         {
-            present = true;
+            setPresent(true);
             // TODO: Immediately trying to read or write the "files" causes
             // read or write failures.
             using namespace std::chrono_literals;
             std::this_thread::sleep_for(20ms);
             pmbusIntf->findHwmonDir();
+            if (!alarms.empty())
+            {
+                openAlarms();
+            }
             onOffConfig(phosphor::pmbus::ON_OFF_CONFIG_CONTROL_PIN_ONLY);
             clearFaults();
             updateInventory();
+            setupEnergy();
         }
         else
         {
-            present = false;
+            setPresent(false);
+            closeAlarms();
 
             // Clear out the now outdated inventory properties
             updateInventory();
+            setupEnergy();
         }
         checkAvailability();
     }
@@ -790,7 +1030,7 @@ void PowerSupply::inventoryAdded(sdbusplus::message::message& msg)
             auto property = properties->second.find(PRESENT_PROP);
             if (property != properties->second.end())
             {
-                present = std::get<bool>(property->second);
+                setPresent(std::get<bool>(property->second));
 
                 log<level::INFO>(fmt::format("Power Supply {} Present {}",
                                              inventoryPath, present)
@@ -808,23 +1048,13 @@ void PowerSupply::updateInventory()
     using namespace phosphor::pmbus;
 
 #if IBM_VPD
-    std::string ccin;
-    std::string pn;
-    std::string fn;
-    std::string header;
-    std::string sn;
-    using PropertyMap =
-        std::map<std::string,
-                 std::variant<std::string, std::vector<uint8_t>, bool>>;
+    using PropertyMap = InventoryCache::PropertyMap;
     PropertyMap assetProps;
     PropertyMap operProps;
     PropertyMap versionProps;
     PropertyMap ipzvpdDINFProps;
     PropertyMap ipzvpdVINIProps;
-    using InterfaceMap = std::map<std::string, PropertyMap>;
-    InterfaceMap interfaces;
-    using ObjectMap = std::map<sdbusplus::message::object_path, InterfaceMap>;
-    ObjectMap object;
+    InventoryCache::InterfaceMap interfaces;
 #endif
     log<level::DEBUG>(
         fmt::format("updateInventory() inventoryPath: {}", inventoryPath)
@@ -835,76 +1065,47 @@ void PowerSupply::updateInventory()
         // TODO: non-IBM inventory updates?
 
 #if IBM_VPD
-        try
+        // Only read from the power supply the first time after it is
+        // inserted.
+        // TODO - ibm918
+        // https://github.com/openbmc/docs/blob/master/designs/vpd-collection.md
+        // The BMC must log errors if any of the VPD cannot be properly
+        // parsed or fails ECC checks.
+        const auto& vpd = readVPD();
+
+        if (vpd.ccin)
         {
-            ccin = pmbusIntf->readString(CCIN, Type::HwmonDeviceDebug);
-            assetProps.emplace(MODEL_PROP, ccin);
-            modelName = ccin;
+            assetProps.emplace(MODEL_PROP, *vpd.ccin);
+            modelName = *vpd.ccin;
         }
-        catch (const ReadFailure& e)
+        if (vpd.partNumber)
         {
-            // Ignore the read failure, let pmbus code indicate failure,
-            // path...
-            // TODO - ibm918
-            // https://github.com/openbmc/docs/blob/master/designs/vpd-collection.md
-            // The BMC must log errors if any of the VPD cannot be properly
-            // parsed or fails ECC checks.
+            assetProps.emplace(PN_PROP, *vpd.partNumber);
         }
-
-        try
+        if (vpd.fruNumber)
         {
-            pn = pmbusIntf->readString(PART_NUMBER, Type::HwmonDeviceDebug);
-            assetProps.emplace(PN_PROP, pn);
+            assetProps.emplace(SPARE_PN_PROP, *vpd.fruNumber);
         }
-        catch (const ReadFailure& e)
+        if (vpd.serialNumber)
         {
-            // Ignore the read failure, let pmbus code indicate failure,
-            // path...
-        }
-
-        try
-        {
-            fn = pmbusIntf->readString(FRU_NUMBER, Type::HwmonDeviceDebug);
-            assetProps.emplace(SPARE_PN_PROP, fn);
-        }
-        catch (const ReadFailure& e)
-        {
-            // Ignore the read failure, let pmbus code indicate failure,
-            // path...
+            assetProps.emplace(SN_PROP, *vpd.serialNumber);
         }
-
-        try
+        if (vpd.fwVersion)
         {
-            header =
-                pmbusIntf->readString(SERIAL_HEADER, Type::HwmonDeviceDebug);
-            sn = pmbusIntf->readString(SERIAL_NUMBER, Type::HwmonDeviceDebug);
-            assetProps.emplace(SN_PROP, header + sn);
-        }
-        catch (const ReadFailure& e)
-        {
-            // Ignore the read failure, let pmbus code indicate failure,
-            // path...
-        }
-
-        try
-        {
-            fwVersion =
-                pmbusIntf->readString(FW_VERSION, Type::HwmonDeviceDebug);
+            fwVersion = *vpd.fwVersion;
             versionProps.emplace(VERSION_PROP, fwVersion);
         }
-        catch (const ReadFailure& e)
-        {
-            // Ignore the read failure, let pmbus code indicate failure,
-            // path...
-        }
 
+        auto ccin = vpd.ccin.value_or("");
+        auto pn = vpd.partNumber.value_or("");
+        auto fn = vpd.fruNumber.value_or("");
+        auto header_sn = vpd.serialNumber.value_or("");
         ipzvpdVINIProps.emplace("CC",
                                 std::vector<uint8_t>(ccin.begin(), ccin.end()));
         ipzvpdVINIProps.emplace("PN",
                                 std::vector<uint8_t>(pn.begin(), pn.end()));
         ipzvpdVINIProps.emplace("FN",
                                 std::vector<uint8_t>(fn.begin(), fn.end()));
-        std::string header_sn = header + sn;
         ipzvpdVINIProps.emplace(
             "SN", std::vector<uint8_t>(header_sn.begin(), header_sn.end()));
         std::string description = "IBM PS";
@@ -941,45 +1142,82 @@ void PowerSupply::updateInventory()
         operProps.emplace(FUNCTIONAL_PROP, present);
         interfaces.emplace(OPERATIONAL_STATE_IFACE, std::move(operProps));
 
+        // Only the properties that changed since the last update are sent.
+        // A failed update is logged and retried by the inventory cache.
         auto path = inventoryPath.substr(strlen(INVENTORY_OBJ_PATH));
-        object.emplace(path, std::move(interfaces));
+        getInventoryCache().update(bus, path, interfaces);
+#endif
+    }
+}
 
-        try
-        {
-            auto service =
-                util::getService(INVENTORY_OBJ_PATH, INVENTORY_MGR_IFACE, bus);
+void PowerSupply::setPresent(bool value)
+{
+    if (value && !present)
+    {
+        presenceEpoch++;
+    }
+    present = value;
+}
 
-            if (service.empty())
-            {
-                log<level::ERR>("Unable to get inventory manager service");
-                return;
-            }
+const PowerSupply::VPD& PowerSupply::readVPD()
+{
+    using namespace phosphor::pmbus;
 
-            auto method =
-                bus.new_method_call(service.c_str(), INVENTORY_OBJ_PATH,
-                                    INVENTORY_MGR_IFACE, "Notify");
+    if (!present)
+    {
+        return cachedVPD;
+    }
 
-            method.append(std::move(object));
+    // Start over with the VPD of the power supply that was inserted
+    if (vpdEpoch != presenceEpoch)
+    {
+        cachedVPD = VPD{};
+        maxPowerOutReadFailed = false;
+        vpdEpoch = presenceEpoch;
+    }
 
-            auto reply = bus.call(method);
+    // Fields that were already read are kept. A field that failed to read is
+    // tried again the next time.
+    [[maybe_unused]] auto readField = [this](std::optional<std::string>& field,
+                                             const char* name) {
+        if (field)
+        {
+            return;
         }
-        catch (const std::exception& e)
+        try
         {
-            log<level::ERR>(
-                std::string(e.what() + std::string(" PATH=") + inventoryPath)
-                    .c_str());
+            field = pmbusIntf->readString(name, Type::HwmonDeviceDebug);
         }
-#endif
-    }
-}
-
-auto PowerSupply::getMaxPowerOut() const
-{
-    using namespace phosphor::pmbus;
+        catch (const ReadFailure& e)
+        {
+            // Ignore the read failure, let pmbus code indicate failure,
+            // path...
+        }
+    };
 
-    auto maxPowerOut = 0;
+#if IBM_VPD
+    readField(cachedVPD.ccin, CCIN);
+    readField(cachedVPD.partNumber, PART_NUMBER);
+    readField(cachedVPD.fruNumber, FRU_NUMBER);
+    if (!cachedVPD.serialNumber)
+    {
+        std::optional<std::string> header;
+        readField(header, SERIAL_HEADER);
+        if (header)
+        {
+            std::optional<std::string> sn;
+            readField(sn, SERIAL_NUMBER);
+            if (sn)
+            {
+                cachedVPD.serialNumber = *header + *sn;
+            }
+        }
+    }
+    readField(cachedVPD.fwVersion, FW_VERSION);
+#endif
 
-    if (present)
+    if ((cachedVPD.maxPowerOut == 0) &&
+        (bindPath.string().find("ibm-cffps") != std::string::npos))
     {
         try
         {
@@ -989,17 +1227,27 @@ auto PowerSupply::getMaxPowerOut() const
             log<level::INFO>(fmt::format("{} MFR_POUT_MAX read {}", shortName,
                                          maxPowerOutStr)
                                  .c_str());
-            maxPowerOut = std::stod(maxPowerOutStr);
+            cachedVPD.maxPowerOut = std::stod(maxPowerOutStr);
         }
         catch (const std::exception& e)
         {
-            log<level::ERR>(fmt::format("{} MFR_POUT_MAX read error: {}",
-                                        shortName, e.what())
-                                .c_str());
+            // Only log the first failure, it is tried again on each call
+            if (!maxPowerOutReadFailed)
+            {
+                log<level::ERR>(fmt::format("{} MFR_POUT_MAX read error: {}",
+                                            shortName, e.what())
+                                    .c_str());
+                maxPowerOutReadFailed = true;
+            }
         }
     }
 
-    return maxPowerOut;
+    return cachedVPD;
+}
+
+auto PowerSupply::getMaxPowerOut()
+{
+    return readVPD().maxPowerOut;
 }
 
 void PowerSupply::setupInputHistory()
@@ -1029,15 +1277,28 @@ void PowerSupply::setupInputHistory()
                 // initially present.
                 if (!recordManager)
                 {
+                    // Keep the records in a file so they survive restarts
+                    std::string historyFile;
+                    if (!historyDir.empty())
+                    {
+                        historyFile = historyDir + '/' + name;
+                    }
                     recordManager = std::make_unique<history::RecordManager>(
-                        INPUT_HISTORY_MAX_RECORDS);
+                        INPUT_HISTORY_MAX_RECORDS,
+                        history::RecordManager::LAST_SEQUENCE_ID, historyFile);
+                    for (const auto& [tier, ratio, maxRec] :
+                         INPUT_HISTORY_TIERS)
+                    {
+                        recordManager->addTier(tier, ratio, maxRec);
+                    }
                 }
 
                 if (!average)
                 {
                     auto avgPath =
                         historyObjectPath + '/' + history::Average::name;
-                    average = std::make_unique<history::Average>(bus, avgPath);
+                    average = std::make_unique<history::Average>(
+                        bus, avgPath, true);
                     log<level::DEBUG>(
                         fmt::format("{} avgPath: {}", shortName, avgPath)
                             .c_str());
@@ -1047,12 +1308,34 @@ void PowerSupply::setupInputHistory()
                 {
                     auto maxPath =
                         historyObjectPath + '/' + history::Maximum::name;
-                    maximum = std::make_unique<history::Maximum>(bus, maxPath);
+                    maximum = std::make_unique<history::Maximum>(
+                        bus, maxPath, true);
                     log<level::DEBUG>(
                         fmt::format("{} maxPath: {}", shortName, maxPath)
                             .c_str());
                 }
 
+                // Each rollup tier gets its own object, for example
+                // <root>/ps0_input_power_per_5m/average
+                if (tierHistory.empty())
+                {
+                    for (const auto& tier : recordManager->getTiers())
+                    {
+                        auto tierPath =
+                            historyObjectPath + '_' + tier.getName();
+                        tierHistory.emplace_back(
+                            std::make_unique<history::Average>(
+                                bus, tierPath + '/' + history::Average::name,
+                                true),
+                            std::make_unique<history::Maximum>(
+                                bus, tierPath + '/' + history::Maximum::name,
+                                true));
+                    }
+                }
+
+                // Publish any records loaded from the history file
+                publishHistory();
+
                 log<level::DEBUG>(fmt::format("{} historyObjectPath: {}",
                                               shortName, historyObjectPath)
                                       .c_str());
@@ -1087,21 +1370,205 @@ void PowerSupply::updateHistory()
         return;
     }
 
-    // Read just the most recent average/max record
-    auto data =
-        pmbusIntf->readBinary(INPUT_HISTORY, pmbus::Type::HwmonDeviceDebug,
-                              history::RecordManager::RAW_RECORD_SIZE);
-
     // Update D-Bus only if something changed (a new record ID, or cleared
     // out)
-    auto changed = recordManager->add(data);
+    auto numRecords = recordManager->getNumRecords();
+    auto changed = recordManager->add(historyData);
     if (changed)
     {
-        average->values(std::move(recordManager->getAverageRecords()));
-        maximum->values(std::move(recordManager->getMaximumRecords()));
+        // One more record, or one more with the oldest pruned. Anything else
+        // cleared the history.
+        auto newNumRecords = recordManager->getNumRecords();
+        auto appended = (newNumRecords == numRecords + 1) ||
+                        ((newNumRecords == numRecords) &&
+                         (numRecords == recordManager->getMaxRecords()));
+        publishHistory(appended);
     }
 }
 
+void PowerSupply::publishHistory(bool appended)
+{
+    auto now = std::chrono::steady_clock::now();
+    auto refresh = !appended || (historyRefreshInterval.count() == 0) ||
+                   ((now - lastHistoryRefresh) >= historyRefreshInterval);
+    if (refresh)
+    {
+        lastHistoryRefresh = now;
+    }
+
+    // Only the new record is needed for the appended signals, so the
+    // full lists are only filled in when they are refreshed
+    history::DBusRecord newestAverage;
+    history::DBusRecord newestMaximum;
+    if (appended)
+    {
+        recordManager->getNewest(newestAverage, newestMaximum);
+        average->recordAppended(newestAverage);
+        maximum->recordAppended(newestMaximum);
+    }
+    if (refresh)
+    {
+        recordManager->getAverageRecords(historyRecords);
+        average->values(historyRecords);
+        recordManager->getMaximumRecords(historyRecords);
+        maximum->values(historyRecords);
+    }
+
+    // The properties only emit a signal when a tier changed
+    const auto& tiers = recordManager->getTiers();
+    tierNewestTimes.resize(tierHistory.size());
+    for (size_t i = 0; i < tierHistory.size(); i++)
+    {
+        if (tiers[i].getNumRecords() == 0)
+        {
+            continue;
+        }
+
+        tiers[i].getNewest(newestAverage, newestMaximum);
+        auto newest = std::get<0>(newestAverage);
+        auto tierAppended = appended && (newest != tierNewestTimes[i]);
+        tierNewestTimes[i] = newest;
+
+        if (tierAppended)
+        {
+            tierHistory[i].first->recordAppended(newestAverage);
+            tierHistory[i].second->recordAppended(newestMaximum);
+        }
+        if (refresh)
+        {
+            tiers[i].getAverageRecords(historyRecords);
+            tierHistory[i].first->values(historyRecords);
+            tiers[i].getMaximumRecords(historyRecords);
+            tierHistory[i].second->values(historyRecords);
+        }
+    }
+}
+
+void PowerSupply::setupEnergy()
+{
+    using namespace phosphor::pmbus;
+    using Unit = EnergySensorObject::Unit;
+
+    if (!present)
+    {
+        // Keep the energy, but show that the sensors are not being updated
+        for (auto& meter : energyMeters)
+        {
+            meter.accumulator.reset();
+            meter.energy->functional(false);
+            meter.power->value(std::numeric_limits<double>::quiet_NaN());
+            meter.power->functional(false);
+        }
+        return;
+    }
+
+    if (energyMeters.size() == energyCoefficients.size())
+    {
+        // Every block with known coefficients is already set up
+        return;
+    }
+
+    fs::path debugPath;
+    try
+    {
+        debugPath = pmbusIntf->getPath(Type::HwmonDeviceDebug);
+    }
+    catch (const std::exception& e)
+    {
+        return;
+    }
+
+    for (const auto& [file, direction] : ENERGY_ACCUMULATORS)
+    {
+        auto coefficients = energyCoefficients.find(file);
+        if (coefficients == energyCoefficients.end())
+        {
+            // The power cannot be converted without the coefficients
+            continue;
+        }
+
+        if (std::any_of(energyMeters.begin(), energyMeters.end(),
+                        [file = file](const auto& meter) {
+                            return std::string_view{meter.file} == file;
+                        }))
+        {
+            continue;
+        }
+
+        if (!fs::exists(debugPath / file))
+        {
+            continue;
+        }
+
+        auto name = fmt::format("{}_{}", shortName, direction);
+        auto energyPath =
+            fmt::format("{}/{}_energy", ENERGY_SENSOR_ROOT, name);
+        auto powerPath =
+            fmt::format("{}/{}_power_average", POWER_SENSOR_ROOT, name);
+
+        auto& meter = energyMeters.emplace_back();
+        meter.file = file;
+        meter.accumulator = EnergyAccumulator{coefficients->second};
+
+        // Set the properties before the objects are announced
+        meter.energy = std::make_unique<EnergySensorObject>(
+            bus, energyPath.c_str(), EnergySensorObject::action::defer_emit);
+        meter.energy->unit(Unit::Joules, true);
+        meter.energy->value(0, true);
+        meter.energy->functional(true, true);
+        meter.energy->emit_object_added();
+
+        meter.power = std::make_unique<EnergySensorObject>(
+            bus, powerPath.c_str(), EnergySensorObject::action::defer_emit);
+        meter.power->unit(Unit::Watts, true);
+        meter.power->value(0, true);
+        meter.power->functional(true, true);
+        meter.power->emit_object_added();
+
+        log<level::INFO>(
+            fmt::format("{} {} energy accounting enabled", shortName, file)
+                .c_str());
+    }
+}
+
+void PowerSupply::updateEnergy()
+{
+    for (auto& meter : energyMeters)
+    {
+        if (meter.data.empty())
+        {
+            continue;
+        }
+
+        try
+        {
+            if (meter.accumulator.add(meter.data, energyReadTime))
+            {
+                meter.energy->value(meter.accumulator.getEnergy());
+                meter.energy->functional(true);
+                meter.power->value(meter.accumulator.getAveragePower());
+                meter.power->functional(true);
+            }
+        }
+        catch (const std::invalid_argument& e)
+        {
+            log<level::DEBUG>(fmt::format("{} {} read {} bytes", shortName,
+                                          meter.file, meter.data.size())
+                                  .c_str());
+        }
+    }
+}
+
+double PowerSupply::getInputEnergy() const
+{
+    auto it = std::find_if(energyMeters.begin(), energyMeters.end(),
+                           [](const auto& meter) {
+                               return std::string_view{meter.file} ==
+                                      phosphor::pmbus::READ_EIN;
+                           });
+    return (it != energyMeters.end()) ? it->accumulator.getEnergy() : 0;
+}
+
 void PowerSupply::getInputVoltage(double& actualInputVoltage,
                                   int& inputVoltage) const
 {
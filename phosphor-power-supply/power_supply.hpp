@@ -1,18 +1,32 @@
 #pragma once
 
 #include "average.hpp"
+#include "energy_accumulator.hpp"
+#include "file_descriptor.hpp"
 #include "maximum.hpp"
 #include "pmbus.hpp"
 #include "record_manager.hpp"
+#include "status_decoder.hpp"
 #include "types.hpp"
 #include "util.hpp"
 #include "utility.hpp"
 
 #include <gpiod.hpp>
 #include <sdbusplus/bus/match.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+#include <xyz/openbmc_project/Sensor/Value/server.hpp>
+#include <xyz/openbmc_project/State/Decorator/OperationalStatus/server.hpp>
 
+#include <array>
+#include <chrono>
 #include <filesystem>
+#include <functional>
+#include <map>
+#include <optional>
+#include <span>
 #include <stdexcept>
+#include <vector>
 
 namespace phosphor::power::psu
 {
@@ -40,6 +54,11 @@ static constexpr auto FL_KW_SIZE = 20;
 constexpr auto LOG_LIMIT = 3;
 constexpr auto DEGLITCH_LIMIT = 3;
 constexpr auto PGOOD_DEGLITCH_LIMIT = 5;
+// The fault and read failure counts were designed around a one second poll.
+constexpr auto DEGLITCH_INTERVAL = std::chrono::milliseconds(1000);
+// Time to delay between power supply going from missing to present before
+// running the bind command(s).
+constexpr auto BIND_DELAY = std::chrono::milliseconds(1000);
 
 /**
  * @class PowerSupply
@@ -62,10 +81,13 @@ class PowerSupply
      * @param[in] driver - i2c driver name for power supply
      * @param[in] gpioLineName - The gpio-line-name to read for presence. See
      * https://github.com/openbmc/docs/blob/master/designs/device-tree-gpio-naming.md
+     * @param[in] historyDir - Directory to keep the INPUT_HISTORY records in
+     * so they survive restarts.  If empty, they are only kept in memory.
      */
     PowerSupply(sdbusplus::bus::bus& bus, const std::string& invpath,
                 std::uint8_t i2cbus, const std::uint16_t i2caddr,
-                const std::string& driver, const std::string& gpioLineName);
+                const std::string& driver, const std::string& gpioLineName,
+                const std::string& historyDir = "");
 
     phosphor::pmbus::PMBusBase& getPMBus()
     {
@@ -89,15 +111,189 @@ class PowerSupply
         }
     }
 
+    /**
+     * @brief Monitors the presence GPIO line for events.
+     *
+     * Requests both-edge events on the presence GPIO line and adds the event
+     * file descriptor to the event loop. Presence changes are then handled as
+     * soon as they occur instead of on the next call to analyze().
+     *
+     * If there is no presence GPIO, or the line cannot be requested for
+     * events, presence continues to be read by analyze().
+     *
+     * @param[in] event - The event loop to add the GPIO event source to
+     */
+    void monitorPresenceEvents(const sdeventplus::Event& event);
+
+    /**
+     * @brief Monitors the hwmon input alarm attributes for changes.
+     *
+     * Keeps in1_lcrit_alarm and power1_alarm open and adds them to the event
+     * loop, waiting for POLLPRI. When the device driver calls sysfs_notify()
+     * on one of them, the callback is called right away so this power supply
+     * can be analyzed without waiting for the next poll.
+     *
+     * An alarm that is on was latched by the device driver, so the matching
+     * VIN_UV or INPUT fault is not deglitched by that analysis.
+     *
+     * Attributes that cannot be opened are skipped. They are opened again
+     * when the power supply is reinserted, since the hwmon directory can
+     * change.
+     *
+     * @param[in] event - The event loop to add the event sources to
+     * @param[in] callback - Called with this power supply after an alarm
+     *                       attribute changed
+     */
+    void monitorAlarmEvents(const sdeventplus::Event& event,
+                            std::function<void(PowerSupply&)> callback);
+
+    /**
+     * @brief Handles a change of an input alarm attribute.
+     *
+     * Called by the alarm event sources after reading the attribute. If the
+     * alarm is on, the fault it latches is counted at its deglitch limit.
+     * Either way, the next analysis updates the fault counts even if the
+     * deglitch interval has not passed. Then the callback given to
+     * monitorAlarmEvents() is called.
+     *
+     * @param[in] fault - The fault the alarm latches
+     * @param[in] on - If the alarm is on
+     */
+    void alarmChanged(StatusFault fault, bool on);
+
+    /**
+     * @brief Sets the minimum time between updates of the fault counts.
+     *
+     * The fault and read failure counts are compared against DEGLITCH_LIMIT,
+     * PGOOD_DEGLITCH_LIMIT, and LOG_LIMIT. By default they are updated on
+     * every call to analyze(). When analyze() is called more often than once
+     * per DEGLITCH_INTERVAL, setting the interval keeps a fault from being
+     * reported until it has been seen for the same amount of time.
+     *
+     * The first time a fault or read failure is seen it is counted right
+     * away. Since the time between calls varies, the interval should be
+     * shorter than the poll interval it is meant to match by the expected
+     * jitter. Otherwise a call that comes a little early is not counted.
+     *
+     * @param[in] interval - Minimum time between updates of the counts
+     */
+    void setDeglitchInterval(std::chrono::milliseconds interval)
+    {
+        deglitchInterval = interval;
+    }
+
+    /**
+     * @brief Sets how often the whole input history is sent on D-Bus.
+     *
+     * Each new INPUT_HISTORY record is always sent in a RecordAppended
+     * signal. The Values properties, which contain all of the records, are
+     * set with every new record if the interval is 0, the default. Otherwise
+     * they are only set with the first new record after the interval has
+     * passed since they were last set, or when the history is cleared.
+     *
+     * @param[in] interval - Minimum time between updates of the Values
+     *                       properties
+     */
+    void setHistoryRefreshInterval(std::chrono::seconds interval)
+    {
+        historyRefreshInterval = interval;
+    }
+
+    /**
+     * @brief Sets how often readStatus() reads the INPUT_HISTORY record and
+     * the energy accumulator blocks.
+     *
+     * A new INPUT_HISTORY record is only available every 30s and the energy
+     * accumulators include every sample, so they do not need to be read at
+     * the fast rate used while faults are analyzed. If the interval is 0, the
+     * default, they are read by every call.
+     *
+     * @param[in] interval - Minimum time between the reads
+     */
+    void setTelemetryReadInterval(std::chrono::milliseconds interval)
+    {
+        telemetryReadInterval = interval;
+    }
+
+    /**
+     * @brief Sets the direct format coefficients of the power in a READ_EIN
+     * or READ_EOUT energy accumulator block.
+     *
+     * The sensors of a block are only created once its coefficients are
+     * known, since the power cannot be converted without them.
+     *
+     * @param[in] file - The file name of the block, READ_EIN or READ_EOUT
+     * @param[in] coefficients - The coefficients of READ_PIN for READ_EIN, or
+     * of READ_POUT for READ_EOUT
+     */
+    void setEnergyCoefficients(
+        const std::string& file,
+        const EnergyAccumulator::Coefficients& coefficients)
+    {
+        energyCoefficients[file] = coefficients;
+        setupEnergy();
+    }
+
+    /**
+     * @brief Sets the time to wait before binding the device driver after the
+     * power supply is inserted.
+     *
+     * Defaults to BIND_DELAY.
+     *
+     * @param[in] delay - Time to wait before binding the device driver
+     */
+    void setBindDelay(std::chrono::milliseconds delay)
+    {
+        bindDelay = delay;
+    }
+
     /**
      * Power supply specific function to analyze for faults/errors.
      *
      * Various PMBus status bits will be checked for fault conditions.
      * If a certain fault bits are on, the appropriate error will be
      * committed.
+     *
+     * Same as calling pollPresence(), readStatus(), and analyzeStatus().
      */
     void analyze();
 
+    /**
+     * @brief Updates the presence by reading the presence GPIO.
+     *
+     * Does nothing if the presence is updated by D-Bus signals or GPIO
+     * events. May update D-Bus, so only call from the main thread.
+     */
+    void pollPresence();
+
+    /**
+     * @brief Reads the PMBus status registers, input voltage, and input
+     *        history of a present power supply.
+     *
+     * The values are saved for the next call to analyzeStatus(). Does not
+     * access D-Bus or change any fault state, so it may be called from a
+     * worker thread. Only the PMBus interface and the saved register values
+     * of this power supply are accessed. No other member function may be
+     * called until it returns.
+     */
+    void readStatus();
+
+    /**
+     * @brief Analyzes the values saved by readStatus() for faults/errors.
+     *
+     * Updates the fault counts, availability, and input history. May update
+     * D-Bus, so only call from the main thread.
+     */
+    void analyzeStatus();
+
+    /**
+     * @brief Returns the I2C bus this power supply is on.
+     */
+    std::uint8_t getI2CBus() const
+    {
+        return i2cBus;
+    }
+
     /**
      * Write PMBus ON_OFF_CONFIG
      *
@@ -114,20 +310,10 @@ class PowerSupply
      */
     void clearFaultFlags()
     {
-        inputFault = 0;
-        mfrFault = 0;
+        faultCounts.fill(0);
+        activeFaults = 0;
+        presentFaults = 0;
         statusMFR = 0;
-        vinUVFault = 0;
-        cmlFault = 0;
-        voutOVFault = 0;
-        ioutOCFault = 0;
-        voutUVFault = 0;
-        fanFault = 0;
-        tempFault = 0;
-        pgoodFault = 0;
-        psKillFault = 0;
-        ps12VcsFault = 0;
-        psCS12VFault = 0;
         faultLogged = false;
     }
 
@@ -171,6 +357,9 @@ class PowerSupply
      * - Part Number
      * - CCIN (Customer Card Identification Number) - added as the Model
      * - Firmware version
+     *
+     * The values are read from the power supply only once each time it
+     * becomes present, see readVPD().
      */
     void updateInventory();
 
@@ -249,17 +438,7 @@ class PowerSupply
     /**
      * @brief Returns true if a fault was found.
      */
-    bool isFaulted() const
-    {
-        return (hasCommFault() || (vinUVFault >= DEGLITCH_LIMIT) ||
-                (inputFault >= DEGLITCH_LIMIT) ||
-                (voutOVFault >= DEGLITCH_LIMIT) ||
-                (ioutOCFault >= DEGLITCH_LIMIT) ||
-                (voutUVFault >= DEGLITCH_LIMIT) ||
-                (fanFault >= DEGLITCH_LIMIT) || (tempFault >= DEGLITCH_LIMIT) ||
-                (pgoodFault >= PGOOD_DEGLITCH_LIMIT) ||
-                (mfrFault >= DEGLITCH_LIMIT));
-    }
+    bool isFaulted() const;
 
     /**
      * @brief Return whether a fault has been logged for this power supply
@@ -277,12 +456,20 @@ class PowerSupply
         faultLogged = true;
     }
 
+    /**
+     * @brief Returns true if a fault has been on for its deglitch limit.
+     */
+    bool hasFault(StatusFault fault) const
+    {
+        return (presentFaults & faultBit(fault)) != 0;
+    }
+
     /**
      * @brief Returns true if INPUT fault occurred.
      */
     bool hasInputFault() const
     {
-        return (inputFault >= DEGLITCH_LIMIT);
+        return hasFault(StatusFault::input);
     }
 
     /**
@@ -290,7 +477,7 @@ class PowerSupply
      */
     bool hasMFRFault() const
     {
-        return (mfrFault >= DEGLITCH_LIMIT);
+        return hasFault(StatusFault::mfr);
     }
 
     /**
@@ -298,7 +485,7 @@ class PowerSupply
      */
     bool hasVINUVFault() const
     {
-        return (vinUVFault >= DEGLITCH_LIMIT);
+        return hasFault(StatusFault::vinUV);
     }
 
     /**
@@ -306,7 +493,7 @@ class PowerSupply
      */
     bool hasVoutOVFault() const
     {
-        return (voutOVFault >= DEGLITCH_LIMIT);
+        return hasFault(StatusFault::voutOV);
     }
 
     /**
@@ -314,7 +501,7 @@ class PowerSupply
      */
     bool hasIoutOCFault() const
     {
-        return (ioutOCFault >= DEGLITCH_LIMIT);
+        return hasFault(StatusFault::ioutOC);
     }
 
     /**
@@ -322,7 +509,7 @@ class PowerSupply
      */
     bool hasVoutUVFault() const
     {
-        return (voutUVFault >= DEGLITCH_LIMIT);
+        return hasFault(StatusFault::voutUV);
     }
 
     /**
@@ -330,7 +517,7 @@ class PowerSupply
      */
     bool hasFanFault() const
     {
-        return (fanFault >= DEGLITCH_LIMIT);
+        return hasFault(StatusFault::fan);
     }
 
     /**
@@ -338,7 +525,7 @@ class PowerSupply
      */
     bool hasTempFault() const
     {
-        return (tempFault >= DEGLITCH_LIMIT);
+        return hasFault(StatusFault::temperature);
     }
 
     /**
@@ -347,7 +534,7 @@ class PowerSupply
      */
     bool hasPgoodFault() const
     {
-        return (pgoodFault >= PGOOD_DEGLITCH_LIMIT);
+        return hasFault(StatusFault::pgood);
     }
 
     /**
@@ -355,7 +542,7 @@ class PowerSupply
      */
     bool hasPSKillFault() const
     {
-        return (psKillFault >= DEGLITCH_LIMIT);
+        return hasFault(StatusFault::psKill);
     }
 
     /**
@@ -363,7 +550,7 @@ class PowerSupply
      */
     bool hasPS12VcsFault() const
     {
-        return (ps12VcsFault >= DEGLITCH_LIMIT);
+        return hasFault(StatusFault::ps12Vcs);
     }
 
     /**
@@ -371,7 +558,7 @@ class PowerSupply
      */
     bool hasPSCS12VFault() const
     {
-        return (psCS12VFault >= DEGLITCH_LIMIT);
+        return hasFault(StatusFault::psCS12V);
     }
 
     /**
@@ -426,7 +613,7 @@ class PowerSupply
      */
     bool hasCommFault() const
     {
-        return ((readFail >= LOG_LIMIT) || (cmlFault >= DEGLITCH_LIMIT));
+        return ((readFail >= LOG_LIMIT) || hasFault(StatusFault::cml));
     }
 
     /**
@@ -491,6 +678,49 @@ class PowerSupply
         }
     }
 
+    /**
+     * @brief Returns the last INPUT_HISTORY record read from the power
+     * supply, or an empty vector if none was read.
+     */
+    const std::vector<uint8_t>& getInputHistoryData() const
+    {
+        return historyData;
+    }
+
+    /**
+     * @brief Setup for power supply energy accounting.
+     *
+     * If the device driver provides the READ_EIN or READ_EOUT energy
+     * accumulator and its coefficients are known, creates the D-Bus sensors
+     * for the energy and the average power it reports. When the power supply
+     * is missing, marks the sensors non-functional and forgets the last
+     * accumulator readings so the next interval starts when it is present
+     * again.
+     */
+    void setupEnergy();
+
+    /**
+     * @brief Returns true if this power supply reports READ_EIN or READ_EOUT.
+     */
+    bool hasEnergy() const
+    {
+        return !energyMeters.empty();
+    }
+
+    /**
+     * @brief Returns the input energy since the monitor started, in joules,
+     * or 0 if READ_EIN is not supported.
+     */
+    double getInputEnergy() const;
+
+    /**
+     * @brief Returns the actual input voltage, in Volts.
+     */
+    double getActualInputVoltage() const
+    {
+        return actualInputVoltage;
+    }
+
     /**
      * @brief Returns true when INPUT_HISTORY sync is required.
      */
@@ -554,179 +784,165 @@ class PowerSupply
     /** @brief True if an error for a fault has already been logged. */
     bool faultLogged = false;
 
-    /** @brief Incremented if bit 1 of STATUS_WORD low byte is on.
+    /**
+     * @brief The number of fault analyses each StatusFault has been on in,
+     * indexed by StatusFault.
      *
-     * Considered faulted if reaches DEGLITCH_LIMIT.
+     * Counting stops at the deglitch limit of the fault.
      */
-    size_t cmlFault = 0;
+    std::array<size_t, statusFaultCount> faultCounts{};
 
-    /** @brief Incremented if bit 5 of STATUS_WORD high byte is on.
-     *
-     * Considered faulted if reaches DEGLITCH_LIMIT.
-     */
-    size_t inputFault = 0;
+    /** @brief The faults that were on in the last fault analysis. */
+    StatusFaults activeFaults = 0;
 
-    /** @brief Incremented if bit 4 of STATUS_WORD high byte is on.
-     *
-     * Considered faulted if reaches DEGLITCH_LIMIT.
-     */
-    size_t mfrFault = 0;
+    /** @brief The faults whose count reached their deglitch limit. */
+    StatusFaults presentFaults = 0;
 
-    /** @brief Incremented if bit 3 of STATUS_WORD low byte is on.
+    /**
+     * @brief The fault descriptors specific to the power supply model.
      *
-     * Considered faulted if reaches DEGLITCH_LIMIT.
+     * Decoded in addition to the common STATUS_WORD faults. Selected by the
+     * device driver.
      */
-    size_t vinUVFault = 0;
+    std::span<const StatusFaultDescriptor> modelFaults;
 
-    /** @brief Incremented if bit 5 of STATUS_WORD low byte is on.
-     *
-     * Considered faulted if reaches DEGLITCH_LIMIT.
-     */
-    size_t voutOVFault = 0;
+    /** @brief Count of the number of read failures. */
+    size_t readFail = 0;
 
-    /** @brief Incremented if bit 4 of STATUS_WORD low byte is on.
-     *
-     * Considered faulted if reaches DEGLITCH_LIMIT.
-     */
-    size_t ioutOCFault = 0;
+    /** @brief The I2C bus this power supply is on. */
+    std::uint8_t i2cBus = 0;
 
-    /** @brief Incremented if bit 7 of STATUS_WORD high byte is on and bit 5
-     * (VOUT_OV) of low byte is off.
-     *
-     * Considered faulted if reaches DEGLITCH_LIMIT.
-     */
-    size_t voutUVFault = 0;
+    /** @brief True if readStatus() read the power supply. */
+    bool statusRead = false;
 
-    /** @brief Incremented if FANS fault/warn bit on in STATUS_WORD.
-     *
-     * Considered faulted if reaches DEGLITCH_LIMIT.
-     */
-    size_t fanFault = 0;
+    /** @brief True if readStatus() read STATUS_WORD. */
+    bool statusWordRead = false;
 
-    /** @brief Incremented if bit 2 of STATUS_WORD low byte is on.
-     *
-     * Considered faulted if reaches DEGLITCH_LIMIT. */
-    size_t tempFault = 0;
+    /** @brief True if readStatus() failed to read a status register. */
+    bool statusReadFailed = false;
 
-    /**
-     * @brief Incremented if bit 11 or 6 of STATUS_WORD is on. PGOOD# is
-     * inactive, or the unit is off.
-     *
-     * Considered faulted if reaches DEGLITCH_LIMIT.
-     */
-    size_t pgoodFault = 0;
+    /** @brief True if readStatus() read INPUT_HISTORY. */
+    bool historyRead = false;
 
-    /**
-     * @brief Power Supply Kill fault.
-     *
-     * Incremented based on bits in STATUS_MFR_SPECIFIC. IBM power supplies use
-     * bit 4 to indicate this fault. Considered faulted if it reaches
-     * DEGLITCH_LIMIT.
-     */
-    size_t psKillFault = 0;
+    /** @brief True if readStatus() failed to read INPUT_HISTORY. */
+    bool historyReadFailed = false;
 
     /**
-     * @brief Power Supply 12Vcs fault (standby power).
-     *
-     * Incremented based on bits in STATUS_MFR_SPECIFIC. IBM power supplies use
-     * bit 6 to indicate this fault. Considered faulted if it reaches
-     * DEGLITCH_LIMIT.
+     * @brief Minimum time between the reads of INPUT_HISTORY and the energy
+     * accumulators.
      */
-    size_t ps12VcsFault = 0;
+    std::chrono::milliseconds telemetryReadInterval{0};
 
     /**
-     * @brief Power Supply Current-Share fault in 12V domain.
-     *
-     * Incremented based on bits in STATUS_MFR_SPECIFIC. IBM power supplies use
-     * bit 7 to indicate this fault. Considered faulted if it reaches
-     * DEGLITCH_LIMIT.
+     * @brief When readStatus() last read INPUT_HISTORY and the energy
+     * accumulators.
      */
-    size_t psCS12VFault = 0;
+    std::optional<std::chrono::steady_clock::time_point> lastTelemetryRead;
 
-    /** @brief Count of the number of read failures. */
-    size_t readFail = 0;
+    /** @brief The input voltage read by readStatus(), in volts. */
+    double readActualInputVoltage = 0;
 
-    /**
-     * @brief Examine STATUS_WORD for CML (communication, memory, logic fault).
-     */
-    void analyzeCMLFault();
+    /** @brief The input voltage range read by readStatus(). */
+    int readInputVoltage = phosphor::pmbus::in_input::VIN_VOLTAGE_0;
 
-    /**
-     * @brief Examine STATUS_WORD for INPUT bit on.
-     *
-     * "An input voltage, input current, or input power fault or warning has
-     * occurred."
-     */
-    void analyzeInputFault();
+    /** @brief The INPUT_HISTORY record read by readStatus(). */
+    std::vector<uint8_t> historyData;
 
-    /**
-     * @brief Examine STATUS_WORD for VOUT being set.
-     *
-     * If VOUT is on, "An output voltage fault or warning has occurred.", and
-     * VOUT_OV_FAULT is on, there is an output over-voltage fault.
-     */
-    void analyzeVoutOVFault();
+    /** @brief Reused storage for the history records sent to D-Bus. */
+    history::RecordManager::DBusRecordList historyRecords;
 
-    /*
-     * @brief Examine STATUS_WORD value read for IOUT_OC_FAULT.
-     *
-     * "An output overcurrent fault has occurred." If it is on, and fault not
-     * set, trace STATUS_WORD, STATUS_MFR_SPECIFIC, and STATUS_IOUT values.
-     */
-    void analyzeIoutOCFault();
+    using EnergySensorObject = sdbusplus::server::object_t<
+        sdbusplus::xyz::openbmc_project::Sensor::server::Value,
+        sdbusplus::xyz::openbmc_project::State::Decorator::server::
+            OperationalStatus>;
 
     /**
-     * @brief Examines STATUS_WORD value read to see if there is a UV fault.
-     *
-     * Checks if the VOUT bit is on, indicating "An output voltage fault or
-     * warning has occurred", if it is on, but VOUT_OV_FAULT is off, it is
-     * determined to be an indication of an output under-voltage fault.
+     * @brief The direct format coefficients of the energy accumulator
+     * blocks, by file name.
      */
-    void analyzeVoutUVFault();
+    std::map<std::string, EnergyAccumulator::Coefficients> energyCoefficients;
 
     /**
-     * @brief Examine STATUS_WORD for the fan fault/warning bit.
-     *
-     * If fanFault is not on, trace that the bit now came on, include
-     * STATUS_WORD, STATUS_MFR_SPECIFIC, and STATUS_FANS_1_2 values as well, to
-     * help with understanding what may have caused it to be set.
+     * @brief A READ_EIN or READ_EOUT energy accumulator and its D-Bus
+     * sensors.
      */
-    void analyzeFanFault();
+    struct EnergyMeter
+    {
+        /** @brief The file name of the accumulator block */
+        const char* file;
+
+        /** @brief Tracks the energy and average power */
+        EnergyAccumulator accumulator;
+
+        /** @brief The block read by readStatus(); empty if it failed */
+        std::vector<uint8_t> data;
+
+        /** @brief The energy sensor, in joules */
+        std::unique_ptr<EnergySensorObject> energy;
+
+        /** @brief The average power sensor, in watts */
+        std::unique_ptr<EnergySensorObject> power;
+    };
+
+    /** @brief The energy accumulators; empty if there are none. */
+    std::vector<EnergyMeter> energyMeters;
+
+    /** @brief When readStatus() read the energy accumulators. */
+    std::chrono::steady_clock::time_point energyReadTime{};
 
     /**
-     * @brief Examine STATUS_WORD for temperature fault.
+     * @brief Adds the energy accumulator blocks read by readStatus() and
+     * updates the energy and average power sensors at the end of an interval.
      */
-    void analyzeTemperatureFault();
+    void updateEnergy();
 
     /**
-     * @brief Examine STATUS_WORD for pgood or unit off faults.
+     * @brief Counts a read failure and logs an error at LOG_LIMIT.
      */
-    void analyzePgoodFault();
+    void countReadFailure();
+
+    /** @brief Minimum time between updates of the fault counts. */
+    std::chrono::milliseconds deglitchInterval{0};
+
+    /** @brief Time to wait before binding the device driver. */
+    std::chrono::milliseconds bindDelay{BIND_DELAY};
+
+    /** @brief The last time the STATUS_WORD fault bits were analyzed. */
+    std::chrono::steady_clock::time_point lastFaultAnalysis{};
+
+    /** @brief The last time a read failure was counted. */
+    std::chrono::steady_clock::time_point lastReadFailCount{};
 
     /**
-     * @brief Determine possible manufacturer-specific faults from bits in
-     * STATUS_MFR.
+     * @brief Returns true if the fault counts should be updated.
+     *
+     * Always true for a new fault. Otherwise true if deglitchInterval has
+     * elapsed since the last update.
      *
-     * The bits in the STATUS_MFR_SPECIFIC command response have "Manufacturer
-     * Defined" meanings. Determine which faults, if any, are present based on
-     * the power supply (device driver) type.
+     * @param[in] isNewFault - True if the fault was not seen last time
+     * @param[in,out] lastUpdate - The last time the counts were updated. Set
+     *                             to the current time if true is returned.
      */
-    void determineMFRFault();
+    bool isDeglitchUpdateDue(bool isNewFault,
+                             std::chrono::steady_clock::time_point& lastUpdate);
 
     /**
-     * @brief Examine STATUS_WORD value read for MFRSPECIFIC bit on.
-     *
-     * "A manufacturer specific fault or warning has occurred."
+     * @brief Decodes the status registers into the fault counts.
      *
-     * If it is on, call the determineMFRFault() helper function to examine the
-     * value read from STATUS_MFR_SPECIFIC.
+     * All status registers are decoded against the common and model fault
+     * descriptor tables in one pass. The faults that came on or went off are
+     * traced, and the counts of the faults that are on are incremented up to
+     * their deglitch limit.
      */
-    void analyzeMFRFault();
+    void analyzeFaults();
 
     /**
-     * @brief Analyzes the STATUS_WORD for a VIN_UV_FAULT indicator.
+     * @brief Returns how many fault analyses a fault has been on in.
      */
-    void analyzeVinUVFault();
+    size_t faultCount(StatusFault fault) const
+    {
+        return faultCounts[static_cast<size_t>(fault)];
+    }
 
     /**
      * @brief D-Bus path to use for this power supply's inventory status.
@@ -765,6 +981,51 @@ class PowerSupply
      */
     std::unique_ptr<GPIOInterfaceBase> presenceGPIO = nullptr;
 
+    /**
+     * @brief Event source for presence GPIO line events
+     *
+     * Only set if the presence GPIO line is monitored for events.
+     */
+    std::unique_ptr<sdeventplus::source::IO> presenceEventSource = nullptr;
+
+    /**
+     * @brief A monitored hwmon alarm attribute
+     */
+    struct AlarmMonitor
+    {
+        /** @brief The attribute file name */
+        const char* name;
+
+        /** @brief The fault the alarm latches */
+        StatusFault fault;
+
+        /** @brief The open attribute file */
+        phosphor::power::util::FileDescriptor fd;
+
+        /** @brief Event source waiting for POLLPRI on fd */
+        std::unique_ptr<sdeventplus::source::IO> source;
+    };
+
+    /**
+     * @brief The monitored alarm attributes
+     *
+     * Empty unless monitorAlarmEvents() was called. Not resized after that,
+     * since the event callbacks refer to the entries by index.
+     */
+    std::vector<AlarmMonitor> alarms;
+
+    /** @brief The event loop the alarm event sources are added to */
+    std::optional<sdeventplus::Event> alarmEvent;
+
+    /** @brief Called after an alarm attribute changed */
+    std::function<void(PowerSupply&)> alarmCallback;
+
+    /** @brief True if an alarm changed since the last fault analysis. */
+    bool alarmAnalysisDue = false;
+
+    /** @brief The faults whose alarm was on when it last changed. */
+    StatusFaults alarmFaults = 0;
+
     /** @brief True if the power supply is present. */
     bool present = false;
 
@@ -834,6 +1095,34 @@ class PowerSupply
      */
     void updatePresenceGPIO();
 
+    /**
+     * @brief Callback for presence GPIO line events
+     *
+     * Discards the pending events and updates the power supply presence by
+     * reading the GPIO line.
+     */
+    void presenceEventReceived();
+
+    /**
+     * @brief Opens the alarm attributes in the current hwmon directory and
+     * enables their event sources.
+     */
+    void openAlarms();
+
+    /**
+     * @brief Disables the alarm event sources and closes the attributes.
+     */
+    void closeAlarms();
+
+    /**
+     * @brief Callback for alarm attribute events
+     *
+     * Reads the attribute, which also rearms it, and calls alarmChanged().
+     *
+     * @param[in] alarm - The alarm attribute that changed
+     */
+    void alarmEventReceived(AlarmMonitor& alarm);
+
     /**
      * @brief Callback for inventory property changes
      *
@@ -859,17 +1148,64 @@ class PowerSupply
     void inventoryAdded(sdbusplus::message::message& msg);
 
     /**
-     * @brief Reads the pmbus MFR_POUT_MAX value.
+     * @brief Returns the pmbus MFR_POUT_MAX value.
      *
      * "The MFR_POUT_MAX command sets or retrieves the maximum rated output
      * power, in watts, that the unit is rated to supply."
      *
      * @return max_power_out value converted from string.
      */
-    auto getMaxPowerOut() const;
+    auto getMaxPowerOut();
 
     /**
-     * @brief Reads the most recent input history record from the power supply
+     * @brief The vital product data read from the power supply.
+     *
+     * A field is empty if it could not be read.
+     */
+    struct VPD
+    {
+        std::optional<std::string> ccin;
+        std::optional<std::string> partNumber;
+        std::optional<std::string> fruNumber;
+
+        /** @brief The serial number header and serial number */
+        std::optional<std::string> serialNumber;
+
+        std::optional<std::string> fwVersion;
+
+        /** @brief MFR_POUT_MAX, 0 if it could not be read */
+        int maxPowerOut = 0;
+    };
+
+    /**
+     * @brief Returns the VPD of the power supply.
+     *
+     * The fields are read the first time the VPD is needed after the power
+     * supply becomes present. Later calls return the cached fields, and only
+     * read the fields that failed to read again.
+     */
+    const VPD& readVPD();
+
+    /**
+     * @brief Sets the present state, starting a new presence epoch when the
+     * power supply becomes present.
+     */
+    void setPresent(bool value);
+
+    /** @brief The VPD fields read by readVPD() in vpdEpoch. */
+    VPD cachedVPD;
+
+    /** @brief Incremented each time the power supply becomes present. */
+    size_t presenceEpoch = 0;
+
+    /** @brief The presenceEpoch cachedVPD was read in, if any. */
+    std::optional<size_t> vpdEpoch;
+
+    /** @brief True if MFR_POUT_MAX failed to read in vpdEpoch. */
+    bool maxPowerOutReadFailed = false;
+
+    /**
+     * @brief Adds the most recent input history record read by readStatus()
      * and updates the average and maximum properties in D-Bus if there is a new
      * reading available.
      *
@@ -882,6 +1218,28 @@ class PowerSupply
      */
     void updateHistory();
 
+    /**
+     * @brief Sets the input history D-Bus properties from the records of
+     * the record manager.
+     *
+     * If records were only appended, a RecordAppended signal is sent for
+     * each new record, and the properties are only set if the history
+     * refresh interval has passed.
+     *
+     * @param[in] appended - True if new records were appended to the
+     *                       history and nothing else changed.
+     */
+    void publishHistory(bool appended = false);
+
+    /** @brief Minimum time between updates of the history properties. */
+    std::chrono::seconds historyRefreshInterval{0};
+
+    /** @brief The last time the history properties were set. */
+    std::chrono::steady_clock::time_point lastHistoryRefresh{};
+
+    /** @brief The timestamp of the newest record of each rollup tier. */
+    std::vector<uint64_t> tierNewestTimes;
+
     /**
      * @brief Set to true if INPUT_HISTORY command supported.
      *
@@ -914,6 +1272,21 @@ class PowerSupply
      **/
     std::unique_ptr<history::Maximum> maximum;
 
+    /**
+     * @brief The D-Bus objects for the average and maximum input power
+     * history of each rollup tier, in the order of
+     * RecordManager::getTiers().
+     **/
+    std::vector<std::pair<std::unique_ptr<history::Average>,
+                          std::unique_ptr<history::Maximum>>>
+        tierHistory;
+
+    /**
+     * @brief The directory of the INPUT_HISTORY record file; empty if the
+     * records are only kept in memory.
+     **/
+    std::string historyDir;
+
     /**
      * @brief The base D-Bus object path to use for the average and maximum
      * objects.
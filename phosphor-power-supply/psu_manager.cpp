@@ -9,6 +9,10 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <array>
+#include <iterator>
+#include <map>
+#include <optional>
 #include <regex>
 #include <set>
 
@@ -29,13 +33,62 @@ constexpr auto i2cAddressProp = "I2CAddress";
 constexpr auto psuNameProp = "Name";
 constexpr auto presLineName = "NamedPresenceGpio";
 
+// The direct format coefficients [m, b, R] of READ_PIN and READ_POUT, which
+// the READ_EIN and READ_EOUT energy accumulators use.
+const std::array<std::pair<const char*, const char*>, 2> energyCoefficientProps{
+    {{"InputPowerCoefficients", phosphor::pmbus::READ_EIN},
+     {"OutputPowerCoefficients", phosphor::pmbus::READ_EOUT}}};
+
 constexpr auto supportedConfIntf =
     "xyz.openbmc_project.Configuration.SupportedConfiguration";
 
+constexpr auto objectManagerIntf = "org.freedesktop.DBus.ObjectManager";
+
+using ManagedObjects =
+    std::map<sdbusplus::message::object_path,
+             std::map<std::string, util::DbusPropertyMap>>;
+
+/**
+ * Returns the direct format coefficients in a configuration property, or
+ * std::nullopt if it does not contain valid ones.
+ *
+ * An array with negative values may have the type of its first value, so the
+ * values of a uint64_t array are converted to int64_t.
+ */
+std::optional<EnergyAccumulator::Coefficients>
+    getCoefficients(const util::DbusVariant& value)
+{
+    std::vector<int64_t> values;
+    if (auto v = std::get_if<std::vector<int64_t>>(&value))
+    {
+        values = *v;
+    }
+    else if (auto v = std::get_if<std::vector<uint64_t>>(&value))
+    {
+        std::transform(v->begin(), v->end(), std::back_inserter(values),
+                       [](auto x) { return static_cast<int64_t>(x); });
+    }
+
+    if ((values.size() != 3) || (values[0] == 0))
+    {
+        return std::nullopt;
+    }
+
+    return EnergyAccumulator::Coefficients{
+        .m = static_cast<int>(values[0]),
+        .b = static_cast<int>(values[1]),
+        .R = static_cast<int>(values[2])};
+}
+
 constexpr auto INPUT_HISTORY_SYNC_DELAY = 5;
 
-PSUManager::PSUManager(sdbusplus::bus::bus& bus, const sdeventplus::Event& e) :
-    bus(bus), powerSystemInputs(bus, powerSystemsInputsObjPath),
+PSUManager::PSUManager(sdbusplus::bus::bus& bus, const sdeventplus::Event& e,
+                       std::chrono::milliseconds fastPollInterval,
+                       std::chrono::milliseconds slowPollInterval) :
+    bus(bus),
+    event(e), fastPollInterval(fastPollInterval),
+    slowPollInterval(slowPollInterval), pollInterval(slowPollInterval),
+    powerSystemInputs(bus, powerSystemsInputsObjPath),
     objectManager(bus, objectManagerObjPath),
     historyManager(bus, "/org/open_power/sensors")
 {
@@ -50,19 +103,17 @@ PSUManager::PSUManager(sdbusplus::bus::bus& bus, const sdeventplus::Event& e) :
         std::bind(&PSUManager::entityManagerIfaceAdded, this,
                   std::placeholders::_1));
     getPSUConfiguration();
-    getSystemProperties();
 
     // Request the bus name before the analyze() function, which is the one that
     // determines the brownout condition and sets the status d-bus property.
     bus.request_name(managerBusName);
 
     using namespace sdeventplus;
-    auto interval = std::chrono::milliseconds(1000);
     timer = std::make_unique<utility::Timer<ClockId::Monotonic>>(
-        e, std::bind(&PSUManager::analyze, this), interval);
+        e, std::bind(&PSUManager::analyze, this), pollInterval);
 
     validationTimer = std::make_unique<utility::Timer<ClockId::Monotonic>>(
-        e, std::bind(&PSUManager::validateConfig, this));
+        e, std::bind(&PSUManager::validateConfig, this, true));
 
     try
     {
@@ -82,6 +133,12 @@ PSUManager::PSUManager(sdbusplus::bus::bus& bus, const sdeventplus::Event& e) :
                                                         POWER_IFACE),
         [this](auto& msg) { this->powerStateChanged(msg); });
 
+    // Resend the inventory properties if the inventory manager restarts
+    inventoryOwnerMatch = std::make_unique<sdbusplus::bus::match_t>(
+        bus,
+        sdbusplus::bus::match::rules::nameOwnerChanged(INVENTORY_MGR_IFACE),
+        [this](auto& msg) { this->inventoryOwnerChanged(msg); });
+
     initialize();
 }
 
@@ -107,7 +164,7 @@ void PSUManager::initialize()
             powerOn = true;
             // In the power fault window if pgood is off
             powerFaultOccurring = !pgood;
-            validationTimer->restartOnce(validationTimeout);
+            validateConfig();
         }
         else
         {
@@ -144,36 +201,197 @@ void PSUManager::initialize()
 void PSUManager::getPSUConfiguration()
 {
     using namespace phosphor::power::util;
-    auto depth = 0;
-    auto objects = getSubTree(bus, "/", IBMCFFPSInterface, depth);
 
-    psus.clear();
+    // The object managers are found with the objects, so their services can
+    // be asked for all of their objects.
+    auto method = bus.new_method_call(MAPPER_BUSNAME, MAPPER_PATH,
+                                      MAPPER_INTERFACE, "GetSubTree");
+    method.append("/");
+    method.append(0);
+    method.append(std::vector<std::string>{IBMCFFPSInterface,
+                                           supportedConfIntf,
+                                           objectManagerIntf});
+
+    configurationCalls.clear();
+    configurationCalls.emplace_back(
+        bus.call_async(method, [this](auto&& reply) {
+            this->configurationServicesFound(reply);
+        }));
+}
 
-    // I should get a map of objects back.
-    // Each object will have a path, a service, and an interface.
-    // The interface should match the one passed into this function.
-    for (const auto& [path, services] : objects)
+void PSUManager::configurationServicesFound(
+    sdbusplus::message::message& reply)
+{
+    util::DbusSubtree subtree;
+    try
+    {
+        if (reply.is_method_error())
+        {
+            throw std::runtime_error{"GetSubTree failed"};
+        }
+        reply.read(subtree);
+    }
+    catch (const std::exception& e)
     {
-        auto service = services.begin()->first;
+        // Interface or properties not found. Let the Interfaces Added callback
+        // process the information once the interfaces are added to D-Bus.
+        log<level::INFO>(
+            fmt::format("No power supply configuration: {}", e.what())
+                .c_str());
+        return;
+    }
 
-        if (path.empty() || service.empty())
+    // The mapper returns all of the interfaces of the matching objects, so
+    // only keep the configuration ones.  The other objects only matched as
+    // object managers.
+    std::map<std::string, std::vector<std::string>> managers;
+    std::map<std::string, std::vector<std::pair<std::string, std::string>>>
+        objects;
+    for (const auto& [path, services] : subtree)
+    {
+        for (const auto& [service, interfaces] : services)
         {
-            continue;
+            for (const auto& interface : interfaces)
+            {
+                if (interface == objectManagerIntf)
+                {
+                    managers[service].push_back(path);
+                }
+                else if ((interface == IBMCFFPSInterface) ||
+                         (interface == supportedConfIntf))
+                {
+                    objects[service].emplace_back(path, interface);
+                }
+            }
+        }
+    }
+
+    for (const auto& [service, serviceObjects] : objects)
+    {
+        // The interfaces added signals this relies on come from an object
+        // manager, so it has one. Use the closest one to each object.
+        std::set<std::string> servicePaths;
+        for (const auto& [path, interface] : serviceObjects)
+        {
+            std::string closest;
+            for (const auto& manager : managers[service])
+            {
+                auto prefix = (manager == "/") ? manager : manager + '/';
+                if (((path == manager) || path.starts_with(prefix)) &&
+                    (manager.size() > closest.size()))
+                {
+                    closest = manager;
+                }
+            }
+            if (!closest.empty())
+            {
+                servicePaths.insert(closest);
+                continue;
+            }
+
+            // No interfaces added signal will come for it either, so read
+            // its properties now.
+            auto method = bus.new_method_call(service.c_str(), path.c_str(),
+                                              util::PROPERTY_INTF, "GetAll");
+            method.append(interface);
+            configurationCalls.emplace_back(bus.call_async(
+                method, [this, interface = interface](auto&& reply) {
+                    this->configurationPropertiesFound(reply, interface);
+                }));
         }
 
-        // For each object in the array of objects, I want to get properties
-        // from the service, path, and interface.
-        auto properties =
-            getAllProperties(bus, path, IBMCFFPSInterface, service);
+        for (const auto& manager : servicePaths)
+        {
+            auto method = bus.new_method_call(service.c_str(), manager.c_str(),
+                                              objectManagerIntf,
+                                              "GetManagedObjects");
+            configurationCalls.emplace_back(
+                bus.call_async(method, [this](auto&& reply) {
+                    this->configurationObjectsFound(reply);
+                }));
+        }
+    }
+}
 
-        getPSUProperties(properties);
+void PSUManager::configurationObjectsFound(sdbusplus::message::message& reply)
+{
+    ManagedObjects objects;
+    try
+    {
+        if (reply.is_method_error())
+        {
+            throw std::runtime_error{"GetManagedObjects failed"};
+        }
+        reply.read(objects);
+    }
+    catch (const std::exception& e)
+    {
+        log<level::INFO>(
+            fmt::format("No power supply configuration: {}", e.what())
+                .c_str());
+        return;
     }
 
-    if (psus.empty())
+    for (auto& [path, interfaces] : objects)
     {
-        // Interface or properties not found. Let the Interfaces Added callback
-        // process the information once the interfaces are added to D-Bus.
-        log<level::INFO>(fmt::format("No power supplies to monitor").c_str());
+        addConfiguration(interfaces);
+    }
+
+    configurationAdded();
+    setPowerConfigGPIO();
+}
+
+void PSUManager::configurationPropertiesFound(
+    sdbusplus::message::message& reply, const std::string& interface)
+{
+    std::map<std::string, util::DbusPropertyMap> interfaces;
+    try
+    {
+        if (reply.is_method_error())
+        {
+            throw std::runtime_error{"GetAll failed"};
+        }
+        reply.read(interfaces[interface]);
+    }
+    catch (const std::exception& e)
+    {
+        log<level::INFO>(
+            fmt::format("No power supply configuration: {}", e.what())
+                .c_str());
+        return;
+    }
+
+    addConfiguration(interfaces);
+    configurationAdded();
+    setPowerConfigGPIO();
+}
+
+void PSUManager::addConfiguration(
+    std::map<std::string, util::DbusPropertyMap>& interfaces)
+{
+    auto itIntf = interfaces.find(supportedConfIntf);
+    if (itIntf != interfaces.end())
+    {
+        populateSysProperties(itIntf->second);
+    }
+
+    itIntf = interfaces.find(IBMCFFPSInterface);
+    if (itIntf != interfaces.end())
+    {
+        getPSUProperties(itIntf->second);
+    }
+}
+
+void PSUManager::configurationAdded()
+{
+    updateMissingPSUs();
+
+    // Call to validate the psu configuration if the power is on and both
+    // the IBMCFFPSConnector and SupportedConfiguration interfaces have been
+    // processed
+    if (powerOn && !psus.empty() && !supportedConfigs.empty())
+    {
+        validateConfig();
     }
 }
 
@@ -249,8 +467,43 @@ void PSUManager::getPSUProperties(util::DbusPropertyMap& properties)
                 "make PowerSupply bus: {} addr: {} driver: {} presline: {}",
                 *i2cbus, *i2caddr, driver, presline)
                 .c_str());
-        auto psu = std::make_unique<PowerSupply>(bus, invpath, *i2cbus,
-                                                 *i2caddr, driver, presline);
+        auto psu = std::make_unique<PowerSupply>(
+            bus, invpath, *i2cbus, *i2caddr, driver, presline,
+            INPUT_HISTORY_DIR);
+        // Handle presence GPIO changes as soon as they occur.
+        psu->monitorPresenceEvents(event);
+        // Analyze this power supply as soon as an input alarm changes.
+        psu->monitorAlarmEvents(event, [this](PowerSupply& changedPSU) {
+            this->alarmChanged(changedPSU);
+        });
+        // Faults are counted in time, not in calls to analyze().  Allow one
+        // fast interval of timer jitter, the same as for the telemetry, so a
+        // slow poll that runs a little early still updates the counts.
+        psu->setDeglitchInterval(
+            std::max(DEGLITCH_INTERVAL - fastPollInterval,
+                     std::chrono::milliseconds{0}));
+        psu->setHistoryRefreshInterval(historyRefreshInterval);
+        // The history and energy do not need the fast poll rate.  Allow one
+        // fast interval of timer jitter so every slow poll still reads them.
+        psu->setTelemetryReadInterval(slowPollInterval - fastPollInterval);
+        for (const auto& [prop, file] : energyCoefficientProps)
+        {
+            auto it = properties.find(prop);
+            if (it == properties.end())
+            {
+                continue;
+            }
+            auto coefficients = getCoefficients(it->second);
+            if (coefficients)
+            {
+                psu->setEnergyCoefficients(file, *coefficients);
+            }
+            else
+            {
+                log<level::ERR>(
+                    fmt::format("Invalid {} of {}", prop, *psuname).c_str());
+            }
+        }
         psus.emplace_back(std::move(psu));
 
         // Subscribe to power supply presence changes
@@ -334,37 +587,6 @@ void PSUManager::populateSysProperties(const util::DbusPropertyMap& properties)
     {}
 }
 
-void PSUManager::getSystemProperties()
-{
-
-    try
-    {
-        util::DbusSubtree subtree =
-            util::getSubTree(bus, INVENTORY_OBJ_PATH, supportedConfIntf, 0);
-        if (subtree.empty())
-        {
-            throw std::runtime_error("Supported Configuration Not Found");
-        }
-
-        for (const auto& [objPath, services] : subtree)
-        {
-            std::string service = services.begin()->first;
-            if (objPath.empty() || service.empty())
-            {
-                continue;
-            }
-            auto properties = util::getAllProperties(
-                bus, objPath, supportedConfIntf, service);
-            populateSysProperties(properties);
-        }
-    }
-    catch (const std::exception& e)
-    {
-        // Interface or property not found. Let the Interfaces Added callback
-        // process the information once the interfaces are added to D-Bus.
-    }
-}
-
 void PSUManager::entityManagerIfaceAdded(sdbusplus::message::message& msg)
 {
     try
@@ -374,30 +596,14 @@ void PSUManager::entityManagerIfaceAdded(sdbusplus::message::message& msg)
             interfaces;
         msg.read(objPath, interfaces);
 
-        auto itIntf = interfaces.find(supportedConfIntf);
-        if (itIntf != interfaces.cend())
-        {
-            populateSysProperties(itIntf->second);
-        }
-
-        itIntf = interfaces.find(IBMCFFPSInterface);
-        if (itIntf != interfaces.cend())
+        if (interfaces.contains(IBMCFFPSInterface))
         {
             log<level::INFO>(
                 fmt::format("InterfacesAdded for: {}", IBMCFFPSInterface)
                     .c_str());
-            getPSUProperties(itIntf->second);
-        }
-
-        updateMissingPSUs();
-
-        // Call to validate the psu configuration if the power is on and both
-        // the IBMCFFPSConnector and SupportedConfiguration interfaces have been
-        // processed
-        if (powerOn && !psus.empty() && !supportedConfigs.empty())
-        {
-            validationTimer->restartOnce(validationTimeout);
         }
+        addConfiguration(interfaces);
+        configurationAdded();
     }
     catch (const std::exception& e)
     {
@@ -405,6 +611,21 @@ void PSUManager::entityManagerIfaceAdded(sdbusplus::message::message& msg)
     }
 }
 
+void PSUManager::inventoryOwnerChanged(sdbusplus::message::message& msg)
+{
+    std::string name;
+    std::string oldOwner;
+    std::string newOwner;
+    msg.read(name, oldOwner, newOwner);
+
+    if (!newOwner.empty())
+    {
+        log<level::INFO>("Inventory manager started, resending inventory");
+        getInventoryCache().invalidate();
+        getInventoryCache().retryPending(bus);
+    }
+}
+
 void PSUManager::powerStateChanged(sdbusplus::message::message& msg)
 {
     std::string msgSensor;
@@ -415,14 +636,15 @@ void PSUManager::powerStateChanged(sdbusplus::message::message& msg)
     auto valPropMap = msgData.find("state");
     if (valPropMap != msgData.end())
     {
+        startFastPolling();
         int state = std::get<int>(valPropMap->second);
         if (state)
         {
             // Power on requested
             powerOn = true;
             powerFaultOccurring = false;
-            validationTimer->restartOnce(validationTimeout);
             clearFaults();
+            validateConfig();
             syncHistory();
             setPowerConfigGPIO();
         }
@@ -439,6 +661,7 @@ void PSUManager::powerStateChanged(sdbusplus::message::message& msg)
     valPropMap = msgData.find("pgood");
     if (valPropMap != msgData.end())
     {
+        startFastPolling();
         int pgood = std::get<int>(valPropMap->second);
         if (!pgood)
         {
@@ -467,11 +690,12 @@ void PSUManager::presenceChanged(sdbusplus::message::message& msg)
     auto valPropMap = msgData.find(PRESENT_PROP);
     if (valPropMap != msgData.end())
     {
+        startFastPolling();
         if (std::get<bool>(valPropMap->second))
         {
             // A PSU became present, force the PSU validation to run.
             runValidateConfig = true;
-            validationTimer->restartOnce(validationTimeout);
+            validateConfig();
         }
     }
 }
@@ -484,6 +708,11 @@ void PSUManager::setPowerSupplyError(const std::string& psuErrorString)
     constexpr auto interface = "org.openbmc.control.Power";
     constexpr auto method = "setPowerSupplyError";
 
+    if (lastPowerSupplyError == psuErrorString)
+    {
+        return;
+    }
+
     try
     {
         // Call D-Bus method to inform pseq of PSU error
@@ -491,9 +720,11 @@ void PSUManager::setPowerSupplyError(const std::string& psuErrorString)
             bus.new_method_call(service, objPath, interface, method);
         methodMsg.append(psuErrorString);
         auto callReply = bus.call(methodMsg);
+        lastPowerSupplyError = psuErrorString;
     }
     catch (const std::exception& e)
     {
+        lastPowerSupplyError.reset();
         log<level::INFO>(
             fmt::format("Failed calling setPowerSupplyError due to error {}",
                         e.what())
@@ -564,6 +795,9 @@ void PSUManager::syncHistory()
 
 void PSUManager::analyze()
 {
+    // Resend any inventory updates that failed earlier
+    getInventoryCache().retryPending(bus);
+
     auto syncHistoryRequired =
         std::any_of(psus.begin(), psus.end(), [](const auto& psu) {
             return psu->isSyncHistoryRequired();
@@ -573,39 +807,16 @@ void PSUManager::analyze()
         syncHistory();
     }
 
-    for (auto& psu : psus)
+    analyzePowerSupplies();
+
+    if (telemetry)
     {
-        psu->analyze();
+        publishTelemetry();
     }
 
-    std::map<std::string, std::string> additionalData;
-
-    auto notPresentCount = decltype(psus.size())(
-        std::count_if(psus.begin(), psus.end(),
-                      [](const auto& psu) { return !psu->isPresent(); }));
-
-    auto hasVINUVFaultCount = decltype(psus.size())(
-        std::count_if(psus.begin(), psus.end(), [](const auto& psu) {
-            return (psu->isPresent() && psu->hasVINUVFault());
-        }));
+    analyzeBrownout();
 
-    // The PSU D-Bus objects may not be available yet, so ignore if all
-    // PSUs are not present or the number of PSUs is still 0.
-    if ((psus.size() == (notPresentCount + hasVINUVFaultCount)) &&
-        (psus.size() != notPresentCount) && (psus.size() != 0))
-    {
-        // Brownout: All PSUs report an AC failure: At least one PSU reports
-        // AC loss VIN fault and the rest either report AC loss VIN fault as
-        // well or are not present.
-        additionalData["NOT_PRESENT_COUNT"] = std::to_string(notPresentCount);
-        additionalData["VIN_FAULT_COUNT"] = std::to_string(hasVINUVFaultCount);
-        setBrownout(additionalData);
-    }
-    else
-    {
-        // Brownout condition is not present or has been cleared
-        clearBrownout();
-    }
+    std::map<std::string, std::string> additionalData;
 
     if (powerOn)
     {
@@ -798,6 +1009,204 @@ void PSUManager::analyze()
             }
         }
     }
+
+    updatePollInterval();
+}
+
+void PSUManager::enableTelemetry(const std::string& socketPath)
+{
+    try
+    {
+        telemetry = std::make_unique<TelemetryServer>(event, socketPath);
+        log<level::INFO>(
+            fmt::format("Streaming telemetry on {}", socketPath).c_str());
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>(
+            fmt::format("Unable to enable telemetry: {}", e.what()).c_str());
+    }
+}
+
+void PSUManager::setHistoryRefreshInterval(std::chrono::seconds interval)
+{
+    historyRefreshInterval = interval;
+    for (auto& psu : psus)
+    {
+        psu->setHistoryRefreshInterval(interval);
+    }
+}
+
+void PSUManager::publishTelemetry()
+{
+    using namespace std::chrono;
+    uint64_t timestamp =
+        duration_cast<microseconds>(system_clock::now().time_since_epoch())
+            .count();
+    telemetrySequence++;
+
+    telemetryFrames.clear();
+    for (size_t i = 0; i < psus.size(); i++)
+    {
+        const auto& psu = psus[i];
+        TelemetryFrame frame{};
+        frame.timestamp = timestamp;
+        frame.sequence = telemetrySequence;
+        frame.psuIndex = i;
+        frame.statusWord = psu->getStatusWord();
+        frame.statusInput = psu->getStatusInput();
+        frame.statusMFR = psu->getMFRFault();
+        frame.statusCML = psu->getStatusCML();
+        frame.statusVout = psu->getStatusVout();
+        frame.statusIout = psu->getStatusIout();
+        frame.statusFans12 = psu->getStatusFans12();
+        frame.statusTemperature = psu->getStatusTemperature();
+        frame.inputVoltage = psu->getActualInputVoltage();
+
+        if (psu->isPresent())
+        {
+            frame.flags |= TelemetryServer::flagPresent;
+        }
+        if (psu->isFaulted())
+        {
+            frame.flags |= TelemetryServer::flagFaulted;
+        }
+
+        const auto& history = psu->getInputHistoryData();
+        if (history.size() == sizeof(frame.inputHistory))
+        {
+            std::copy(history.begin(), history.end(), frame.inputHistory);
+            frame.flags |= TelemetryServer::flagHistoryValid;
+        }
+
+        telemetryFrames.push_back(frame);
+    }
+
+    telemetry->publish(telemetryFrames);
+}
+
+void PSUManager::analyzePowerSupplies()
+{
+    // Presence changes update D-Bus, so they are handled on this thread.
+    for (auto& psu : psus)
+    {
+        psu->pollPresence();
+    }
+
+    // Group the power supplies by I2C bus. The power supplies on each bus are
+    // read in turn, while different buses are read in parallel.
+    std::map<std::uint8_t, std::vector<PowerSupply*>> busPSUs;
+    for (auto& psu : psus)
+    {
+        busPSUs[psu->getI2CBus()].push_back(psu.get());
+    }
+
+    if (busPSUs.size() > 1)
+    {
+        auto threadCount = std::min(busPSUs.size(), maxWorkerThreads);
+        if (!workerPool || (workerPool->size() < threadCount))
+        {
+            workerPool = std::make_unique<WorkerPool>(threadCount);
+        }
+
+        // Each task only accesses the power supplies on its own bus.
+        std::vector<WorkerPool::Task> tasks;
+        for (auto& [i2cBus, busPSUList] : busPSUs)
+        {
+            tasks.emplace_back([&busPSUList = busPSUList]() {
+                for (auto psu : busPSUList)
+                {
+                    psu->readStatus();
+                }
+            });
+        }
+        workerPool->run(tasks);
+    }
+    else
+    {
+        for (auto& psu : psus)
+        {
+            psu->readStatus();
+        }
+    }
+
+    // Fault analysis, error logging, and D-Bus updates stay on this thread.
+    for (auto& psu : psus)
+    {
+        psu->analyzeStatus();
+    }
+}
+
+void PSUManager::analyzeBrownout()
+{
+    std::map<std::string, std::string> additionalData;
+
+    auto notPresentCount = decltype(psus.size())(
+        std::count_if(psus.begin(), psus.end(),
+                      [](const auto& psu) { return !psu->isPresent(); }));
+
+    auto hasVINUVFaultCount = decltype(psus.size())(
+        std::count_if(psus.begin(), psus.end(), [](const auto& psu) {
+            return (psu->isPresent() && psu->hasVINUVFault());
+        }));
+
+    // The PSU D-Bus objects may not be available yet, so ignore if all
+    // PSUs are not present or the number of PSUs is still 0.
+    if ((psus.size() == (notPresentCount + hasVINUVFaultCount)) &&
+        (psus.size() != notPresentCount) && (psus.size() != 0))
+    {
+        // Brownout: All PSUs report an AC failure: At least one PSU reports
+        // AC loss VIN fault and the rest either report AC loss VIN fault as
+        // well or are not present.
+        additionalData["NOT_PRESENT_COUNT"] = std::to_string(notPresentCount);
+        additionalData["VIN_FAULT_COUNT"] = std::to_string(hasVINUVFaultCount);
+        setBrownout(additionalData);
+    }
+    else
+    {
+        // Brownout condition is not present or has been cleared
+        clearBrownout();
+    }
+}
+
+void PSUManager::alarmChanged(PowerSupply& psu)
+{
+    // Only this power supply changed, so there is no need to read the others.
+    psu.analyze();
+    analyzeBrownout();
+    startFastPolling();
+}
+
+bool PSUManager::isFastPollRequired() const
+{
+    if (powerFaultOccurring ||
+        (std::chrono::steady_clock::now() < fastPollUntil))
+    {
+        return true;
+    }
+
+    return std::any_of(psus.begin(), psus.end(), [](const auto& psu) {
+        return (psu->isPresent() && (psu->getStatusWord() != 0));
+    });
+}
+
+void PSUManager::startFastPolling()
+{
+    fastPollUntil = std::chrono::steady_clock::now() + fastPollHoldTime;
+    updatePollInterval();
+}
+
+void PSUManager::updatePollInterval()
+{
+    auto interval = isFastPollRequired() ? fastPollInterval : slowPollInterval;
+    if (interval != pollInterval)
+    {
+        log<level::DEBUG>(
+            fmt::format("Poll interval changed to {}ms", interval.count())
+                .c_str());
+        pollInterval = interval;
+        timer->restart(pollInterval);
+    }
 }
 
 void PSUManager::updateMissingPSUs()
@@ -871,10 +1280,11 @@ void PSUManager::updateMissingPSUs()
     }
 }
 
-void PSUManager::validateConfig()
+void PSUManager::validateConfig(bool settled)
 {
     if (!runValidateConfig || supportedConfigs.empty() || psus.empty())
     {
+        validationTimer->setEnabled(false);
         return;
     }
 
@@ -882,8 +1292,12 @@ void PSUManager::validateConfig()
     {
         if ((psu->hasInputFault() || psu->hasVINUVFault()))
         {
-            // Do not try to validate if input voltage fault present.
-            validationTimer->restartOnce(validationTimeout);
+            // Do not try to validate if input voltage fault present, try
+            // again at the end of a settle window.
+            if (settled || !validationTimer->isEnabled())
+            {
+                validationTimer->restartOnce(validationSettleTime);
+            }
             return;
         }
     }
@@ -893,6 +1307,19 @@ void PSUManager::validateConfig()
     if (supported)
     {
         runValidateConfig = false;
+        validationTimer->setEnabled(false);
+        return;
+    }
+
+    if (!settled)
+    {
+        // More interfaces or power supplies may still show up. Only log an
+        // error if it is not valid at the end of the settle window, which is
+        // not pushed back by later changes.
+        if (!validationTimer->isEnabled())
+        {
+            validationTimer->restartOnce(validationSettleTime);
+        }
         return;
     }
 
@@ -3,15 +3,20 @@
 #include "power_supply.hpp"
 #include "types.hpp"
 #include "utility.hpp"
+#include "telemetry_server.hpp"
+#include "worker_pool.hpp"
 
 #include <phosphor-logging/log.hpp>
 #include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/server/manager.hpp>
 #include <sdbusplus/server/object.hpp>
+#include <sdbusplus/slot.hpp>
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/utility/timer.hpp>
 #include <xyz/openbmc_project/State/Decorator/PowerSystemInputs/server.hpp>
 
+#include <optional>
+
 struct sys_properties
 {
     int powerSupplyCount;
@@ -30,9 +35,21 @@ using PowerSystemInputsInterface = sdbusplus::xyz::openbmc_project::State::
 using PowerSystemInputsObject =
     sdbusplus::server::object_t<PowerSystemInputsInterface>;
 
-// Validation timeout. Allow 10s to detect if new EM interfaces show up in D-Bus
-// before performing the validation.
-constexpr auto validationTimeout = std::chrono::seconds(10);
+// Validation settle time. The configuration is validated as each EM interface
+// and presence change shows up, but an error is only logged if it is still not
+// valid this long after it first failed. Later changes do not extend it.
+constexpr auto validationSettleTime = std::chrono::seconds(3);
+
+// Intervals for analyzing the power supplies. The fast interval is used while a
+// power supply reports a fault, during a power fault, and for a while after a
+// presence or power state change. Otherwise the slow interval is used.
+constexpr auto defaultFastPollInterval = std::chrono::milliseconds(100);
+constexpr auto defaultSlowPollInterval = std::chrono::milliseconds(1000);
+constexpr auto fastPollHoldTime = std::chrono::seconds(10);
+
+// Maximum number of threads used to read power supplies on different I2C
+// buses in parallel.
+constexpr size_t maxWorkerThreads = 4;
 
 /**
  * @class PowerSystemInputs
@@ -67,8 +84,15 @@ class PSUManager
      *
      * @param[in] bus - D-Bus bus object
      * @param[in] e - event object
+     * @param[in] fastPollInterval - Interval for analyzing the power supplies
+     *                               while a fault or transition is occurring
+     * @param[in] slowPollInterval - Interval for analyzing the power supplies
+     *                               otherwise
      */
-    PSUManager(sdbusplus::bus::bus& bus, const sdeventplus::Event& e);
+    PSUManager(
+        sdbusplus::bus::bus& bus, const sdeventplus::Event& e,
+        std::chrono::milliseconds fastPollInterval = defaultFastPollInterval,
+        std::chrono::milliseconds slowPollInterval = defaultSlowPollInterval);
 
     /**
      * Get PSU properties from D-Bus, use that to build a power supply
@@ -80,16 +104,15 @@ class PSUManager
     void getPSUProperties(util::DbusPropertyMap& properties);
 
     /**
-     * Get PSU configuration from D-Bus
+     * Get the PSU connectors and the supported configurations from D-Bus.
+     *
+     * Asynchronously finds the services that provide them and the object
+     * managers of those services, then gets all of the objects of each
+     * service with one GetManagedObjects call.  The power supply objects and
+     * system properties are created as the replies arrive.
      */
     void getPSUConfiguration();
 
-    /**
-     * @brief Initialize the system properties from the Supported Configuration
-     *        D-Bus object provided by Entity Manager.
-     */
-    void getSystemProperties();
-
     /**
      * Initializes the manager.
      *
@@ -97,6 +120,24 @@ class PSUManager
      */
     void initialize();
 
+    /**
+     * Streams power supply telemetry on a Unix domain socket.
+     *
+     * A frame is sent for each power supply on every analyze pass.  Errors
+     * creating the socket are logged and telemetry stays disabled.
+     *
+     * @param[in] socketPath - The path of the socket
+     */
+    void enableTelemetry(const std::string& socketPath);
+
+    /**
+     * Sets the minimum time between updates of the input history
+     * properties of the power supplies, current and future.
+     *
+     * @param[in] interval - The interval, 0 to update them with every record
+     */
+    void setHistoryRefreshInterval(std::chrono::seconds interval);
+
     /**
      * Starts the timer to start monitoring the list of devices.
      */
@@ -140,6 +181,11 @@ class PSUManager
      */
     sdbusplus::bus::bus& bus;
 
+    /**
+     * The event loop object
+     */
+    sdeventplus::Event event;
+
     /**
      * The timer that runs to periodically check the power supplies.
      */
@@ -148,8 +194,62 @@ class PSUManager
         timer;
 
     /**
-     * The timer that performs power supply validation as the entity manager
-     * interfaces show up in d-bus.
+     * The interval used for the timer while faults or transitions are
+     * occurring.
+     */
+    const std::chrono::milliseconds fastPollInterval;
+
+    /**
+     * The interval used for the timer when nothing is happening.
+     */
+    const std::chrono::milliseconds slowPollInterval;
+
+    /**
+     * The current interval of the timer.
+     */
+    std::chrono::milliseconds pollInterval;
+
+    /**
+     * The fast interval is used until this time after a presence or power
+     * state change.
+     */
+    std::chrono::steady_clock::time_point fastPollUntil{};
+
+    /**
+     * The threads that read power supplies on different I2C buses.
+     *
+     * Created when power supplies are found on more than one bus.
+     */
+    std::unique_ptr<WorkerPool> workerPool;
+
+    /**
+     * Sends the telemetry of all power supplies to the telemetry clients.
+     */
+    void publishTelemetry();
+
+    /**
+     * The telemetry socket server, if telemetry is enabled.
+     */
+    std::unique_ptr<TelemetryServer> telemetry;
+
+    /**
+     * The number of the analyze pass, sent in the telemetry frames.
+     */
+    uint32_t telemetrySequence = 0;
+
+    /**
+     * Reused storage for the telemetry frames of one analyze pass.
+     */
+    std::vector<TelemetryFrame> telemetryFrames;
+
+    /**
+     * The minimum time between updates of the input history properties.
+     */
+    std::chrono::seconds historyRefreshInterval{0};
+
+    /**
+     * The timer that ends the validation settle window, after which a
+     * configuration that is still not valid is logged.
      */
     std::unique_ptr<
         sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
@@ -158,6 +258,9 @@ class PSUManager
     /**
      * Let power control/sequencer application know of PSU error(s).
      *
+     * The method is only called if the string differs from the last one
+     * successfully sent.
+     *
      * @param[in] psuErrorString - string for power supply error
      */
     void setPowerSupplyError(const std::string& psuErrorString);
@@ -178,6 +281,36 @@ class PSUManager
      */
     void analyze();
 
+    /**
+     * @brief Reads and analyzes the status of each of the power supplies.
+     *
+     * The PMBus reads of power supplies on different I2C buses are performed
+     * in parallel by the worker pool. Presence updates, fault analysis, and
+     * D-Bus updates are performed on the main thread.
+     */
+    void analyzePowerSupplies();
+
+    /**
+     * @brief Returns true if the power supplies should be analyzed using the
+     *        fast poll interval.
+     *
+     * True if a present power supply has a non-zero STATUS_WORD, in the power
+     * fault window, or shortly after a presence or power state change.
+     */
+    bool isFastPollRequired() const;
+
+    /**
+     * @brief Uses the fast poll interval for a while.
+     *
+     * Called when a presence or power state change occurs.
+     */
+    void startFastPolling();
+
+    /**
+     * @brief Restarts the timer if the required poll interval has changed.
+     */
+    void updatePollInterval();
+
     /** @brief True if the power is on. */
     bool powerOn = false;
 
@@ -188,6 +321,10 @@ class PSUManager
     /** @brief True if an error for a brownout has already been logged. */
     bool brownoutLogged = false;
 
+    /** @brief The power supply error string last sent to the power
+     *         control/sequencer application, if the last call succeeded. */
+    std::optional<std::string> lastPowerSupplyError;
+
     /** @brief Used as part of subscribing to power on state changes*/
     std::string powerService;
 
@@ -197,9 +334,15 @@ class PSUManager
     /** @brief Used to subscribe to D-Bus power supply presence changes */
     std::vector<std::unique_ptr<sdbusplus::bus::match_t>> presenceMatches;
 
+    /** @brief Used to subscribe to inventory manager restarts */
+    std::unique_ptr<sdbusplus::bus::match_t> inventoryOwnerMatch;
+
     /** @brief Used to subscribe to Entity Manager interfaces added */
     std::unique_ptr<sdbusplus::bus::match_t> entityManagerIfacesAddedMatch;
 
+    /** @brief The pending asynchronous calls of getPSUConfiguration() */
+    std::vector<sdbusplus::slot::slot> configurationCalls;
+
     /**
      * @brief Callback for power state property changes
      *
@@ -209,6 +352,16 @@ class PSUManager
      */
     void powerStateChanged(sdbusplus::message::message& msg);
 
+    /**
+     * @brief Callback for inventory manager name owner changes
+     *
+     * A new inventory manager does not have the properties sent to the old
+     * one, so the inventory cache is invalidated to send them all again.
+     *
+     * @param[in] msg - Data associated with the NameOwnerChanged signal
+     */
+    void inventoryOwnerChanged(sdbusplus::message::message& msg);
+
     /**
      * @brief Callback for inventory property changes
      *
@@ -228,6 +381,49 @@ class PSUManager
      */
     void entityManagerIfaceAdded(sdbusplus::message::message& msg);
 
+    /**
+     * @brief Callback for the mapper reply of getPSUConfiguration()
+     *
+     * Gets the managed objects of each service that has a supported
+     * configuration or IBM CFFPS Connector object, from the object manager
+     * closest to those objects.  The properties of an object without an
+     * object manager are read on their own.
+     *
+     * @param[in] reply - The GetSubTree reply
+     */
+    void configurationServicesFound(sdbusplus::message::message& reply);
+
+    /**
+     * @brief Callback for a GetAll reply of getPSUConfiguration()
+     *
+     * @param[in] reply - The GetAll reply
+     * @param[in] interface - The interface the properties are of
+     */
+    void configurationPropertiesFound(sdbusplus::message::message& reply,
+                                      const std::string& interface);
+
+    /**
+     * @brief Callback for a GetManagedObjects reply of getPSUConfiguration()
+     *
+     * @param[in] reply - The GetManagedObjects reply
+     */
+    void configurationObjectsFound(sdbusplus::message::message& reply);
+
+    /**
+     * @brief Processes the supported configuration and IBM CFFPS Connector
+     * interfaces of an object.
+     *
+     * @param[in] interfaces - The interfaces and properties of the object
+     */
+    void addConfiguration(
+        std::map<std::string, util::DbusPropertyMap>& interfaces);
+
+    /**
+     * @brief Acts on new configuration: updates the missing power supplies
+     * and validates the configuration if the power is on.
+     */
+    void configurationAdded();
+
     /**
      * @brief Adds properties to the inventory.
      *
@@ -260,9 +456,15 @@ class PSUManager
     /**
      * @brief Perform power supply configuration validation.
      * @details Validates if the existing power supply properties are a
-     * supported configuration, and acts on its findings such as logging errors.
+     * supported configuration. Called each time an entity manager interface
+     * or a power supply shows up, so a valid configuration is found right
+     * away. If it is not valid, the validation settle window is started, if
+     * it is not already running, and the error is logged when it ends.
+     *
+     * @param[in] settled - True when the validation settle window ended, to
+     *            log an error if the configuration is still not valid.
      */
-    void validateConfig();
+    void validateConfig(bool settled = false);
 
     /**
      * @brief Flag to indicate if the validateConfig() function should be run.
@@ -331,6 +533,22 @@ class PSUManager
      */
     void clearBrownout();
 
+    /**
+     * @brief Sets or clears the brownout condition based on the VIN_UV
+     * faults of the present power supplies.
+     */
+    void analyzeBrownout();
+
+    /**
+     * @brief Callback for a power supply input alarm attribute change.
+     *
+     * Analyzes only that power supply and checks for a brownout right away,
+     * instead of waiting for the next poll. Then polls fast for a while.
+     *
+     * @param[in] psu - The power supply whose alarm changed
+     */
+    void alarmChanged(PowerSupply& psu);
+
     /**
      * @brief Map of supported PSU configurations that include the model name
      * and their properties.
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace phosphor::power::psu
+{
+
+/**
+ * @brief The faults decoded from the PMBus status registers.
+ *
+ * The values index the fault counts and the bits of a StatusFaults value.
+ */
+enum class StatusFault : uint8_t
+{
+    cml,
+    input,
+    voutOV,
+    ioutOC,
+    voutUV,
+    fan,
+    temperature,
+    pgood,
+    mfr,
+    vinUV,
+    psKill,
+    ps12Vcs,
+    psCS12V,
+    count
+};
+
+constexpr size_t statusFaultCount = static_cast<size_t>(StatusFault::count);
+
+/** @brief One bit per StatusFault */
+using StatusFaults = uint32_t;
+
+static_assert(statusFaultCount <= sizeof(StatusFaults) * 8);
+
+/**
+ * @brief Returns the StatusFaults bit of a fault.
+ */
+constexpr StatusFaults faultBit(StatusFault fault)
+{
+    return StatusFaults{1} << static_cast<size_t>(fault);
+}
+
+/**
+ * @brief The PMBus status registers a fault descriptor can refer to.
+ */
+enum class StatusRegister : uint8_t
+{
+    none,
+    input,
+    mfr,
+    cml,
+    vout,
+    iout,
+    fans12,
+    temperature
+};
+
+/**
+ * @brief Returns the PMBus command name of a status register, for traces.
+ */
+constexpr const char* registerName(StatusRegister reg)
+{
+    switch (reg)
+    {
+        case StatusRegister::input:
+            return "STATUS_INPUT";
+        case StatusRegister::mfr:
+            return "STATUS_MFR_SPECIFIC";
+        case StatusRegister::cml:
+            return "STATUS_CML";
+        case StatusRegister::vout:
+            return "STATUS_VOUT";
+        case StatusRegister::iout:
+            return "STATUS_IOUT";
+        case StatusRegister::fans12:
+            return "STATUS_FANS_1_2";
+        case StatusRegister::temperature:
+            return "STATUS_TEMPERATURE";
+        case StatusRegister::none:
+            break;
+    }
+    return "";
+}
+
+/**
+ * @brief The values read from the PMBus status registers.
+ */
+struct StatusRegisters
+{
+    uint64_t word = 0;
+    uint64_t input = 0;
+    uint64_t mfr = 0;
+    uint64_t cml = 0;
+    uint64_t vout = 0;
+    uint64_t iout = 0;
+    uint64_t fans12 = 0;
+    uint64_t temperature = 0;
+
+    /**
+     * @brief Returns the value of a status register, 0 for none.
+     */
+    constexpr uint64_t get(StatusRegister reg) const
+    {
+        switch (reg)
+        {
+            case StatusRegister::input:
+                return input;
+            case StatusRegister::mfr:
+                return mfr;
+            case StatusRegister::cml:
+                return cml;
+            case StatusRegister::vout:
+                return vout;
+            case StatusRegister::iout:
+                return iout;
+            case StatusRegister::fans12:
+                return fans12;
+            case StatusRegister::temperature:
+                return temperature;
+            case StatusRegister::none:
+                break;
+        }
+        return 0;
+    }
+};
+
+/**
+ * @brief How a fault affects the power supply state.
+ */
+enum class FaultSeverity : uint8_t
+{
+    /** @brief The power supply is faulted, see PowerSupply::isFaulted() */
+    fault,
+
+    /** @brief Part of PowerSupply::hasCommFault() */
+    communication,
+
+    /** @brief Only refines another fault */
+    detail
+};
+
+/**
+ * @brief Describes how one fault is decoded from the status registers.
+ *
+ * The fault is on when:
+ *  - all bits of requiredWordMask are on in STATUS_WORD, and
+ *  - any bit of wordMask is on in STATUS_WORD (if wordMask is not 0), and
+ *  - no bit of excludeWordMask is on in STATUS_WORD, and
+ *  - any bit of regMask is on in reg (if reg is not none).
+ *
+ * If the requiredWordMask bits are not all on, the fault is not evaluated and
+ * its count is kept.
+ */
+struct StatusFaultDescriptor
+{
+    StatusFault fault;
+    uint16_t wordMask = 0;
+    uint16_t excludeWordMask = 0;
+    uint16_t requiredWordMask = 0;
+    StatusRegister reg = StatusRegister::none;
+    uint8_t regMask = 0;
+    FaultSeverity severity = FaultSeverity::fault;
+
+    /** @brief The count at which the fault is considered present */
+    size_t deglitchLimit = 1;
+
+    /** @brief Fault name in traces, nullptr to not trace the fault */
+    const char* text = nullptr;
+
+    /** @brief Register added to the trace after STATUS_MFR_SPECIFIC */
+    StatusRegister traceReg = StatusRegister::none;
+
+    /** @brief Whether to trace when the fault goes away */
+    bool traceClear = false;
+};
+
+/**
+ * @brief The result of decoding the status registers.
+ */
+struct DecodedStatus
+{
+    /** @brief The faults that are on */
+    StatusFaults active = 0;
+
+    /** @brief The faults that were not evaluated */
+    StatusFaults held = 0;
+};
+
+/**
+ * @brief Decodes the status registers against a descriptor table.
+ *
+ * The result is accumulated into decoded, so several tables can be decoded
+ * into the same result.
+ *
+ * @param[in] table - The fault descriptors
+ * @param[in] regs - The status register values
+ * @param[in,out] decoded - The decoded faults
+ */
+constexpr void decodeStatus(std::span<const StatusFaultDescriptor> table,
+                            const StatusRegisters& regs,
+                            DecodedStatus& decoded)
+{
+    for (const auto& desc : table)
+    {
+        auto bit = faultBit(desc.fault);
+        if ((regs.word & desc.requiredWordMask) != desc.requiredWordMask)
+        {
+            decoded.held |= bit;
+            continue;
+        }
+
+        if (((desc.wordMask == 0) || (regs.word & desc.wordMask)) &&
+            !(regs.word & desc.excludeWordMask) &&
+            ((desc.reg == StatusRegister::none) ||
+             (regs.get(desc.reg) & desc.regMask)))
+        {
+            decoded.active |= bit;
+        }
+    }
+}
+
+/**
+ * @brief Returns the faults of a table that have the given severity.
+ *
+ * @param[in] table - The fault descriptors
+ * @param[in] severity - The severity
+ */
+constexpr StatusFaults faultsWithSeverity(
+    std::span<const StatusFaultDescriptor> table, FaultSeverity severity)
+{
+    StatusFaults faults = 0;
+    for (const auto& desc : table)
+    {
+        if (desc.severity == severity)
+        {
+            faults |= faultBit(desc.fault);
+        }
+    }
+    return faults;
+}
+
+} // namespace phosphor::power::psu
@@ -0,0 +1,204 @@
+#include "telemetry_server.hpp"
+
+#include <fmt/format.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <phosphor-logging/log.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace phosphor::power::manager
+{
+
+using namespace phosphor::logging;
+
+TelemetryServer::TelemetryServer(const sdeventplus::Event& event,
+                                 const std::string& path) :
+    event(event),
+    path(path)
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || (path.size() >= sizeof(addr.sun_path)))
+    {
+        throw std::runtime_error{"Invalid telemetry socket path: " + path};
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    listenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                      0);
+    if (listenFd < 0)
+    {
+        throw std::runtime_error{fmt::format(
+            "Unable to create telemetry socket: {}", strerror(errno))};
+    }
+
+    unlink(path.c_str());
+    if ((bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) !=
+         0) ||
+        (listen(listenFd, maxClients) != 0))
+    {
+        auto error = errno;
+        close(listenFd);
+        throw std::runtime_error{fmt::format("Unable to listen on {}: {}",
+                                             path, strerror(error))};
+    }
+
+    listenSource = std::make_unique<sdeventplus::source::IO>(
+        event, listenFd, EPOLLIN,
+        [this](sdeventplus::source::IO&, int, uint32_t) { acceptClient(); });
+}
+
+TelemetryServer::~TelemetryServer()
+{
+    for (auto& client : clients)
+    {
+        client->source.reset();
+        close(client->fd);
+    }
+    listenSource.reset();
+    close(listenFd);
+    unlink(path.c_str());
+}
+
+void TelemetryServer::publish(const std::vector<TelemetryFrame>& frames)
+{
+    removeClosedClients();
+
+    for (auto& client : clients)
+    {
+        for (const auto& frame : frames)
+        {
+            // Drop the oldest frame when a client falls behind
+            if (client->queue.size() >= maxQueuedFrames)
+            {
+                client->queue.pop_front();
+                client->dropped++;
+            }
+            client->queue.push_back(frame);
+            auto& queued = client->queue.back();
+            queued.magic = frameMagic;
+            queued.version = frameVersion;
+            queued.size = sizeof(TelemetryFrame);
+        }
+
+        flush(*client);
+    }
+}
+
+size_t TelemetryServer::getNumClients() const
+{
+    return std::count_if(clients.begin(), clients.end(),
+                         [](const auto& client) { return !client->closed; });
+}
+
+void TelemetryServer::acceptClient()
+{
+    removeClosedClients();
+
+    int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    if (clients.size() >= maxClients)
+    {
+        log<level::INFO>("Too many telemetry clients, closing connection");
+        close(fd);
+        return;
+    }
+
+    auto client = std::make_unique<Client>();
+    client->fd = fd;
+    auto* clientPtr = client.get();
+    client->source = std::make_unique<sdeventplus::source::IO>(
+        event, fd, EPOLLIN,
+        [this, clientPtr](sdeventplus::source::IO&, int, uint32_t revents) {
+            clientEvent(*clientPtr, revents);
+        });
+    clients.push_back(std::move(client));
+}
+
+void TelemetryServer::clientEvent(Client& client, uint32_t revents)
+{
+    if (revents & EPOLLIN)
+    {
+        // Clients do not send anything, so this is the connection closing
+        char data[64];
+        auto rc = recv(client.fd, data, sizeof(data), MSG_DONTWAIT);
+        if ((rc == 0) || ((rc < 0) && (errno != EAGAIN)))
+        {
+            client.closed = true;
+        }
+    }
+
+    if (revents & (EPOLLHUP | EPOLLERR))
+    {
+        client.closed = true;
+    }
+
+    if (client.closed)
+    {
+        // Removed on the next publish or connection, outside the callback
+        client.source->set_enabled(sdeventplus::source::Enabled::Off);
+        client.queue.clear();
+        return;
+    }
+
+    if (revents & EPOLLOUT)
+    {
+        flush(client);
+    }
+}
+
+void TelemetryServer::flush(Client& client)
+{
+    while (!client.closed && !client.queue.empty())
+    {
+        auto& frame = client.queue.front();
+        frame.dropped = client.dropped;
+
+        auto rc = send(client.fd, &frame, sizeof(frame),
+                       MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (rc < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                break;
+            }
+            client.closed = true;
+            client.source->set_enabled(sdeventplus::source::Enabled::Off);
+            client.queue.clear();
+            return;
+        }
+
+        client.dropped = 0;
+        client.queue.pop_front();
+    }
+
+    // Only wait for the connection to become writable while frames remain
+    client.source->set_events(client.queue.empty() ? EPOLLIN
+                                                   : (EPOLLIN | EPOLLOUT));
+}
+
+void TelemetryServer::removeClosedClients()
+{
+    auto it = std::stable_partition(
+        clients.begin(), clients.end(),
+        [](const auto& client) { return !client->closed; });
+    for (auto closed = it; closed != clients.end(); ++closed)
+    {
+        (*closed)->source.reset();
+        close((*closed)->fd);
+    }
+    clients.erase(it, clients.end());
+}
+
+} // namespace phosphor::power::manager
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace phosphor::power::manager
+{
+
+/**
+ * @brief Telemetry of one power supply, as sent to the clients of the
+ *        telemetry socket.
+ *
+ * The layout is fixed and has no padding.  All values are in host byte
+ * order.
+ */
+struct TelemetryFrame
+{
+    /** @brief TelemetryServer::frameMagic */
+    uint32_t magic;
+
+    /** @brief TelemetryServer::frameVersion */
+    uint16_t version;
+
+    /** @brief The size of the frame, in bytes */
+    uint16_t size;
+
+    /** @brief The time of the analyze pass, in microseconds since the
+     *         epoch */
+    uint64_t timestamp;
+
+    /** @brief The number of the analyze pass */
+    uint32_t sequence;
+
+    /** @brief The number of frames dropped for this client since the
+     *         previous frame it received */
+    uint32_t dropped;
+
+    /** @brief STATUS_WORD */
+    uint16_t statusWord;
+
+    /** @brief The index of the power supply in the configuration */
+    uint8_t psuIndex;
+
+    /** @brief TelemetryServer::flagPresent, flagFaulted, and
+     *         flagHistoryValid */
+    uint8_t flags;
+
+    /** @brief STATUS_INPUT, STATUS_MFR_SPECIFIC, STATUS_CML, STATUS_VOUT,
+     *         STATUS_IOUT, STATUS_FANS_1_2, and STATUS_TEMPERATURE */
+    uint8_t statusInput;
+    uint8_t statusMFR;
+    uint8_t statusCML;
+    uint8_t statusVout;
+    uint8_t statusIout;
+    uint8_t statusFans12;
+    uint8_t statusTemperature;
+
+    /** @brief The last raw INPUT_HISTORY record */
+    uint8_t inputHistory[5];
+
+    /** @brief The actual input voltage, in Volts */
+    double inputVoltage;
+};
+
+static_assert(std::is_standard_layout_v<TelemetryFrame>);
+static_assert(sizeof(TelemetryFrame) == 48);
+static_assert(offsetof(TelemetryFrame, inputVoltage) == 40);
+
+/**
+ * @class TelemetryServer
+ *
+ * Streams power supply telemetry to the clients of a Unix domain socket.
+ *
+ * The socket is a SOCK_SEQPACKET socket, so each TelemetryFrame is received
+ * as one message.  Clients only receive frames and never need to send
+ * anything.
+ *
+ * Frames are sent without blocking.  When a client does not read fast
+ * enough, its frames are queued up to maxQueuedFrames.  After that the
+ * oldest queued frames are dropped, and the number dropped is reported in
+ * the next frame the client receives.
+ */
+class TelemetryServer
+{
+  public:
+    static constexpr uint32_t frameMagic = 0x50535554; // "PSUT"
+    static constexpr uint16_t frameVersion = 1;
+
+    static constexpr uint8_t flagPresent = 0x01;
+    static constexpr uint8_t flagFaulted = 0x02;
+    static constexpr uint8_t flagHistoryValid = 0x04;
+
+    /** @brief The maximum number of connected clients */
+    static constexpr size_t maxClients = 8;
+
+    /** @brief The maximum number of frames queued for one client */
+    static constexpr size_t maxQueuedFrames = 256;
+
+    TelemetryServer() = delete;
+    TelemetryServer(const TelemetryServer&) = delete;
+    TelemetryServer& operator=(const TelemetryServer&) = delete;
+    TelemetryServer(TelemetryServer&&) = delete;
+    TelemetryServer& operator=(TelemetryServer&&) = delete;
+
+    /**
+     * Constructor
+     *
+     * Creates the socket, replacing any existing file at the path.
+     *
+     * @param[in] event - Event object to handle client connections with
+     * @param[in] path - The path of the socket
+     *
+     * @throw std::runtime_error if the socket cannot be created
+     */
+    TelemetryServer(const sdeventplus::Event& event, const std::string& path);
+
+    /**
+     * Destructor
+     *
+     * Closes all connections and removes the socket.
+     */
+    ~TelemetryServer();
+
+    /**
+     * Sends frames to all clients.
+     *
+     * The magic, version, size, and dropped fields are filled in.
+     *
+     * @param[in] frames - The frames of one analyze pass
+     */
+    void publish(const std::vector<TelemetryFrame>& frames);
+
+    /**
+     * Returns the number of connected clients.
+     */
+    size_t getNumClients() const;
+
+  private:
+    /**
+     * @brief A connected client
+     */
+    struct Client
+    {
+        /** @brief The connection */
+        int fd = -1;
+
+        /** @brief Handles the client closing the connection and the
+         *         connection becoming writable */
+        std::unique_ptr<sdeventplus::source::IO> source;
+
+        /** @brief Frames waiting to be sent */
+        std::deque<TelemetryFrame> queue;
+
+        /** @brief Frames dropped since the last frame sent */
+        uint32_t dropped = 0;
+
+        /** @brief Whether the connection was closed or failed */
+        bool closed = false;
+    };
+
+    /**
+     * Accepts a new client connection.
+     */
+    void acceptClient();
+
+    /**
+     * Handles an event on a client connection.
+     *
+     * @param[in] client - The client
+     * @param[in] revents - The epoll events that occurred
+     */
+    void clientEvent(Client& client, uint32_t revents);
+
+    /**
+     * Sends the queued frames of a client until the connection would block.
+     *
+     * Waits for the connection to become writable if frames remain.
+     *
+     * @param[in] client - The client
+     */
+    void flush(Client& client);
+
+    /**
+     * Removes the clients whose connections were closed.
+     */
+    void removeClosedClients();
+
+    /** @brief The event object */
+    sdeventplus::Event event;
+
+    /** @brief The path of the socket */
+    std::string path;
+
+    /** @brief The listening socket */
+    int listenFd = -1;
+
+    /** @brief Handles new client connections */
+    std::unique_ptr<sdeventplus::source::IO> listenSource;
+
+    /** @brief The connected clients */
+    std::vector<std::unique_ptr<Client>> clients;
+};
+
+} // namespace phosphor::power::manager
@@ -0,0 +1,93 @@
+#include "../energy_accumulator.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::psu;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+std::vector<uint8_t> makeBlock(uint16_t accumulator, uint8_t rolloverCount,
+                               uint32_t sampleCount)
+{
+    return {static_cast<uint8_t>(accumulator),
+            static_cast<uint8_t>(accumulator >> 8),
+            rolloverCount,
+            static_cast<uint8_t>(sampleCount),
+            static_cast<uint8_t>(sampleCount >> 8),
+            static_cast<uint8_t>(sampleCount >> 16)};
+}
+
+} // namespace
+
+TEST(EnergyAccumulatorTests, Parse)
+{
+    auto reading =
+        EnergyAccumulator::parse({0x34, 0x12, 0x05, 0x03, 0x02, 0x01});
+    EXPECT_EQ(reading.accumulator, 0x1234);
+    EXPECT_EQ(reading.rolloverCount, 0x05);
+    EXPECT_EQ(reading.sampleCount, 0x010203);
+
+    EXPECT_THROW(EnergyAccumulator::parse({0x34, 0x12, 0x05}),
+                 std::invalid_argument);
+}
+
+TEST(EnergyAccumulatorTests, Add)
+{
+    EnergyAccumulator energy;
+    std::chrono::steady_clock::time_point start{};
+
+    // The first reading only starts the interval
+    EXPECT_FALSE(energy.add(makeBlock(1000, 0, 100), start));
+    EXPECT_EQ(energy.getEnergy(), 0);
+
+    // 100 samples of 500 W over 2 seconds, rolling over once:
+    // 0x8000 + 18232 - 1000 = 50000
+    EXPECT_TRUE(energy.add(makeBlock(18232, 1, 200), start + 2s));
+    EXPECT_DOUBLE_EQ(energy.getAveragePower(), 500);
+    EXPECT_DOUBLE_EQ(energy.getEnergy(), 1000);
+
+    // No new samples, the interval continues
+    EXPECT_FALSE(energy.add(makeBlock(18232, 1, 200), start + 3s));
+
+    // Rolled over twice more: 2 * 0x8000 + 1000 - 18232 = 48304 over 8
+    // samples in 2 seconds
+    EXPECT_TRUE(energy.add(makeBlock(1000, 3, 208), start + 4s));
+    EXPECT_DOUBLE_EQ(energy.getAveragePower(), 6038);
+    EXPECT_DOUBLE_EQ(energy.getEnergy(), 1000 + 6038 * 2);
+
+    // Forgetting the last reading keeps the energy
+    energy.reset();
+    EXPECT_FALSE(energy.add(makeBlock(0, 0, 0), start + 5s));
+    EXPECT_DOUBLE_EQ(energy.getEnergy(), 1000 + 6038 * 2);
+}
+
+TEST(EnergyAccumulatorTests, Wrap)
+{
+    EnergyAccumulator energy;
+    std::chrono::steady_clock::time_point start{};
+
+    // The rollover count and the sample count both wrap
+    EXPECT_FALSE(energy.add(makeBlock(0x7000, 0xFF, 0xFFFFF0), start));
+    EXPECT_TRUE(energy.add(makeBlock(0x0800, 0x00, 0x000010), start + 1s));
+    // 0x1000 + 0x0800 over 0x20 samples
+    EXPECT_DOUBLE_EQ(energy.getAveragePower(), 0x1800 / 32.0);
+    EXPECT_DOUBLE_EQ(energy.getEnergy(), 0x1800 / 32.0);
+}
+
+TEST(EnergyAccumulatorTests, Coefficients)
+{
+    // X = (Y * 10^-R - b) / m
+    EnergyAccumulator energy{{.m = 2, .b = 10, .R = -1}};
+    std::chrono::steady_clock::time_point start{};
+
+    EXPECT_FALSE(energy.add(makeBlock(0, 0, 0), start));
+    EXPECT_TRUE(energy.add(makeBlock(300, 0, 10), start + 1s));
+    // (30 * 10 - 10) / 2
+    EXPECT_DOUBLE_EQ(energy.getAveragePower(), 145);
+}
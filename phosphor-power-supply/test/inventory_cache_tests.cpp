@@ -0,0 +1,153 @@
+#include "../inventory_cache.hpp"
+
+#include <sdbusplus/bus.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::psu;
+
+namespace
+{
+
+const std::string path{"/xyz/openbmc_project/inventory/system/powersupply0"};
+const std::string itemIface{"xyz.openbmc_project.Inventory.Item"};
+const std::string psuIface{"xyz.openbmc_project.Inventory.Item.PowerSupply"};
+
+/**
+ * InventoryCache that records the Notify method calls instead of sending
+ * them, and fails them on request.
+ */
+class TestInventoryCache : public InventoryCache
+{
+  public:
+    std::vector<ObjectMap> calls;
+    bool fail{false};
+
+  protected:
+    void notify(sdbusplus::bus::bus&, const ObjectMap& objects) override
+    {
+        calls.push_back(objects);
+        if (fail)
+        {
+            throw std::runtime_error{"Notify failed"};
+        }
+    }
+};
+
+const InventoryCache::InterfaceMap& sent(const InventoryCache::ObjectMap& call,
+                                         const std::string& objPath)
+{
+    return call.at(sdbusplus::message::object_path{objPath});
+}
+
+InventoryCache::InterfaceMap presence(bool present)
+{
+    InventoryCache::InterfaceMap interfaces;
+    interfaces[itemIface]["Present"] = present;
+    interfaces[itemIface]["PrettyName"] = std::string{"powersupply0"};
+    interfaces[psuIface];
+    return interfaces;
+}
+
+} // namespace
+
+TEST(InventoryCacheTests, UnchangedNotSent)
+{
+    auto bus = sdbusplus::bus::new_default();
+    TestInventoryCache cache;
+
+    // First update sends everything, including the empty interface
+    EXPECT_TRUE(cache.update(bus, path, presence(true)));
+    ASSERT_EQ(cache.calls.size(), 1);
+    EXPECT_EQ(sent(cache.calls[0], path), presence(true));
+    EXPECT_FALSE(cache.hasPending());
+
+    // Same values are not sent
+    EXPECT_TRUE(cache.update(bus, path, presence(true)));
+    EXPECT_EQ(cache.calls.size(), 1);
+
+    // Only the changed property is sent
+    EXPECT_TRUE(cache.update(bus, path, presence(false)));
+    ASSERT_EQ(cache.calls.size(), 2);
+    InventoryCache::InterfaceMap expected;
+    expected[itemIface]["Present"] = false;
+    EXPECT_EQ(sent(cache.calls[1], path), expected);
+}
+
+TEST(InventoryCacheTests, PendingSuperseded)
+{
+    auto bus = sdbusplus::bus::new_default();
+    TestInventoryCache cache;
+
+    EXPECT_TRUE(cache.update(bus, path, presence(true)));
+
+    // The changed value fails to be sent and stays pending
+    cache.fail = true;
+    EXPECT_FALSE(cache.update(bus, path, presence(false)));
+    EXPECT_EQ(cache.calls.size(), 2);
+    EXPECT_TRUE(cache.hasPending());
+
+    // Going back to the sent value drops the pending value without a call
+    EXPECT_TRUE(cache.update(bus, path, presence(true)));
+    EXPECT_EQ(cache.calls.size(), 2);
+    EXPECT_FALSE(cache.hasPending());
+
+    cache.fail = false;
+    EXPECT_TRUE(cache.retryPending(bus));
+    EXPECT_EQ(cache.calls.size(), 2);
+}
+
+TEST(InventoryCacheTests, FailedNotifyRetried)
+{
+    auto bus = sdbusplus::bus::new_default();
+    TestInventoryCache cache;
+    const std::string path1{
+        "/xyz/openbmc_project/inventory/system/powersupply1"};
+
+    cache.fail = true;
+    EXPECT_FALSE(cache.update(bus, path, presence(true)));
+    EXPECT_TRUE(cache.hasPending());
+
+    // The pending properties are sent with the next update
+    EXPECT_FALSE(cache.update(bus, path1, presence(false)));
+    ASSERT_EQ(cache.calls.size(), 2);
+    EXPECT_EQ(cache.calls[1].size(), 2);
+
+    EXPECT_FALSE(cache.retryPending(bus));
+    EXPECT_EQ(cache.calls.size(), 3);
+
+    // The retry sends both objects in a single call
+    cache.fail = false;
+    EXPECT_TRUE(cache.retryPending(bus));
+    ASSERT_EQ(cache.calls.size(), 4);
+    EXPECT_EQ(sent(cache.calls[3], path), presence(true));
+    EXPECT_EQ(sent(cache.calls[3], path1), presence(false));
+    EXPECT_FALSE(cache.hasPending());
+
+    // Nothing left to send
+    EXPECT_TRUE(cache.retryPending(bus));
+    EXPECT_TRUE(cache.update(bus, path, presence(true)));
+    EXPECT_EQ(cache.calls.size(), 4);
+}
+
+TEST(InventoryCacheTests, Invalidate)
+{
+    auto bus = sdbusplus::bus::new_default();
+    TestInventoryCache cache;
+
+    EXPECT_TRUE(cache.update(bus, path, presence(true)));
+    cache.fail = true;
+    EXPECT_FALSE(cache.update(bus, path, presence(false)));
+
+    // Everything is sent again, and the pending value wins
+    cache.invalidate();
+    EXPECT_TRUE(cache.hasPending());
+    cache.fail = false;
+    EXPECT_TRUE(cache.retryPending(bus));
+    ASSERT_EQ(cache.calls.size(), 3);
+    EXPECT_EQ(sent(cache.calls[2], path), presence(false));
+}
@@ -34,6 +34,7 @@ class MockedPMBus : public PMBusBase
     MOCK_METHOD(const fs::path&, path, (), (const, override));
     MOCK_METHOD(std::string, insertPageNum,
                 (const std::string& templateName, size_t page), (override));
+    MOCK_METHOD(fs::path, getPath, (Type type), (override));
 };
 } // namespace pmbus
 
@@ -72,6 +73,8 @@ class MockedGPIOInterface : public GPIOInterfaceBase
     MOCK_METHOD(void, toggleLowHigh, (const std::chrono::milliseconds& delay),
                 (override));
     MOCK_METHOD(std::string, getName, (), (const, override));
+    MOCK_METHOD(int, requestEvents, (), (override));
+    MOCK_METHOD(void, readEvents, (), (override));
 };
 
 const UtilBase& getUtils();
@@ -2,6 +2,9 @@
 #include "../record_manager.hpp"
 #include "mock.hpp"
 
+#include <unistd.h>
+
+#include <sdeventplus/event.hpp>
 #include <xyz/openbmc_project/Common/Device/error.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
@@ -16,9 +19,11 @@ using ::testing::Args;
 using ::testing::Assign;
 using ::testing::DoAll;
 using ::testing::ElementsAre;
+using ::testing::Invoke;
 using ::testing::NotNull;
 using ::testing::Return;
 using ::testing::StrEq;
+using ::testing::Throw;
 
 static auto PSUInventoryPath = "/xyz/bmc/inv/sys/chassis/board/powersupply0";
 static auto PSUGPIOLineName = "presence-ps0";
@@ -1056,9 +1061,33 @@ TEST_F(PowerSupplyTests, UpdateInventory)
             .Times(1)
             .WillOnce(Return("123456"));
         psu.analyze();
-        EXPECT_CALL(mockPMBus, readString(_, _)).WillRepeatedly(Return(""));
+        // The VPD was read when it became present, it is not read again.
+        EXPECT_CALL(mockPMBus, readString(_, _)).Times(0);
         psu.updateInventory();
 
+        // The power supply is removed
+        EXPECT_CALL(*mockPresenceGPIO, read())
+            .Times(2)
+            .WillOnce(Return(0))
+            .WillOnce(Return(1));
+        EXPECT_CALL(mockedUtil, setPresence(_, _, false, _));
+        psu.analyze();
+        EXPECT_EQ(psu.isPresent(), false);
+
+        // A power supply is inserted, starting a new presence epoch. The VPD
+        // is read again, with MFR_POUT_MAX failing to read for the input
+        // history setup and the inventory update.
+        EXPECT_CALL(mockPMBus, findHwmonDir());
+        EXPECT_CALL(mockPMBus, writeBinary(ON_OFF_CONFIG, _, _));
+        EXPECT_CALL(mockPMBus, read(READ_VIN, _, _))
+            .Times(1)
+            .WillOnce(Return(1));
+        // The input voltage was not 0 before, so only CLEAR_FAULTS clears
+        // the VIN_UV fault.
+        EXPECT_CALL(mockPMBus, read("in1_lcrit_alarm", _, _))
+            .Times(1)
+            .WillOnce(Return(1));
+        EXPECT_CALL(mockedUtil, setPresence(_, _, true, _));
 #if IBM_VPD
         EXPECT_CALL(mockPMBus, readString(_, _))
             .WillOnce(Return("CCIN"))
@@ -1068,6 +1097,25 @@ TEST_F(PowerSupplyTests, UpdateInventory)
             .WillOnce(Return("SN3456"))
             .WillOnce(Return("FW3456"));
 #endif
+        EXPECT_CALL(mockPMBus, readString(MFR_POUT_MAX, _))
+            .Times(2)
+            .WillRepeatedly(Throw(std::runtime_error{"Read failed"}));
+        setPMBusExpectations(mockPMBus, expectations);
+        EXPECT_CALL(mockPMBus, readString(READ_VIN, _))
+            .Times(1)
+            .WillOnce(Return("123456"));
+        psu.analyze();
+        EXPECT_EQ(psu.isPresent(), true);
+
+        // Only the field that failed is read again
+        EXPECT_CALL(mockPMBus, readString(_, _)).Times(0);
+        EXPECT_CALL(mockPMBus, readString(MFR_POUT_MAX, _))
+            .Times(1)
+            .WillOnce(Return("2000"));
+        psu.updateInventory();
+
+        // All of the fields have been read
+        EXPECT_CALL(mockPMBus, readString(_, _)).Times(0);
         psu.updateInventory();
         // TODO: D-Bus mocking to verify values stored on D-Bus (???)
     }
@@ -1112,6 +1160,79 @@ TEST_F(PowerSupplyTests, IsPresent)
     EXPECT_EQ(psu.isPresent(), true);
 }
 
+TEST_F(PowerSupplyTests, MonitorPresenceEvents)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto event = sdeventplus::Event::get_new();
+
+    // Test where the GPIO line cannot be requested for events. Presence is
+    // still read by analyze().
+    {
+        PowerSupply psu{bus,  PSUInventoryPath, 3,
+                        0x68, "ibm-cffps",      PSUGPIOLineName};
+        MockedGPIOInterface* mockPresenceGPIO =
+            static_cast<MockedGPIOInterface*>(psu.getPresenceGPIO());
+        EXPECT_CALL(*mockPresenceGPIO, requestEvents())
+            .Times(1)
+            .WillOnce(Throw(std::runtime_error{"Line busy"}));
+        psu.monitorPresenceEvents(event);
+
+        EXPECT_CALL(*mockPresenceGPIO, read()).Times(1).WillOnce(Return(0));
+        psu.analyze();
+        EXPECT_EQ(psu.isPresent(), false);
+    }
+
+    // Test where presence changes are handled by GPIO events
+    {
+        int fds[2];
+        ASSERT_EQ(pipe(fds), 0);
+
+        {
+            PowerSupply psu{bus,  PSUInventoryPath, 3,
+                            0x68, "ibm-cffps",      PSUGPIOLineName};
+            MockedGPIOInterface* mockPresenceGPIO =
+                static_cast<MockedGPIOInterface*>(psu.getPresenceGPIO());
+
+            // Requesting events returns the event file descriptor. The
+            // presence is read once after requesting events and once for the
+            // event.
+            EXPECT_CALL(*mockPresenceGPIO, requestEvents())
+                .Times(1)
+                .WillOnce(Return(fds[0]));
+            EXPECT_CALL(*mockPresenceGPIO, read())
+                .Times(2)
+                .WillOnce(Return(0))
+                .WillOnce(Return(1));
+            psu.monitorPresenceEvents(event);
+            EXPECT_EQ(psu.isPresent(), false);
+
+            // analyze() no longer reads the presence GPIO.
+            psu.analyze();
+            EXPECT_EQ(psu.isPresent(), false);
+
+            // Event changes power supply to present.
+            MockedPMBus& mockPMBus = static_cast<MockedPMBus&>(psu.getPMBus());
+            EXPECT_CALL(mockPMBus, findHwmonDir());
+            EXPECT_CALL(mockPMBus, readString(MFR_POUT_MAX, _))
+                .WillRepeatedly(Return("2000"));
+            EXPECT_CALL(mockedUtil, setPresence(_, _, true, _));
+            EXPECT_CALL(*mockPresenceGPIO, readEvents())
+                .Times(1)
+                .WillOnce(Invoke([&fds]() {
+                    char data;
+                    ASSERT_EQ(::read(fds[0], &data, 1), 1);
+                }));
+            char data = 1;
+            ASSERT_EQ(::write(fds[1], &data, 1), 1);
+            event.run(std::nullopt);
+            EXPECT_EQ(psu.isPresent(), true);
+        }
+
+        close(fds[0]);
+        close(fds[1]);
+    }
+}
+
 TEST_F(PowerSupplyTests, IsFaulted)
 {
     auto bus = sdbusplus::bus::new_default();
@@ -1621,6 +1742,158 @@ TEST_F(PowerSupplyTests, HasTempFault)
     EXPECT_EQ(psu.hasTempFault(), false);
 }
 
+TEST_F(PowerSupplyTests, SetDeglitchInterval)
+{
+    auto bus = sdbusplus::bus::new_default();
+
+    EXPECT_CALL(mockedUtil, setAvailable(_, _, true)).Times(1);
+    EXPECT_CALL(mockedUtil, setAvailable(_, _, false)).Times(0);
+
+    PowerSupply psu{bus,  PSUInventoryPath, 3,
+                    0x6a, "ibm-cffps",      PSUGPIOLineName};
+    MockedGPIOInterface* mockPresenceGPIO =
+        static_cast<MockedGPIOInterface*>(psu.getPresenceGPIO());
+    // Always return 1 to indicate present.
+    EXPECT_CALL(*mockPresenceGPIO, read()).WillRepeatedly(Return(1));
+    MockedPMBus& mockPMBus = static_cast<MockedPMBus&>(psu.getPMBus());
+    setMissingToPresentExpects(mockPMBus, mockedUtil);
+    EXPECT_CALL(mockPMBus, readString(MFR_POUT_MAX, _))
+        .Times(1)
+        .WillOnce(Return("2000"));
+    // STATUS_WORD 0x0000 is powered on, no faults.
+    PMBusExpectations expectations;
+    setPMBusExpectations(mockPMBus, expectations);
+    EXPECT_CALL(mockPMBus, readString(READ_VIN, _))
+        .Times(1)
+        .WillOnce(Return("206100"));
+    psu.analyze();
+    EXPECT_EQ(psu.hasTempFault(), false);
+
+    // Fault counts are only updated once per hour. The new fault is counted
+    // right away, the following calls to analyze() do not update the count.
+    psu.setDeglitchInterval(std::chrono::hours(1));
+    expectations.statusWordValue = (status_word::TEMPERATURE_FAULT_WARN);
+    expectations.statusTempValue = 0x80;
+    for (auto x = 1; x <= DEGLITCH_LIMIT; x++)
+    {
+        setPMBusExpectations(mockPMBus, expectations);
+        EXPECT_CALL(mockPMBus, readString(READ_VIN, _))
+            .Times(1)
+            .WillOnce(Return("206200"));
+        psu.analyze();
+        EXPECT_EQ(psu.hasTempFault(), false);
+    }
+
+    // Fault counts are updated on every call to analyze() again.
+    psu.setDeglitchInterval(std::chrono::milliseconds(0));
+    for (auto x = 2; x <= DEGLITCH_LIMIT; x++)
+    {
+        setPMBusExpectations(mockPMBus, expectations);
+        EXPECT_CALL(mockPMBus, readString(READ_VIN, _))
+            .Times(1)
+            .WillOnce(Return("206200"));
+        psu.analyze();
+        EXPECT_EQ(psu.hasTempFault(), x >= DEGLITCH_LIMIT);
+    }
+}
+
+TEST_F(PowerSupplyTests, AlarmChanged)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto event = sdeventplus::Event::get_new();
+
+    PowerSupply psu{bus,  PSUInventoryPath, 3,
+                    0x6a, "ibm-cffps",      PSUGPIOLineName};
+    MockedGPIOInterface* mockPresenceGPIO =
+        static_cast<MockedGPIOInterface*>(psu.getPresenceGPIO());
+    // Always return 1 to indicate present.
+    EXPECT_CALL(*mockPresenceGPIO, read()).WillRepeatedly(Return(1));
+    MockedPMBus& mockPMBus = static_cast<MockedPMBus&>(psu.getPMBus());
+    setMissingToPresentExpects(mockPMBus, mockedUtil);
+    EXPECT_CALL(mockPMBus, readString(MFR_POUT_MAX, _))
+        .Times(1)
+        .WillOnce(Return("2000"));
+    // STATUS_WORD 0x0000 is powered on, no faults.
+    PMBusExpectations expectations;
+    setPMBusExpectations(mockPMBus, expectations);
+    EXPECT_CALL(mockPMBus, readString(READ_VIN, _))
+        .Times(1)
+        .WillOnce(Return("206100"));
+    psu.analyze();
+    EXPECT_EQ(psu.hasVINUVFault(), false);
+
+    // The alarm attributes are not in the hwmon directory, so they are
+    // skipped. Changes are still passed on to the callback.
+    EXPECT_CALL(mockPMBus, getPath(Type::Hwmon))
+        .Times(1)
+        .WillOnce(Return(std::filesystem::path{"/nonexistent/hwmon"}));
+    int callbackCount = 0;
+    psu.monitorAlarmEvents(event,
+                           [&callbackCount](PowerSupply&) { callbackCount++; });
+
+    // Fault counts are only updated once per hour. The new fault is counted
+    // right away, the following call to analyze() does not update the count.
+    psu.setDeglitchInterval(std::chrono::hours(1));
+    expectations.statusWordValue = (status_word::VIN_UV_FAULT);
+    expectations.statusInputValue = 0x18;
+    for (auto x = 1; x <= 2; x++)
+    {
+        setPMBusExpectations(mockPMBus, expectations);
+        EXPECT_CALL(mockPMBus, readString(READ_VIN, _))
+            .Times(1)
+            .WillOnce(Return("19876"));
+        psu.analyze();
+        EXPECT_EQ(psu.hasVINUVFault(), false);
+    }
+
+    // An alarm that is on forces the analysis and the deglitch limit.
+    psu.alarmChanged(StatusFault::vinUV, true);
+    EXPECT_EQ(callbackCount, 1);
+    setPMBusExpectations(mockPMBus, expectations);
+    EXPECT_CALL(mockPMBus, readString(READ_VIN, _))
+        .Times(1)
+        .WillOnce(Return("19876"));
+    EXPECT_CALL(mockedUtil, setAvailable(_, _, false));
+    psu.analyze();
+    EXPECT_EQ(psu.hasVINUVFault(), true);
+
+    // Fault goes away.
+    expectations.statusWordValue = 0;
+    setPMBusExpectations(mockPMBus, expectations);
+    EXPECT_CALL(mockPMBus, readString(READ_VIN, _))
+        .Times(1)
+        .WillOnce(Return("201300"));
+    EXPECT_CALL(mockPMBus, read("in1_lcrit_alarm", _, _))
+        .Times(1)
+        .WillOnce(Return(1));
+    EXPECT_CALL(mockedUtil, setAvailable(_, _, true));
+    psu.analyze();
+    EXPECT_EQ(psu.hasVINUVFault(), false);
+
+    // The alarm was reset by the analysis: the fault comes back and is only
+    // counted once, since no analysis is due before the deglitch interval.
+    expectations.statusWordValue = (status_word::VIN_UV_FAULT);
+    for (auto x = 1; x <= DEGLITCH_LIMIT; x++)
+    {
+        setPMBusExpectations(mockPMBus, expectations);
+        EXPECT_CALL(mockPMBus, readString(READ_VIN, _))
+            .Times(1)
+            .WillOnce(Return("19876"));
+        psu.analyze();
+        EXPECT_EQ(psu.hasVINUVFault(), false);
+    }
+
+    // An alarm that is off forces the analysis, but not the deglitch limit.
+    psu.alarmChanged(StatusFault::vinUV, false);
+    EXPECT_EQ(callbackCount, 2);
+    setPMBusExpectations(mockPMBus, expectations);
+    EXPECT_CALL(mockPMBus, readString(READ_VIN, _))
+        .Times(1)
+        .WillOnce(Return("19876"));
+    psu.analyze();
+    EXPECT_EQ(psu.hasVINUVFault(), false);
+}
+
 TEST_F(PowerSupplyTests, HasPgoodFault)
 {
     auto bus = sdbusplus::bus::new_default();
@@ -2172,6 +2445,46 @@ TEST_F(PowerSupplyTests, UpdateHistory)
     EXPECT_EQ(psu.getNumInputHistoryRecords(), 0);
 }
 
+TEST_F(PowerSupplyTests, SetTelemetryReadInterval)
+{
+    auto bus = sdbusplus::bus::new_default();
+    PowerSupply psu{bus,  PSUInventoryPath, 7,
+                    0x6e, "ibm-cffps",      PSUGPIOLineName};
+    // Read INPUT_HISTORY at most once an hour
+    psu.setTelemetryReadInterval(std::chrono::hours{1});
+    MockedGPIOInterface* mockPresenceGPIO =
+        static_cast<MockedGPIOInterface*>(psu.getPresenceGPIO());
+    // Always return 1 to indicate present.
+    EXPECT_CALL(*mockPresenceGPIO, read()).WillRepeatedly(Return(1));
+    MockedPMBus& mockPMBus = static_cast<MockedPMBus&>(psu.getPMBus());
+    setMissingToPresentExpects(mockPMBus, mockedUtil);
+    EXPECT_CALL(mockPMBus, readString(MFR_POUT_MAX, _))
+        .Times(1)
+        .WillOnce(Return("2000"));
+    PMBusExpectations expectations;
+    setPMBusExpectations(mockPMBus, expectations);
+    EXPECT_CALL(mockPMBus, readString(READ_VIN, _))
+        .Times(3)
+        .WillRepeatedly(Return("205000"));
+    EXPECT_CALL(mockedUtil, setAvailable(_, _, true));
+    std::vector<uint8_t> firstHistory{0x00, 0x50, 0xf3, 0x54, 0xf3};
+    // Only the first analyze() reads INPUT_HISTORY; the status is read by all
+    EXPECT_CALL(
+        mockPMBus,
+        readBinary(INPUT_HISTORY, Type::HwmonDeviceDebug,
+                   phosphor::power::history::RecordManager::RAW_RECORD_SIZE))
+        .Times(1)
+        .WillOnce(Return(firstHistory));
+    psu.analyze();
+    EXPECT_EQ(psu.getNumInputHistoryRecords(), 1);
+    for (auto i = 0; i < 2; i++)
+    {
+        setPMBusExpectations(mockPMBus, expectations);
+        psu.analyze();
+        EXPECT_EQ(psu.getNumInputHistoryRecords(), 1);
+    }
+}
+
 TEST_F(PowerSupplyTests, IsSyncHistoryRequired)
 {
     auto bus = sdbusplus::bus::new_default();
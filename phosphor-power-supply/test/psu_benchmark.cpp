@@ -0,0 +1,324 @@
+/**
+ * Runs simulated power supplies through a fault scenario and reports the cost
+ * of analyzing them and how long faults take to be detected.
+ *
+ * Every tick applies the scenario events for that tick to the simulated
+ * devices, then calls analyze() on every power supply, the same as the
+ * monitor does on each poll. Ticks are paced in real time, so the deglitch
+ * interval has its normal effect on detection latency.
+ */
+#include "../power_supply.hpp"
+#include "simulation.hpp"
+
+#include <fmt/format.h>
+#include <time.h>
+
+#include <CLI/CLI.hpp>
+#include <sdbusplus/bus.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace phosphor::power::psu;
+using namespace phosphor::power::psu::simulation;
+
+namespace
+{
+
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> allocationBytes{0};
+
+} // namespace
+
+void* operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+
+/**
+ * Returns the CPU time used by this thread.
+ */
+std::chrono::nanoseconds threadCPUTime()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds{ts.tv_sec} +
+           std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+/**
+ * Returns whether the power supply reports a fault injected by the scenario.
+ */
+bool isDetected(const PowerSupply& psu, Fault fault)
+{
+    switch (fault)
+    {
+        case Fault::vinLoss:
+            return psu.hasVINUVFault();
+        case Fault::ioutOC:
+            return psu.hasIoutOCFault();
+        case Fault::fan:
+            return psu.hasFanFault();
+        case Fault::temperature:
+            return psu.hasTempFault();
+        case Fault::pgood:
+            return psu.hasPgoodFault();
+        case Fault::cml:
+            return psu.hasCommFault();
+        case Fault::psKill:
+            return psu.hasPSKillFault();
+        case Fault::presence:
+            return !psu.isPresent();
+    }
+    return false;
+}
+
+/**
+ * Returns the value at a percentile of sorted values.
+ */
+template <typename T>
+T percentile(const std::vector<T>& sorted, size_t percent)
+{
+    if (sorted.empty())
+    {
+        return T{};
+    }
+    return sorted[std::min(sorted.size() - 1, sorted.size() * percent / 100)];
+}
+
+/** @brief An injected fault waiting to be detected */
+struct Injection
+{
+    size_t device;
+    Fault fault;
+    size_t tick;
+    std::chrono::steady_clock::time_point time;
+};
+
+/** @brief Detection latencies of one kind of fault */
+struct Latencies
+{
+    std::vector<size_t> ticks;
+    std::vector<std::chrono::milliseconds> times;
+    size_t missed = 0;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    CLI::App app{"Power supply monitor simulation benchmark"};
+
+    size_t numPSUs = 16;
+    size_t numBuses = 4;
+    size_t numTicks = 240;
+    size_t faultTicks = 60;
+    auto interval = 100;
+    auto deglitchInterval = DEGLITCH_INTERVAL.count();
+    app.add_option("--psus", numPSUs, "Number of simulated power supplies")
+        ->check(CLI::PositiveNumber);
+    app.add_option("--buses", numBuses,
+                   "Number of I2C buses to spread them on")
+        ->check(CLI::PositiveNumber);
+    app.add_option("--ticks", numTicks, "Number of ticks to run")
+        ->check(CLI::PositiveNumber);
+    app.add_option("--fault-ticks", faultTicks,
+                   "Number of ticks each injected fault lasts")
+        ->check(CLI::PositiveNumber);
+    app.add_option("--interval", interval, "Milliseconds between ticks")
+        ->check(CLI::NonNegativeNumber);
+    app.add_option("--deglitch-interval", deglitchInterval,
+                   "Minimum milliseconds between fault count updates")
+        ->check(CLI::NonNegativeNumber);
+    CLI11_PARSE(app, argc, argv);
+
+    auto bus = sdbusplus::bus::new_default();
+    auto& simulation = getSimulation();
+    auto& devices = simulation.getDevices();
+
+    std::vector<std::unique_ptr<PowerSupply>> psus;
+    for (size_t i = 0; i < numPSUs; i++)
+    {
+        auto i2cBus = static_cast<uint8_t>(3 + (i % numBuses));
+        auto i2cAddress = static_cast<uint16_t>(0x68 + (i / numBuses));
+        auto gpioLineName = fmt::format("presence-ps{}", i);
+
+        // Inserted after the bind delay is turned off
+        simulation.addDevice(i2cBus, i2cAddress, gpioLineName).present = false;
+
+        psus.push_back(std::make_unique<PowerSupply>(
+            bus,
+            fmt::format("/xyz/openbmc_project/inventory/system/chassis/"
+                        "motherboard/powersupply{}",
+                        i),
+            i2cBus, i2cAddress, "ibm-cffps", gpioLineName));
+        psus.back()->setBindDelay(std::chrono::milliseconds{0});
+        psus.back()->setDeglitchInterval(
+            std::chrono::milliseconds{deglitchInterval});
+    }
+
+    for (auto& device : devices)
+    {
+        device->present = true;
+    }
+    for (auto& psu : psus)
+    {
+        psu->analyze();
+    }
+
+    auto events = makeScenario(numPSUs, numTicks, faultTicks);
+    auto nextEvent = events.begin();
+
+    std::vector<std::chrono::nanoseconds> cpuTimes;
+    std::vector<size_t> allocations;
+    size_t totalBytes = 0;
+    std::vector<Injection> injections;
+    std::map<Fault, Latencies> latencies;
+
+    auto deadline = std::chrono::steady_clock::now();
+    for (size_t tick = 0; tick < numTicks; tick++)
+    {
+        for (; (nextEvent != events.end()) && (nextEvent->tick == tick);
+             ++nextEvent)
+        {
+            setFault(*devices[nextEvent->device], nextEvent->fault,
+                     nextEvent->active);
+
+            auto it = std::find_if(
+                injections.begin(), injections.end(), [&](const auto& inj) {
+                    return (inj.device == nextEvent->device) &&
+                           (inj.fault == nextEvent->fault);
+                });
+            if (nextEvent->active)
+            {
+                injections.push_back({nextEvent->device, nextEvent->fault,
+                                      tick, std::chrono::steady_clock::now()});
+            }
+            else if (it != injections.end())
+            {
+                // Cleared before it was detected
+                latencies[it->fault].missed++;
+                injections.erase(it);
+            }
+        }
+
+        auto bytes = allocationBytes.load();
+        auto count = allocationCount.load();
+        auto cpuTime = threadCPUTime();
+
+        for (auto& psu : psus)
+        {
+            psu->analyze();
+        }
+
+        cpuTimes.push_back(threadCPUTime() - cpuTime);
+        allocations.push_back(allocationCount.load() - count);
+        totalBytes += allocationBytes.load() - bytes;
+
+        auto now = std::chrono::steady_clock::now();
+        std::erase_if(injections, [&](const auto& inj) {
+            if (!isDetected(*psus[inj.device], inj.fault))
+            {
+                return false;
+            }
+            auto& latency = latencies[inj.fault];
+            latency.ticks.push_back(tick - inj.tick);
+            latency.times.push_back(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    now - inj.time));
+            return true;
+        });
+
+        deadline += std::chrono::milliseconds{interval};
+        std::this_thread::sleep_until(deadline);
+    }
+
+    for (const auto& inj : injections)
+    {
+        latencies[inj.fault].missed++;
+    }
+
+    auto totalCPUTime = std::accumulate(cpuTimes.begin(), cpuTimes.end(),
+                                        std::chrono::nanoseconds{0});
+    std::sort(cpuTimes.begin(), cpuTimes.end());
+    auto totalAllocations =
+        std::accumulate(allocations.begin(), allocations.end(), size_t{0});
+    std::sort(allocations.begin(), allocations.end());
+
+    auto us = [](std::chrono::nanoseconds ns) { return ns.count() / 1000.0; };
+
+    fmt::print("{} power supplies on {} buses, {} ticks of {} ms, "
+               "deglitch interval {} ms\n\n",
+               numPSUs, std::min(numPSUs, numBuses), numTicks, interval,
+               deglitchInterval);
+
+    fmt::print("CPU per tick:         mean {:.1f} us, p50 {:.1f} us, "
+               "p99 {:.1f} us, max {:.1f} us\n",
+               us(totalCPUTime / numTicks), us(percentile(cpuTimes, 50)),
+               us(percentile(cpuTimes, 99)), us(cpuTimes.back()));
+    fmt::print("CPU per power supply: mean {:.1f} us\n",
+               us(totalCPUTime / numTicks / numPSUs));
+    fmt::print("Allocations per tick: mean {:.1f}, p99 {}, max {}, "
+               "mean {:.0f} bytes\n\n",
+               static_cast<double>(totalAllocations) / numTicks,
+               percentile(allocations, 99), allocations.back(),
+               static_cast<double>(totalBytes) / numTicks);
+
+    fmt::print("{:<12} {:>8} {:>6} {:>10} {:>10} {:>10}\n", "Fault",
+               "Detected", "Missed", "Mean ticks", "Max ticks", "Mean ms");
+    size_t totalMissed = 0;
+    for (auto& [fault, latency] : latencies)
+    {
+        auto detected = latency.ticks.size();
+        double meanTicks = 0;
+        double meanTime = 0;
+        size_t maxTicks = 0;
+        if (detected)
+        {
+            meanTicks = std::accumulate(latency.ticks.begin(),
+                                        latency.ticks.end(), 0.0) /
+                        detected;
+            meanTime = std::accumulate(latency.times.begin(),
+                                       latency.times.end(),
+                                       std::chrono::milliseconds{0})
+                           .count() /
+                       static_cast<double>(detected);
+            maxTicks =
+                *std::max_element(latency.ticks.begin(), latency.ticks.end());
+        }
+        fmt::print("{:<12} {:>8} {:>6} {:>10.1f} {:>10} {:>10.0f}\n",
+                   getFaultName(fault), detected, latency.missed, meanTicks,
+                   maxTicks, meanTime);
+        totalMissed += latency.missed;
+    }
+
+    return (totalMissed == 0) ? 0 : 1;
+}
@@ -0,0 +1,379 @@
+#include "simulation.hpp"
+
+#include "util.hpp"
+
+#include <fmt/format.h>
+
+#include <xyz/openbmc_project/Common/Device/error.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace phosphor
+{
+namespace pmbus
+{
+
+std::unique_ptr<PMBusBase> createPMBus(std::uint8_t bus,
+                                       const std::string& address)
+{
+    using namespace phosphor::power::psu::simulation;
+    return std::make_unique<SimulatedPMBus>(
+        getSimulation().getDevice(bus, address));
+}
+
+} // namespace pmbus
+
+namespace power
+{
+namespace psu
+{
+
+const UtilBase& getUtils()
+{
+    static simulation::SimulatedUtil util;
+    return util;
+}
+
+std::unique_ptr<GPIOInterfaceBase> createGPIO(const std::string& namedGpio)
+{
+    using namespace simulation;
+    return std::make_unique<SimulatedGPIO>(
+        getSimulation().getDevice(namedGpio), namedGpio);
+}
+
+namespace simulation
+{
+
+using namespace phosphor::pmbus;
+using ReadFailure =
+    sdbusplus::xyz::openbmc_project::Common::Device::Error::ReadFailure;
+
+// STATUS_VOUT with the page PowerSupply reads inserted
+const std::string statusVoutPage0{"status0_vout"};
+
+const char* getFaultName(Fault fault)
+{
+    switch (fault)
+    {
+        case Fault::vinLoss:
+            return "VIN loss";
+        case Fault::ioutOC:
+            return "IOUT_OC";
+        case Fault::fan:
+            return "fan";
+        case Fault::temperature:
+            return "temperature";
+        case Fault::pgood:
+            return "PGOOD";
+        case Fault::cml:
+            return "CML";
+        case Fault::psKill:
+            return "PS_Kill";
+        case Fault::presence:
+            return "presence";
+    }
+    return "";
+}
+
+void setFault(Device& device, Fault fault, bool active)
+{
+    uint16_t word = 0;
+    uint8_t* reg = nullptr;
+    uint8_t regBits = 0;
+
+    switch (fault)
+    {
+        case Fault::vinLoss:
+            word = status_word::INPUT_FAULT_WARN | status_word::VIN_UV_FAULT |
+                   status_word::POWER_GOOD_NEGATED | status_word::UNIT_IS_OFF;
+            reg = &device.statusInput;
+            regBits = 0x18;
+            device.inputVoltage = active ? 0.0 : 220.0;
+            break;
+        case Fault::ioutOC:
+            word = status_word::IOUT_OC_FAULT;
+            reg = &device.statusIout;
+            regBits = 0x80;
+            break;
+        case Fault::fan:
+            word = status_word::FAN_FAULT;
+            reg = &device.statusFans12;
+            regBits = 0x80;
+            break;
+        case Fault::temperature:
+            word = status_word::TEMPERATURE_FAULT_WARN;
+            reg = &device.statusTemperature;
+            regBits = status_temperature::OT_FAULT;
+            break;
+        case Fault::pgood:
+            word = status_word::POWER_GOOD_NEGATED;
+            break;
+        case Fault::cml:
+            word = status_word::CML_FAULT;
+            reg = &device.statusCML;
+            regBits = 0x02;
+            break;
+        case Fault::psKill:
+            word = status_word::MFR_SPECIFIC_FAULT;
+            reg = &device.statusMFR;
+            regBits = 0x10;
+            break;
+        case Fault::presence:
+            device.present = !active;
+            return;
+    }
+
+    if (active)
+    {
+        device.statusWord |= word;
+        if (reg != nullptr)
+        {
+            *reg |= regBits;
+        }
+    }
+    else
+    {
+        device.statusWord &= ~word;
+        if (reg != nullptr)
+        {
+            *reg &= ~regBits;
+        }
+    }
+}
+
+std::vector<Event> makeScenario(size_t numDevices, size_t numTicks,
+                                size_t duration)
+{
+    constexpr size_t numFaults = static_cast<size_t>(Fault::presence) + 1;
+
+    // Tick 0 is left for the power supplies to settle
+    if (numTicks < duration + 2)
+    {
+        throw std::invalid_argument{fmt::format(
+            "{} ticks is too short for {} tick faults", numTicks, duration)};
+    }
+    auto span = numTicks - duration - 1;
+
+    std::vector<Event> events;
+    for (size_t i = 0; i < numDevices; i++)
+    {
+        auto fault = static_cast<Fault>(i % numFaults);
+        // Spread the start ticks so several faults overlap
+        auto start = 1 + ((i * 7) % span);
+        events.push_back({start, i, fault, true});
+        events.push_back({start + duration, i, fault, false});
+    }
+
+    std::stable_sort(events.begin(), events.end(),
+                     [](const auto& a, const auto& b) {
+                         return a.tick < b.tick;
+                     });
+    return events;
+}
+
+Device& Simulation::addDevice(uint8_t i2cBus, uint16_t i2cAddress,
+                              const std::string& gpioLineName)
+{
+    // Same format as the address PowerSupply passes to createPMBus()
+    entries.push_back(
+        {i2cBus, fmt::format("{:04x}", i2cAddress), gpioLineName});
+    devices.push_back(std::make_unique<Device>());
+    return *devices.back();
+}
+
+Device& Simulation::getDevice(uint8_t i2cBus, const std::string& address)
+{
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if ((entries[i].i2cBus == i2cBus) && (entries[i].address == address))
+        {
+            return *devices[i];
+        }
+    }
+    throw std::out_of_range{
+        fmt::format("No simulated device at {}-{}", i2cBus, address)};
+}
+
+Device& Simulation::getDevice(const std::string& gpioLineName)
+{
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (entries[i].gpioLineName == gpioLineName)
+        {
+            return *devices[i];
+        }
+    }
+    throw std::out_of_range{
+        fmt::format("No simulated device with GPIO {}", gpioLineName)};
+}
+
+Simulation& getSimulation()
+{
+    static Simulation simulation;
+    return simulation;
+}
+
+uint64_t SimulatedPMBus::read(const std::string& name, Type /*type*/,
+                              bool /*errTrace*/)
+{
+    if (!device.present)
+    {
+        throw ReadFailure{};
+    }
+    device.reads++;
+
+    if (name == STATUS_WORD)
+    {
+        return device.statusWord;
+    }
+    if (name == STATUS_INPUT)
+    {
+        return device.statusInput;
+    }
+    if (name == STATUS_MFR)
+    {
+        return device.statusMFR;
+    }
+    if (name == STATUS_CML)
+    {
+        return device.statusCML;
+    }
+    if (name == statusVoutPage0)
+    {
+        return device.statusVout;
+    }
+    if (name == STATUS_IOUT)
+    {
+        return device.statusIout;
+    }
+    if (name == STATUS_FANS_1_2)
+    {
+        return device.statusFans12;
+    }
+    if (name == STATUS_TEMPERATURE)
+    {
+        return device.statusTemperature;
+    }
+    // Alarms, such as in1_lcrit_alarm, are reported as off
+    return 0;
+}
+
+std::string SimulatedPMBus::readString(const std::string& name, Type /*type*/)
+{
+    if (!device.present)
+    {
+        throw ReadFailure{};
+    }
+    device.reads++;
+
+    if (name == READ_VIN)
+    {
+        // Millivolts
+        return std::to_string(
+            static_cast<uint64_t>(device.inputVoltage * 1000));
+    }
+    if (name == MFR_POUT_MAX)
+    {
+        return "2000";
+    }
+    return "";
+}
+
+std::vector<uint8_t> SimulatedPMBus::readBinary(const std::string& name,
+                                                Type /*type*/, size_t length)
+{
+    if (!device.present)
+    {
+        throw ReadFailure{};
+    }
+    device.reads++;
+
+    std::vector<uint8_t> data(length, 0);
+    if ((name == INPUT_HISTORY) && !data.empty())
+    {
+        // A new record on every read
+        data[0] = ++device.historySequence;
+    }
+    return data;
+}
+
+void SimulatedPMBus::writeBinary(const std::string& /*name*/,
+                                 std::vector<uint8_t> /*data*/, Type /*type*/)
+{}
+
+void SimulatedPMBus::findHwmonDir()
+{}
+
+const fs::path& SimulatedPMBus::path() const
+{
+    return basePath;
+}
+
+std::string SimulatedPMBus::insertPageNum(const std::string& templateName,
+                                          size_t page)
+{
+    auto name = templateName;
+    auto pos = name.find('P');
+    if (pos != std::string::npos)
+    {
+        name.replace(pos, 1, std::to_string(page));
+    }
+    return name;
+}
+
+fs::path SimulatedPMBus::getPath(Type /*type*/)
+{
+    return basePath;
+}
+
+int SimulatedGPIO::read()
+{
+    return device.present ? 1 : 0;
+}
+
+void SimulatedGPIO::write(int /*value*/, std::bitset<32> /*flags*/)
+{}
+
+void SimulatedGPIO::toggleLowHigh(const std::chrono::milliseconds& /*delay*/)
+{}
+
+std::string SimulatedGPIO::getName() const
+{
+    return name;
+}
+
+int SimulatedGPIO::requestEvents()
+{
+    throw std::runtime_error{"GPIO events are not simulated"};
+}
+
+void SimulatedGPIO::readEvents()
+{}
+
+bool SimulatedUtil::getPresence(sdbusplus::bus::bus& /*bus*/,
+                                const std::string& /*invpath*/) const
+{
+    return false;
+}
+
+void SimulatedUtil::setPresence(sdbusplus::bus::bus& /*bus*/,
+                                const std::string& /*invpath*/,
+                                bool /*present*/,
+                                const std::string& /*name*/) const
+{}
+
+void SimulatedUtil::setAvailable(sdbusplus::bus::bus& /*bus*/,
+                                 const std::string& /*invpath*/,
+                                 bool /*available*/) const
+{}
+
+void SimulatedUtil::handleChassisHealthRollup(sdbusplus::bus::bus& /*bus*/,
+                                              const std::string& /*invpath*/,
+                                              bool /*addRollup*/) const
+{}
+
+} // namespace simulation
+} // namespace psu
+} // namespace power
+} // namespace phosphor
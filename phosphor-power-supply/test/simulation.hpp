@@ -0,0 +1,248 @@
+#pragma once
+
+#include "pmbus.hpp"
+#include "util_base.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace phosphor::power::psu::simulation
+{
+
+/**
+ * @brief The simulated hardware state of one power supply.
+ *
+ * The PMBus and presence GPIO of the power supply read these values.
+ */
+struct Device
+{
+    bool present = true;
+    uint16_t statusWord = 0;
+    uint8_t statusInput = 0;
+    uint8_t statusMFR = 0;
+    uint8_t statusCML = 0;
+    uint8_t statusVout = 0;
+    uint8_t statusIout = 0;
+    uint8_t statusFans12 = 0;
+    uint8_t statusTemperature = 0;
+
+    /** @brief The input voltage, in volts */
+    double inputVoltage = 220.0;
+
+    /** @brief The sequence ID of the newest INPUT_HISTORY record */
+    uint8_t historySequence = 0;
+
+    /** @brief The number of PMBus reads of the device */
+    size_t reads = 0;
+};
+
+/**
+ * @brief The faults a scenario can inject.
+ */
+enum class Fault
+{
+    /** @brief AC input lost: VIN_UV, INPUT, and the unit turns off */
+    vinLoss,
+
+    /** @brief Output overcurrent */
+    ioutOC,
+
+    /** @brief Fan fault */
+    fan,
+
+    /** @brief Over temperature */
+    temperature,
+
+    /** @brief PGOOD# inactive */
+    pgood,
+
+    /** @brief Communication, memory, or logic fault */
+    cml,
+
+    /** @brief IBM PS_Kill fault in STATUS_MFR_SPECIFIC */
+    psKill,
+
+    /** @brief The power supply is pulled */
+    presence
+};
+
+/**
+ * @brief Returns the name of a fault.
+ */
+const char* getFaultName(Fault fault);
+
+/**
+ * @brief Turns a fault on or off in a device.
+ *
+ * @param[in,out] device - The device
+ * @param[in] fault - The fault
+ * @param[in] active - Whether the fault is on
+ */
+void setFault(Device& device, Fault fault, bool active);
+
+/**
+ * @brief A step of a scenario.
+ */
+struct Event
+{
+    /** @brief The tick to apply the event at */
+    size_t tick;
+
+    /** @brief The index of the device */
+    size_t device;
+
+    Fault fault;
+
+    /** @brief Whether the fault turns on or off */
+    bool active;
+};
+
+/**
+ * @brief Builds a scenario that injects one fault into each device.
+ *
+ * The faults rotate through all of the Fault values. Their start ticks are
+ * spread over the ticks, and each one lasts the given number of ticks.
+ *
+ * @param[in] numDevices - The number of devices
+ * @param[in] numTicks - The number of ticks in the scenario
+ * @param[in] duration - The number of ticks each fault lasts
+ *
+ * @return The events, sorted by tick
+ */
+std::vector<Event> makeScenario(size_t numDevices, size_t numTicks,
+                                size_t duration);
+
+/**
+ * @brief The simulated devices, looked up by the PMBus and GPIO factory
+ *        functions when a PowerSupply is created.
+ */
+class Simulation
+{
+  public:
+    /**
+     * @brief Adds a device.
+     *
+     * @param[in] i2cBus - The I2C bus the PowerSupply is created with
+     * @param[in] i2cAddress - The I2C address the PowerSupply is created with
+     * @param[in] gpioLineName - The presence GPIO line name
+     *
+     * @return The device
+     */
+    Device& addDevice(uint8_t i2cBus, uint16_t i2cAddress,
+                      const std::string& gpioLineName);
+
+    /**
+     * @brief Returns the device at an I2C bus and address.
+     *
+     * @param[in] i2cBus - The I2C bus
+     * @param[in] address - The address, as passed to createPMBus()
+     *
+     * @throw std::out_of_range if there is no such device
+     */
+    Device& getDevice(uint8_t i2cBus, const std::string& address);
+
+    /**
+     * @brief Returns the device with a presence GPIO line name.
+     *
+     * @throw std::out_of_range if there is no such device
+     */
+    Device& getDevice(const std::string& gpioLineName);
+
+    /**
+     * @brief Returns all of the devices, in the order they were added.
+     */
+    std::vector<std::unique_ptr<Device>>& getDevices()
+    {
+        return devices;
+    }
+
+  private:
+    struct Entry
+    {
+        uint8_t i2cBus;
+        std::string address;
+        std::string gpioLineName;
+    };
+
+    std::vector<std::unique_ptr<Device>> devices;
+    std::vector<Entry> entries;
+};
+
+/**
+ * @brief Returns the simulation used by createPMBus() and createGPIO().
+ */
+Simulation& getSimulation();
+
+/**
+ * @brief PMBus interface that reads a simulated device.
+ */
+class SimulatedPMBus : public phosphor::pmbus::PMBusBase
+{
+  public:
+    explicit SimulatedPMBus(Device& device) : device(device)
+    {}
+
+    uint64_t read(const std::string& name, phosphor::pmbus::Type type,
+                  bool errTrace = true) override;
+    std::string readString(const std::string& name,
+                           phosphor::pmbus::Type type) override;
+    std::vector<uint8_t> readBinary(const std::string& name,
+                                    phosphor::pmbus::Type type,
+                                    size_t length) override;
+    void writeBinary(const std::string& name, std::vector<uint8_t> data,
+                     phosphor::pmbus::Type type) override;
+    void findHwmonDir() override;
+    const phosphor::pmbus::fs::path& path() const override;
+    std::string insertPageNum(const std::string& templateName,
+                              size_t page) override;
+    phosphor::pmbus::fs::path getPath(phosphor::pmbus::Type type) override;
+
+  private:
+    Device& device;
+    phosphor::pmbus::fs::path basePath{"/sys/bus/i2c/devices/sim"};
+};
+
+/**
+ * @brief Presence GPIO that reads a simulated device.
+ */
+class SimulatedGPIO : public GPIOInterfaceBase
+{
+  public:
+    SimulatedGPIO(Device& device, const std::string& name) :
+        device(device), name(name)
+    {}
+
+    int read() override;
+    void write(int value, std::bitset<32> flags) override;
+    void toggleLowHigh(const std::chrono::milliseconds& delay) override;
+    std::string getName() const override;
+    int requestEvents() override;
+    void readEvents() override;
+
+  private:
+    Device& device;
+    std::string name;
+};
+
+/**
+ * @brief Inventory access that does nothing.
+ */
+class SimulatedUtil : public UtilBase
+{
+  public:
+    bool getPresence(sdbusplus::bus::bus& bus,
+                     const std::string& invpath) const override;
+    void setPresence(sdbusplus::bus::bus& bus, const std::string& invpath,
+                     bool present, const std::string& name) const override;
+    void setAvailable(sdbusplus::bus::bus& bus, const std::string& invpath,
+                      bool available) const override;
+    void handleChassisHealthRollup(sdbusplus::bus::bus& bus,
+                                   const std::string& invpath,
+                                   bool addRollup) const override;
+};
+
+} // namespace phosphor::power::psu::simulation
@@ -0,0 +1,89 @@
+#include "../status_decoder.hpp"
+
+#include <array>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::psu;
+
+namespace
+{
+
+constexpr std::array<StatusFaultDescriptor, 3> testFaults{{
+    {.fault = StatusFault::voutUV,
+     .wordMask = 0x8000,
+     .excludeWordMask = 0x0020,
+     .deglitchLimit = 3},
+    {.fault = StatusFault::pgood,
+     .wordMask = 0x0840,
+     .severity = FaultSeverity::communication,
+     .deglitchLimit = 5},
+    {.fault = StatusFault::psKill,
+     .requiredWordMask = 0x1000,
+     .reg = StatusRegister::mfr,
+     .regMask = 0x10,
+     .severity = FaultSeverity::detail},
+}};
+
+} // namespace
+
+TEST(StatusDecoderTests, Decode)
+{
+    {
+        DecodedStatus decoded;
+        decodeStatus(testFaults, StatusRegisters{}, decoded);
+        EXPECT_EQ(decoded.active, 0);
+        EXPECT_EQ(decoded.held, faultBit(StatusFault::psKill));
+    }
+    // Any bit of wordMask turns the fault on
+    {
+        DecodedStatus decoded;
+        decodeStatus(testFaults, StatusRegisters{.word = 0x0040}, decoded);
+        EXPECT_EQ(decoded.active, faultBit(StatusFault::pgood));
+    }
+    // excludeWordMask turns the fault off
+    {
+        DecodedStatus decoded;
+        decodeStatus(testFaults, StatusRegisters{.word = 0x8000}, decoded);
+        EXPECT_EQ(decoded.active, faultBit(StatusFault::voutUV));
+
+        decoded = DecodedStatus{};
+        decodeStatus(testFaults, StatusRegisters{.word = 0x8020}, decoded);
+        EXPECT_EQ(decoded.active, 0);
+    }
+    // The register bits are only examined with the required STATUS_WORD bits
+    {
+        DecodedStatus decoded;
+        decodeStatus(testFaults, StatusRegisters{.word = 0x1000, .mfr = 0x10},
+                     decoded);
+        EXPECT_EQ(decoded.active, faultBit(StatusFault::psKill));
+        EXPECT_EQ(decoded.held, 0);
+
+        decoded = DecodedStatus{};
+        decodeStatus(testFaults, StatusRegisters{.word = 0x1000, .mfr = 0x01},
+                     decoded);
+        EXPECT_EQ(decoded.active, 0);
+        EXPECT_EQ(decoded.held, 0);
+    }
+    // Several tables accumulate into one result
+    {
+        constexpr std::array<StatusFaultDescriptor, 1> moreFaults{
+            {{.fault = StatusFault::fan, .wordMask = 0x0400}}};
+        DecodedStatus decoded;
+        StatusRegisters regs{.word = 0x8400};
+        decodeStatus(testFaults, regs, decoded);
+        decodeStatus(moreFaults, regs, decoded);
+        EXPECT_EQ(decoded.active,
+                  faultBit(StatusFault::voutUV) | faultBit(StatusFault::fan));
+    }
+}
+
+TEST(StatusDecoderTests, Severity)
+{
+    static_assert(faultsWithSeverity(testFaults, FaultSeverity::fault) ==
+                  faultBit(StatusFault::voutUV));
+    EXPECT_EQ(faultsWithSeverity(testFaults, FaultSeverity::communication),
+              faultBit(StatusFault::pgood));
+    EXPECT_EQ(faultsWithSeverity(testFaults, FaultSeverity::detail),
+              faultBit(StatusFault::psKill));
+}
@@ -0,0 +1,128 @@
+#include "../telemetry_server.hpp"
+
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::manager;
+
+namespace
+{
+
+/**
+ * Connects a client to the telemetry socket.
+ */
+int connectClient(const std::string& path)
+{
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * Receives the frames available to a client without blocking.
+ */
+std::vector<TelemetryFrame> receiveFrames(int fd)
+{
+    std::vector<TelemetryFrame> frames;
+    TelemetryFrame frame;
+    while (recv(fd, &frame, sizeof(frame), MSG_DONTWAIT) ==
+           sizeof(TelemetryFrame))
+    {
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+} // namespace
+
+TEST(TelemetryServerTests, Publish)
+{
+    char dir[] = "/tmp/telemetry_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(dir));
+    std::string path = std::string{dir} + "/telemetry.sock";
+    auto event = sdeventplus::Event::get_new();
+    constexpr auto noWait = std::chrono::microseconds{0};
+
+    {
+        TelemetryServer server{event, path};
+        EXPECT_TRUE(std::filesystem::exists(path));
+        EXPECT_EQ(server.getNumClients(), 0);
+
+        // Publishing without clients does nothing
+        std::vector<TelemetryFrame> frames(2, TelemetryFrame{});
+        frames[0].psuIndex = 0;
+        frames[0].statusWord = 0x0840;
+        frames[1].psuIndex = 1;
+        frames[1].flags = TelemetryServer::flagPresent;
+        server.publish(frames);
+
+        int client = connectClient(path);
+        ASSERT_GE(client, 0);
+        event.run(noWait);
+        EXPECT_EQ(server.getNumClients(), 1);
+
+        server.publish(frames);
+        auto received = receiveFrames(client);
+        ASSERT_EQ(received.size(), 2);
+        EXPECT_EQ(received[0].magic, TelemetryServer::frameMagic);
+        EXPECT_EQ(received[0].version, TelemetryServer::frameVersion);
+        EXPECT_EQ(received[0].size, sizeof(TelemetryFrame));
+        EXPECT_EQ(received[0].dropped, 0);
+        EXPECT_EQ(received[0].psuIndex, 0);
+        EXPECT_EQ(received[0].statusWord, 0x0840);
+        EXPECT_EQ(received[1].psuIndex, 1);
+        EXPECT_EQ(received[1].flags, TelemetryServer::flagPresent);
+
+        // A slow client loses the oldest frames, and every frame is either
+        // received or counted as dropped.
+        constexpr size_t count = 100000;
+        std::vector<TelemetryFrame> many(count, TelemetryFrame{});
+        server.publish(many);
+
+        size_t numReceived = 0;
+        size_t numDropped = 0;
+        for (received = receiveFrames(client); !received.empty();
+             received = receiveFrames(client))
+        {
+            for (const auto& frame : received)
+            {
+                numReceived++;
+                numDropped += frame.dropped;
+            }
+            // Let the server send the rest of its queue
+            event.run(noWait);
+        }
+        EXPECT_GT(numDropped, 0);
+        EXPECT_LE(numReceived, count);
+        EXPECT_EQ(numReceived + numDropped, count);
+
+        // Closing the connection removes the client
+        close(client);
+        event.run(noWait);
+        EXPECT_EQ(server.getNumClients(), 0);
+        server.publish(frames);
+    }
+
+    // The socket is removed with the server
+    EXPECT_FALSE(std::filesystem::exists(path));
+    std::filesystem::remove_all(dir);
+
+    EXPECT_THROW((TelemetryServer{event, ""}), std::runtime_error);
+}
@@ -0,0 +1,65 @@
+#include "../worker_pool.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::manager;
+
+TEST(WorkerPoolTests, Run)
+{
+    WorkerPool pool{3};
+    EXPECT_EQ(pool.size(), 3);
+
+    // Test where there are no tasks
+    {
+        std::vector<WorkerPool::Task> tasks;
+        pool.run(tasks);
+    }
+
+    // Test where there are more tasks than threads. Run several batches.
+    for (auto batch = 0; batch < 10; batch++)
+    {
+        std::atomic<int> count{0};
+        std::vector<WorkerPool::Task> tasks;
+        for (auto i = 0; i < 8; i++)
+        {
+            tasks.emplace_back([&count]() { count++; });
+        }
+        pool.run(tasks);
+        EXPECT_EQ(count, 8);
+    }
+
+    // Test where the tasks run on the worker threads
+    {
+        std::thread::id taskThread;
+        std::vector<WorkerPool::Task> tasks;
+        tasks.emplace_back(
+            [&taskThread]() { taskThread = std::this_thread::get_id(); });
+        pool.run(tasks);
+        EXPECT_NE(taskThread, std::this_thread::get_id());
+    }
+
+    // Test where a task throws an exception. The other tasks still run.
+    {
+        std::atomic<int> count{0};
+        std::vector<WorkerPool::Task> tasks;
+        tasks.emplace_back([]() { throw std::runtime_error{"Read failed"}; });
+        tasks.emplace_back([&count]() { count++; });
+        tasks.emplace_back([&count]() { count++; });
+        EXPECT_THROW(pool.run(tasks), std::runtime_error);
+        EXPECT_EQ(count, 2);
+    }
+
+    // Test where the pool is used again after an exception
+    {
+        std::atomic<int> count{0};
+        std::vector<WorkerPool::Task> tasks;
+        tasks.emplace_back([&count]() { count++; });
+        pool.run(tasks);
+        EXPECT_EQ(count, 1);
+    }
+}
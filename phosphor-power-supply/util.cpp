@@ -51,6 +51,23 @@ int GPIOInterface::read()
         throw std::runtime_error{std::string{"Failed to find line"}};
     }
 
+    if (eventsRequested)
+    {
+        // Line is already requested for events, just get the value.
+        try
+        {
+            value = line.get_value();
+        }
+        catch (const std::exception& e)
+        {
+            log<level::ERR>(
+                fmt::format("Failed to get_value of GPIO line: {}", e.what())
+                    .c_str());
+            throw;
+        }
+        return value;
+    }
+
     try
     {
         line.request({__FUNCTION__, gpiod::line_request::DIRECTION_INPUT,
@@ -114,6 +131,51 @@ void GPIOInterface::toggleLowHigh(const std::chrono::milliseconds& delay)
     write(1, flags);
 }
 
+int GPIOInterface::requestEvents()
+{
+    using namespace phosphor::logging;
+
+    if (!line)
+    {
+        log<level::ERR>("Failed line");
+        throw std::runtime_error{std::string{"Failed to find line"}};
+    }
+
+    if (!eventsRequested)
+    {
+        try
+        {
+            line.request({__FUNCTION__,
+                          gpiod::line_request::EVENT_BOTH_EDGES,
+                          gpiod::line_request::FLAG_ACTIVE_LOW});
+            eventsRequested = true;
+        }
+        catch (const std::exception& e)
+        {
+            log<level::ERR>("Failed to request GPIO line events",
+                            entry("MSG=%s", e.what()));
+            throw;
+        }
+    }
+
+    return line.event_get_fd();
+}
+
+void GPIOInterface::readEvents()
+{
+    if (!eventsRequested)
+    {
+        throw std::runtime_error{
+            std::string{"GPIO line not requested for events"}};
+    }
+
+    // Drain all pending events.  Only the current line value matters.
+    while (line.event_wait(std::chrono::nanoseconds(0)))
+    {
+        line.event_read();
+    }
+}
+
 std::unique_ptr<GPIOInterfaceBase> createGPIO(const std::string& namedGpio)
 {
     return GPIOInterface::createGPIO(namedGpio);
@@ -1,4 +1,5 @@
 #pragma once
+#include "inventory_cache.hpp"
 #include "util_base.hpp"
 #include "utility.hpp"
 #include "xyz/openbmc_project/Common/error.hpp"
@@ -42,23 +43,18 @@ class Util : public UtilBase
     void setPresence(sdbusplus::bus::bus& bus, const std::string& invpath,
                      bool present, const std::string& name) const override
     {
-        using InternalFailure =
-            sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
-        PropertyMap invProp;
+        InventoryCache::PropertyMap invProp;
 
         invProp.emplace("Present", present);
         invProp.emplace("PrettyName", name);
 
-        InterfaceMap invIntf;
+        InventoryCache::InterfaceMap invIntf;
         invIntf.emplace("xyz.openbmc_project.Inventory.Item",
                         std::move(invProp));
 
         Interface extraIface = "xyz.openbmc_project.Inventory.Item.PowerSupply";
 
-        invIntf.emplace(extraIface, PropertyMap());
-
-        ObjectMap invObj;
-        invObj.emplace(std::move(invpath), std::move(invIntf));
+        invIntf.emplace(extraIface, InventoryCache::PropertyMap());
 
         using namespace phosphor::logging;
         log<level::INFO>(fmt::format("Updating inventory present property. "
@@ -66,63 +62,21 @@ class Util : public UtilBase
                                      present, invpath, name)
                              .c_str());
 
-        try
-        {
-            auto invService = phosphor::power::util::getService(
-                INVENTORY_OBJ_PATH, INVENTORY_MGR_IFACE, bus);
-
-            // Update inventory
-            auto invMsg =
-                bus.new_method_call(invService.c_str(), INVENTORY_OBJ_PATH,
-                                    INVENTORY_MGR_IFACE, "Notify");
-            invMsg.append(std::move(invObj));
-            auto invMgrResponseMsg = bus.call(invMsg);
-        }
-        catch (const std::exception& e)
-        {
-            log<level::ERR>(
-                fmt::format(
-                    "Error in inventory manager call to update inventory: {}",
-                    e.what())
-                    .c_str());
-            elog<InternalFailure>();
-        }
+        // Only changed properties are sent.  A failed update is logged and
+        // retried by the inventory cache.
+        getInventoryCache().update(bus, invpath, invIntf);
     }
 
     void setAvailable(sdbusplus::bus::bus& bus, const std::string& invpath,
                       bool available) const override
     {
-        PropertyMap invProp;
-        InterfaceMap invIntf;
-        ObjectMap invObj;
+        InventoryCache::PropertyMap invProp;
+        InventoryCache::InterfaceMap invIntf;
 
         invProp.emplace(AVAILABLE_PROP, available);
         invIntf.emplace(AVAILABILITY_IFACE, std::move(invProp));
 
-        invObj.emplace(std::move(invpath), std::move(invIntf));
-
-        try
-        {
-
-            auto invService = phosphor::power::util::getService(
-                INVENTORY_OBJ_PATH, INVENTORY_MGR_IFACE, bus);
-
-            auto invMsg =
-                bus.new_method_call(invService.c_str(), INVENTORY_OBJ_PATH,
-                                    INVENTORY_MGR_IFACE, "Notify");
-            invMsg.append(std::move(invObj));
-            auto invMgrResponseMsg = bus.call(invMsg);
-        }
-        catch (const sdbusplus::exception::exception& e)
-        {
-            using namespace phosphor::logging;
-            log<level::ERR>(
-                fmt::format("Error in inventory manager call to update "
-                            "availability interface: {}",
-                            e.what())
-                    .c_str());
-            throw;
-        }
+        getInventoryCache().update(bus, invpath, invIntf);
     }
 
     void handleChassisHealthRollup(sdbusplus::bus::bus& bus,
@@ -274,8 +228,31 @@ class GPIOInterface : public GPIOInterfaceBase
      */
     std::string getName() const override;
 
+    /**
+     * @brief Requests the GPIO line as an input with both-edge events.
+     *
+     * The line remains requested, so later calls to read() get the value
+     * without requesting the line again.
+     *
+     * Throws an exception if line not found or request line fails.
+     *
+     * @return File descriptor that becomes readable when an event occurs.
+     */
+    int requestEvents() override;
+
+    /**
+     * @brief Reads and discards all pending events on the GPIO line.
+     *
+     * Throws an exception if events were not requested or reading an event
+     * fails.
+     */
+    void readEvents() override;
+
   private:
     gpiod::line line;
+
+    /** @brief True if the line has been requested for events. */
+    bool eventsRequested = false;
 };
 
 } // namespace phosphor::power::psu
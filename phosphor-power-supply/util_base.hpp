@@ -70,6 +70,8 @@ class GPIOInterfaceBase
     virtual void write(int value, std::bitset<32> flags) = 0;
     virtual void toggleLowHigh(const std::chrono::milliseconds& delay) = 0;
     virtual std::string getName() const = 0;
+    virtual int requestEvents() = 0;
+    virtual void readEvents() = 0;
 };
 
 } // namespace phosphor::power::psu
@@ -0,0 +1,93 @@
+#include "worker_pool.hpp"
+
+#include <utility>
+
+namespace phosphor::power::manager
+{
+
+WorkerPool::WorkerPool(size_t threadCount)
+{
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        threads.emplace_back(&WorkerPool::work, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard lock{mutex};
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerPool::run(const std::vector<Task>& batch)
+{
+    if (batch.empty())
+    {
+        return;
+    }
+
+    std::unique_lock lock{mutex};
+    tasks = &batch;
+    nextTask = 0;
+    remainingTasks = batch.size();
+    error = nullptr;
+    taskAvailable.notify_all();
+
+    batchDone.wait(lock, [this]() { return remainingTasks == 0; });
+    tasks = nullptr;
+
+    if (error)
+    {
+        std::rethrow_exception(std::exchange(error, nullptr));
+    }
+}
+
+void WorkerPool::work()
+{
+    std::unique_lock lock{mutex};
+    while (true)
+    {
+        taskAvailable.wait(lock, [this]() {
+            return stopping ||
+                   ((tasks != nullptr) && (nextTask < tasks->size()));
+        });
+        if (stopping)
+        {
+            return;
+        }
+
+        const auto& task = (*tasks)[nextTask++];
+        lock.unlock();
+
+        std::exception_ptr taskError;
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            taskError = std::current_exception();
+        }
+
+        lock.lock();
+        if (taskError && !error)
+        {
+            error = taskError;
+        }
+        if (--remainingTasks == 0)
+        {
+            batchDone.notify_one();
+        }
+    }
+}
+
+} // namespace phosphor::power::manager
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace phosphor::power::manager
+{
+
+/**
+ * @class WorkerPool
+ *
+ * A small, fixed size pool of threads that runs a batch of tasks and waits
+ * for all of them to finish.
+ *
+ * Only one batch runs at a time. The tasks must not access D-Bus or any
+ * state used by another task in the same batch.
+ */
+class WorkerPool
+{
+  public:
+    using Task = std::function<void()>;
+
+    WorkerPool() = delete;
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    /**
+     * Constructor
+     *
+     * @param[in] threadCount - The number of worker threads to start
+     */
+    explicit WorkerPool(size_t threadCount);
+
+    /**
+     * Destructor. Stops and joins the worker threads.
+     */
+    ~WorkerPool();
+
+    /**
+     * Runs the tasks on the worker threads and waits for all of them to
+     * finish.
+     *
+     * If a task throws an exception, the remaining tasks still run, and the
+     * first exception is rethrown once they are done.
+     *
+     * @param[in] tasks - The tasks to run
+     */
+    void run(const std::vector<Task>& tasks);
+
+    /**
+     * Returns the number of worker threads.
+     */
+    size_t size() const
+    {
+        return threads.size();
+    }
+
+  private:
+    /**
+     * The function run by each worker thread.
+     */
+    void work();
+
+    /** @brief The worker threads */
+    std::vector<std::thread> threads;
+
+    /** @brief Protects the members below */
+    std::mutex mutex;
+
+    /** @brief Signals the workers that tasks are available or to stop */
+    std::condition_variable taskAvailable;
+
+    /** @brief Signals run() that all of the tasks finished */
+    std::condition_variable batchDone;
+
+    /** @brief The tasks of the current batch */
+    const std::vector<Task>* tasks = nullptr;
+
+    /** @brief Index of the next task to start */
+    size_t nextTask = 0;
+
+    /** @brief Number of tasks of the current batch that are not done */
+    size_t remainingTasks = 0;
+
+    /** @brief The first exception thrown by a task of the current batch */
+    std::exception_ptr error;
+
+    /** @brief Set to stop the worker threads */
+    bool stopping = false;
+};
+
+} // namespace phosphor::power::manager
@@ -17,6 +17,8 @@
 
 #include "action.hpp"
 #include "action_environment.hpp"
+#include "profiler.hpp"
+#include "services.hpp"
 
 #include <memory>
 #include <vector>
@@ -37,6 +39,8 @@ namespace phosphor::power::regulators::action_utils
  * Throws an exception if an error occurs and an action cannot be
  * successfully executed.
  *
+ * If profiling is enabled, the execution time of each action is recorded.
+ *
  * @param actions actions to execute
  * @param environment action execution environment
  * @return return value from last action in vector
@@ -45,8 +49,10 @@ inline bool execute(std::vector<std::unique_ptr<Action>>& actions,
                     ActionEnvironment& environment)
 {
     bool returnValue{true};
+    Profiler& profiler = environment.getServices().getProfiler();
     for (std::unique_ptr<Action>& action : actions)
     {
+        ProfileScope scope{profiler, *action};
         returnValue = action->execute(environment);
     }
     return returnValue;
@@ -28,19 +28,14 @@ namespace phosphor::power::regulators
 
 bool I2CCaptureBytesAction::execute(ActionEnvironment& environment)
 {
+    uint8_t values[UINT8_MAX];
     try
     {
         // Read device register values.  Use I2C mode where the number of bytes
         // to read is explicitly specified.
         i2c::I2CInterface& interface = getI2CInterface(environment);
         uint8_t size{count}; // byte count parameter is input/output
-        uint8_t values[UINT8_MAX];
         interface.read(reg, size, values, i2c::I2CInterface::Mode::I2C);
-
-        // Store error data in action environment as a string key/value pair
-        std::string key = getErrorDataKey(environment);
-        std::string value = getErrorDataValue(values);
-        environment.addAdditionalErrorData(key, value);
     }
     catch (const i2c::I2CException& e)
     {
@@ -48,6 +43,16 @@ bool I2CCaptureBytesAction::execute(ActionEnvironment& environment)
         // low level I2C error information and the action information
         std::throw_with_nested(ActionError(*this));
     }
+    return processRegisterValues(environment, values);
+}
+
+bool I2CCaptureBytesAction::processRegisterValues(
+    ActionEnvironment& environment, const uint8_t* registerValues)
+{
+    // Store error data in action environment as a string key/value pair
+    std::string key = getErrorDataKey(environment);
+    std::string value = getErrorDataValue(registerValues);
+    environment.addAdditionalErrorData(key, value);
     return true;
 }
 
@@ -16,7 +16,7 @@
 #pragma once
 
 #include "action_environment.hpp"
-#include "i2c_action.hpp"
+#include "i2c_read_action.hpp"
 
 #include <cstdint>
 #include <stdexcept>
@@ -33,7 +33,7 @@ namespace phosphor::power::regulators
  *
  * Implements the i2c_capture_bytes action in the JSON config file.
  */
-class I2CCaptureBytesAction : public I2CAction
+class I2CCaptureBytesAction : public I2CReadAction
 {
   public:
     // Specify which compiler-generated methods we want
@@ -97,11 +97,21 @@ class I2CCaptureBytesAction : public I2CAction
      *
      * @return register address
      */
-    uint8_t getRegister() const
+    virtual uint8_t getRegister() const override
     {
         return reg;
     }
 
+    /** @copydoc I2CReadAction::getReadSize() */
+    virtual uint8_t getReadSize() const override
+    {
+        return count;
+    }
+
+    /** @copydoc I2CReadAction::processRegisterValues() */
+    virtual bool processRegisterValues(ActionEnvironment& environment,
+                                       const uint8_t* registerValues) override;
+
     /**
      * Returns a string description of this action.
      *
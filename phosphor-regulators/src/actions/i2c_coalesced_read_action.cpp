@@ -0,0 +1,103 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "i2c_coalesced_read_action.hpp"
+
+#include "action_error.hpp"
+#include "i2c_interface.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <ios>
+#include <sstream>
+#include <utility>
+
+namespace phosphor::power::regulators
+{
+
+I2CCoalescedReadAction::I2CCoalescedReadAction(
+    std::vector<std::unique_ptr<I2CReadAction>> actions) :
+    actions{std::move(actions)}
+{
+    // Actions vector must not be empty
+    if (this->actions.empty())
+    {
+        throw std::invalid_argument{"Actions vector is empty"};
+    }
+
+    // Find the range of registers used by all the actions
+    unsigned int first{UINT8_MAX}, end{0};
+    for (const std::unique_ptr<I2CReadAction>& action : this->actions)
+    {
+        unsigned int actionReg = action->getRegister();
+        first = std::min(first, actionReg);
+        end = std::max(end, actionReg + action->getReadSize());
+    }
+
+    // Register range must fit within one I2C block read
+    if ((end - first) > maxReadSize)
+    {
+        throw std::invalid_argument{"Register range too large: " +
+                                    std::to_string(end - first)};
+    }
+
+    reg = static_cast<uint8_t>(first);
+    size = static_cast<uint8_t>(end - first);
+}
+
+bool I2CCoalescedReadAction::execute(ActionEnvironment& environment)
+{
+    uint8_t values[maxReadSize];
+    try
+    {
+        // Read all device register values.  Use I2C mode where the number of
+        // bytes to read is explicitly specified.
+        i2c::I2CInterface& interface = getI2CInterface(environment);
+        uint8_t readSize{size}; // byte count parameter is input/output
+        interface.read(reg, readSize, values, i2c::I2CInterface::Mode::I2C);
+    }
+    catch (const i2c::I2CException& e)
+    {
+        // Nest I2CException within an ActionError for the first action.  This
+        // is the action that would have failed if executed individually.
+        std::throw_with_nested(ActionError(*(actions.front())));
+    }
+
+    // Pass each action its portion of the register values
+    bool returnValue{true};
+    for (std::unique_ptr<I2CReadAction>& action : actions)
+    {
+        const uint8_t* actionValues = values + (action->getRegister() - reg);
+        returnValue = action->processRegisterValues(environment, actionValues);
+    }
+    return returnValue;
+}
+
+std::string I2CCoalescedReadAction::toString() const
+{
+    std::ostringstream ss;
+    ss << "i2c_coalesced_read: { register: 0x" << std::hex << std::uppercase
+       << static_cast<uint16_t>(reg) << ", count: " << std::dec
+       << static_cast<uint16_t>(size) << ", actions: [ ";
+    for (unsigned int i = 0; i < actions.size(); ++i)
+    {
+        ss << ((i > 0) ? ", " : "") << actions[i]->toString();
+    }
+    ss << " ] }";
+    return ss.str();
+}
+
+} // namespace phosphor::power::regulators
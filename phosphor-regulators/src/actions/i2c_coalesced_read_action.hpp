@@ -0,0 +1,148 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "action_environment.hpp"
+#include "i2c_action.hpp"
+#include "i2c_read_action.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace phosphor::power::regulators
+{
+
+/**
+ * @class I2CCoalescedReadAction
+ *
+ * Executes a sequence of I2C read actions using a single I2C read operation.
+ *
+ * All device registers from the lowest register to the highest register used
+ * by the actions are read in one I2C block read.  Each action then processes
+ * its portion of the register values.
+ *
+ * This action is not specified in the JSON config file.  It is created by the
+ * config file parser when a rule enables the "coalesce_i2c_reads" property.
+ * See i2c_read_optimizer::optimize() for more information.
+ */
+class I2CCoalescedReadAction : public I2CAction
+{
+  public:
+    /**
+     * Maximum number of bytes that can be read in one I2C block read.
+     */
+    static constexpr uint8_t maxReadSize{32};
+
+    // Specify which compiler-generated methods we want
+    I2CCoalescedReadAction() = delete;
+    I2CCoalescedReadAction(const I2CCoalescedReadAction&) = delete;
+    I2CCoalescedReadAction(I2CCoalescedReadAction&&) = delete;
+    I2CCoalescedReadAction& operator=(const I2CCoalescedReadAction&) = delete;
+    I2CCoalescedReadAction& operator=(I2CCoalescedReadAction&&) = delete;
+    virtual ~I2CCoalescedReadAction() = default;
+
+    /**
+     * Constructor.
+     *
+     * Throws an exception if any of the input parameters are invalid.
+     *
+     * @param actions I2C read actions to execute.  Must contain at least one
+     *                action.  The registers used by the actions must fit within
+     *                a range of maxReadSize bytes.
+     */
+    explicit I2CCoalescedReadAction(
+        std::vector<std::unique_ptr<I2CReadAction>> actions);
+
+    /**
+     * Executes the actions specified in the constructor.
+     *
+     * Reads the device registers using one I2C operation.  Then passes the
+     * register values to each action in order.
+     *
+     * Note: All of the actions will be executed even if an action before the
+     * end returns false.  This matches the behavior of executing the actions
+     * individually.
+     *
+     * If the I2C read fails, an ActionError describing the first action is
+     * thrown.  This matches the error that would have occurred if the actions
+     * were executed individually.
+     *
+     * The device is obtained from the specified action environment.
+     *
+     * @param environment action execution environment
+     * @return return value of the last action
+     */
+    virtual bool execute(ActionEnvironment& environment) override;
+
+    /**
+     * Returns the I2C read actions to execute.
+     *
+     * @return actions to execute
+     */
+    const std::vector<std::unique_ptr<I2CReadAction>>& getActions() const
+    {
+        return actions;
+    }
+
+    /**
+     * Returns the address of the first device register to read.
+     *
+     * @return register address
+     */
+    uint8_t getRegister() const
+    {
+        return reg;
+    }
+
+    /**
+     * Returns the number of register bytes to read.
+     *
+     * @return number of bytes
+     */
+    uint8_t getReadSize() const
+    {
+        return size;
+    }
+
+    /**
+     * Returns a string description of this action.
+     *
+     * @return description of action
+     */
+    virtual std::string toString() const override;
+
+  private:
+    /**
+     * I2C read actions to execute.
+     */
+    std::vector<std::unique_ptr<I2CReadAction>> actions{};
+
+    /**
+     * Address of the first device register to read.  Note: named 'reg'
+     * because 'register' is a reserved keyword.
+     */
+    uint8_t reg{0x00};
+
+    /**
+     * Number of register bytes to read.
+     */
+    uint8_t size{0};
+};
+
+} // namespace phosphor::power::regulators
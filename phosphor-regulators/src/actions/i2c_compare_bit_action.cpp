@@ -28,19 +28,12 @@ namespace phosphor::power::regulators
 
 bool I2CCompareBitAction::execute(ActionEnvironment& environment)
 {
-    bool isEqual{false};
+    uint8_t registerValue{0x00};
     try
     {
         // Read actual value of device register
-        uint8_t registerValue{0x00};
         i2c::I2CInterface& interface = getI2CInterface(environment);
         interface.read(reg, registerValue);
-
-        // Get actual bit value
-        uint8_t actualValue = (registerValue >> position) & 0x01;
-
-        // Check if actual bit value equals expected bit value
-        isEqual = (actualValue == value);
     }
     catch (const i2c::I2CException& e)
     {
@@ -48,7 +41,17 @@ bool I2CCompareBitAction::execute(ActionEnvironment& environment)
         // low level I2C error information and the action information
         std::throw_with_nested(ActionError(*this));
     }
-    return isEqual;
+    return processRegisterValues(environment, &registerValue);
+}
+
+bool I2CCompareBitAction::processRegisterValues(
+    ActionEnvironment& /*environment*/, const uint8_t* registerValues)
+{
+    // Get actual bit value
+    uint8_t actualValue = (registerValues[0] >> position) & 0x01;
+
+    // Check if actual bit value equals expected bit value
+    return (actualValue == value);
 }
 
 std::string I2CCompareBitAction::toString() const
@@ -16,7 +16,7 @@
 #pragma once
 
 #include "action_environment.hpp"
-#include "i2c_action.hpp"
+#include "i2c_read_action.hpp"
 
 #include <cstdint>
 #include <stdexcept>
@@ -33,7 +33,7 @@ namespace phosphor::power::regulators
  *
  * Implements the i2c_compare_bit action in the JSON config file.
  */
-class I2CCompareBitAction : public I2CAction
+class I2CCompareBitAction : public I2CReadAction
 {
   public:
     // Specify which compiler-generated methods we want
@@ -96,11 +96,17 @@ class I2CCompareBitAction : public I2CAction
      *
      * @return register address
      */
-    uint8_t getRegister() const
+    virtual uint8_t getRegister() const override
     {
         return reg;
     }
 
+    /** @copydoc I2CReadAction::getReadSize() */
+    virtual uint8_t getReadSize() const override
+    {
+        return 1;
+    }
+
     /**
      * Returns the bit position.
      *
@@ -125,6 +131,10 @@ class I2CCompareBitAction : public I2CAction
         return value;
     }
 
+    /** @copydoc I2CReadAction::processRegisterValues() */
+    virtual bool processRegisterValues(ActionEnvironment& environment,
+                                       const uint8_t* registerValues) override;
+
     /**
      * Returns a string description of this action.
      *
@@ -28,19 +28,12 @@ namespace phosphor::power::regulators
 
 bool I2CCompareByteAction::execute(ActionEnvironment& environment)
 {
-    bool isEqual{false};
+    uint8_t actualValue{0x00};
     try
     {
         // Read actual value of device register
-        uint8_t actualValue{0x00};
         i2c::I2CInterface& interface = getI2CInterface(environment);
         interface.read(reg, actualValue);
-
-        // Modify actual value to only include bits specified in the mask
-        actualValue &= mask;
-
-        // Check if actual value equals expected value
-        isEqual = (actualValue == value);
     }
     catch (const i2c::I2CException& e)
     {
@@ -48,7 +41,17 @@ bool I2CCompareByteAction::execute(ActionEnvironment& environment)
         // low level I2C error information and the action information
         std::throw_with_nested(ActionError(*this));
     }
-    return isEqual;
+    return processRegisterValues(environment, &actualValue);
+}
+
+bool I2CCompareByteAction::processRegisterValues(
+    ActionEnvironment& /*environment*/, const uint8_t* registerValues)
+{
+    // Modify actual value to only include bits specified in the mask
+    uint8_t actualValue = registerValues[0] & mask;
+
+    // Check if actual value equals expected value
+    return (actualValue == value);
 }
 
 std::string I2CCompareByteAction::toString() const
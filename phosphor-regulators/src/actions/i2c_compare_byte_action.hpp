@@ -16,7 +16,7 @@
 #pragma once
 
 #include "action_environment.hpp"
-#include "i2c_action.hpp"
+#include "i2c_read_action.hpp"
 
 #include <cstdint>
 #include <string>
@@ -32,7 +32,7 @@ namespace phosphor::power::regulators
  *
  * Implements the i2c_compare_byte action in the JSON config file.
  */
-class I2CCompareByteAction : public I2CAction
+class I2CCompareByteAction : public I2CReadAction
 {
   public:
     // Specify which compiler-generated methods we want
@@ -83,11 +83,17 @@ class I2CCompareByteAction : public I2CAction
      *
      * @return register address
      */
-    uint8_t getRegister() const
+    virtual uint8_t getRegister() const override
     {
         return reg;
     }
 
+    /** @copydoc I2CReadAction::getReadSize() */
+    virtual uint8_t getReadSize() const override
+    {
+        return 1;
+    }
+
     /**
      * Returns the expected byte value.
      *
@@ -111,6 +117,10 @@ class I2CCompareByteAction : public I2CAction
         return mask;
     }
 
+    /** @copydoc I2CReadAction::processRegisterValues() */
+    virtual bool processRegisterValues(ActionEnvironment& environment,
+                                       const uint8_t* registerValues) override;
+
     /**
      * Returns a string description of this action.
      *
@@ -28,25 +28,14 @@ namespace phosphor::power::regulators
 
 bool I2CCompareBytesAction::execute(ActionEnvironment& environment)
 {
-    bool isEqual{true};
+    uint8_t actualValues[UINT8_MAX];
     try
     {
         // Read actual device register values.  Use I2C mode where the number of
         // bytes to read is explicitly specified.
         i2c::I2CInterface& interface = getI2CInterface(environment);
         uint8_t size = values.size();
-        uint8_t actualValues[UINT8_MAX];
         interface.read(reg, size, actualValues, i2c::I2CInterface::Mode::I2C);
-
-        // Compare actual byte values to expected byte values
-        for (unsigned int i = 0; i < values.size(); ++i)
-        {
-            if ((actualValues[i] & masks[i]) != values[i])
-            {
-                isEqual = false;
-                break;
-            }
-        }
     }
     catch (const i2c::I2CException& e)
     {
@@ -54,7 +43,21 @@ bool I2CCompareBytesAction::execute(ActionEnvironment& environment)
         // low level I2C error information and the action information
         std::throw_with_nested(ActionError(*this));
     }
-    return isEqual;
+    return processRegisterValues(environment, actualValues);
+}
+
+bool I2CCompareBytesAction::processRegisterValues(
+    ActionEnvironment& /*environment*/, const uint8_t* registerValues)
+{
+    // Compare actual byte values to expected byte values
+    for (unsigned int i = 0; i < values.size(); ++i)
+    {
+        if ((registerValues[i] & masks[i]) != values[i])
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 std::string I2CCompareBytesAction::toString() const
@@ -16,7 +16,7 @@
 #pragma once
 
 #include "action_environment.hpp"
-#include "i2c_action.hpp"
+#include "i2c_read_action.hpp"
 
 #include <cstdint>
 #include <stdexcept>
@@ -34,7 +34,7 @@ namespace phosphor::power::regulators
  *
  * Implements the i2c_compare_bytes action in the JSON config file.
  */
-class I2CCompareBytesAction : public I2CAction
+class I2CCompareBytesAction : public I2CReadAction
 {
   public:
     // Specify which compiler-generated methods we want
@@ -123,11 +123,17 @@ class I2CCompareBytesAction : public I2CAction
      *
      * @return register address
      */
-    uint8_t getRegister() const
+    virtual uint8_t getRegister() const override
     {
         return reg;
     }
 
+    /** @copydoc I2CReadAction::getReadSize() */
+    virtual uint8_t getReadSize() const override
+    {
+        return static_cast<uint8_t>(values.size());
+    }
+
     /**
      * Returns the expected byte values.
      *
@@ -152,6 +158,10 @@ class I2CCompareBytesAction : public I2CAction
         return masks;
     }
 
+    /** @copydoc I2CReadAction::processRegisterValues() */
+    virtual bool processRegisterValues(ActionEnvironment& environment,
+                                       const uint8_t* registerValues) override;
+
     /**
      * Returns a string description of this action.
      *
@@ -0,0 +1,78 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "action_environment.hpp"
+#include "i2c_action.hpp"
+
+#include <cstdint>
+
+namespace phosphor::power::regulators
+{
+
+/**
+ * @class I2CReadAction
+ *
+ * Abstract base class for I2C actions that only read device registers.
+ *
+ * The register values are read by execute().  The values are then passed to
+ * processRegisterValues(), which performs the remaining work of the action.
+ *
+ * Splitting the action into these two steps allows one I2C read to be
+ * performed for a sequence of actions that read adjacent registers.  See
+ * I2CCoalescedReadAction for more information.
+ */
+class I2CReadAction : public I2CAction
+{
+  public:
+    // Specify which compiler-generated methods we want
+    I2CReadAction() = default;
+    I2CReadAction(const I2CReadAction&) = delete;
+    I2CReadAction(I2CReadAction&&) = delete;
+    I2CReadAction& operator=(const I2CReadAction&) = delete;
+    I2CReadAction& operator=(I2CReadAction&&) = delete;
+    virtual ~I2CReadAction() = default;
+
+    /**
+     * Returns the address of the first device register read by this action.
+     *
+     * @return register address
+     */
+    virtual uint8_t getRegister() const = 0;
+
+    /**
+     * Returns the number of consecutive register bytes read by this action.
+     *
+     * @return number of bytes
+     */
+    virtual uint8_t getReadSize() const = 0;
+
+    /**
+     * Performs the work of this action using register values that have already
+     * been read from the device.
+     *
+     * Throws an exception if an error occurs.
+     *
+     * @param environment action execution environment
+     * @param registerValues register values.  Contains getReadSize() bytes
+     *                       starting with the value of register getRegister().
+     * @return return value of the action
+     */
+    virtual bool processRegisterValues(ActionEnvironment& environment,
+                                       const uint8_t* registerValues) = 0;
+};
+
+} // namespace phosphor::power::regulators
@@ -17,6 +17,12 @@
 #include "if_action.hpp"
 
 #include "action_utils.hpp"
+#include "and_action.hpp"
+#include "compare_presence_action.hpp"
+#include "compare_vpd_action.hpp"
+#include "not_action.hpp"
+#include "or_action.hpp"
+#include "services.hpp"
 
 namespace phosphor::power::regulators
 {
@@ -26,7 +32,7 @@ bool IfAction::execute(ActionEnvironment& environment)
     bool returnValue{true};
 
     // Execute condition action and check whether it returned true
-    if (conditionAction->execute(environment) == true)
+    if (executeCondition(environment) == true)
     {
         // Condition was true; execute actions in "then" clause
         returnValue = action_utils::execute(thenActions, environment);
@@ -49,4 +55,76 @@ bool IfAction::execute(ActionEnvironment& environment)
     return returnValue;
 }
 
+bool IfAction::executeCondition(ActionEnvironment& environment)
+{
+    if (!conditionCacheable)
+    {
+        return conditionAction->execute(environment);
+    }
+
+    // Get current cache epochs.  If they have not changed since the condition
+    // result was cached, the presence data and VPD values have not changed.
+    Services& services = environment.getServices();
+    uint64_t currentPresenceEpoch =
+        services.getPresenceService().getCacheEpoch();
+    uint64_t currentVPDEpoch = services.getVPD().getCacheEpoch();
+    if (cachedConditionResult.has_value() &&
+        (presenceEpoch == currentPresenceEpoch) &&
+        (vpdEpoch == currentVPDEpoch))
+    {
+        return *cachedConditionResult;
+    }
+
+    // Execute condition action.  Result is not cached if an exception occurs.
+    cachedConditionResult.reset();
+    bool result = conditionAction->execute(environment);
+
+    // Cache result along with the epochs after executing the condition.
+    // Executing the condition may have added values to the caches.
+    cachedConditionResult = result;
+    presenceEpoch = services.getPresenceService().getCacheEpoch();
+    vpdEpoch = services.getVPD().getCacheEpoch();
+    return result;
+}
+
+bool IfAction::isCacheable(const Action& action)
+{
+    if ((dynamic_cast<const ComparePresenceAction*>(&action) != nullptr) ||
+        (dynamic_cast<const CompareVPDAction*>(&action) != nullptr))
+    {
+        return true;
+    }
+
+    if (auto andAction = dynamic_cast<const AndAction*>(&action))
+    {
+        for (const std::unique_ptr<Action>& subAction : andAction->getActions())
+        {
+            if (!isCacheable(*subAction))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (auto orAction = dynamic_cast<const OrAction*>(&action))
+    {
+        for (const std::unique_ptr<Action>& subAction : orAction->getActions())
+        {
+            if (!isCacheable(*subAction))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (auto notAction = dynamic_cast<const NotAction*>(&action))
+    {
+        return isCacheable(*(notAction->getAction()));
+    }
+
+    return false;
+}
+
 } // namespace phosphor::power::regulators
@@ -18,7 +18,9 @@
 #include "action.hpp"
 #include "action_environment.hpp"
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -46,6 +48,11 @@ namespace phosphor::power::regulators
  *
  * If the condition is false, the actions in the "else" clause are executed (if
  * specified).
+ *
+ * If the condition only tests hardware presence and VPD values, the result of
+ * the condition is cached.  The condition is re-evaluated when the cached
+ * presence data or VPD values change.  See isConditionCacheable() for more
+ * information.
  */
 class IfAction : public Action
 {
@@ -71,7 +78,9 @@ class IfAction : public Action
                           std::vector<std::unique_ptr<Action>>{}) :
         conditionAction{std::move(conditionAction)},
         thenActions{std::move(thenActions)}, elseActions{std::move(elseActions)}
-    {}
+    {
+        conditionCacheable = isCacheable(*(this->conditionAction));
+    }
 
     /**
      * Executes the condition action specified in the constructor.
@@ -84,6 +93,10 @@ class IfAction : public Action
      * will be executed.  Returns the return value of the last action in the
      * "else" clause.  If no "else" clause was specified, returns false.
      *
+     * If the condition is cacheable and the presence data and VPD values have
+     * not changed since the condition was last executed, the cached result is
+     * used and the condition action is not executed.
+     *
      * Throws an exception if an error occurs and an action cannot be
      * successfully executed.
      *
@@ -126,6 +139,22 @@ class IfAction : public Action
         return elseActions;
     }
 
+    /**
+     * Returns whether the result of the condition action can be cached.
+     *
+     * The result can be cached if the condition action only consists of
+     * compare_presence and compare_vpd actions, optionally combined using and,
+     * or, and not actions.  These actions have no side effects, and their
+     * results only change when the hardware presence data or VPD values
+     * change.
+     *
+     * @return true if condition result can be cached, false otherwise
+     */
+    bool isConditionCacheable() const
+    {
+        return conditionCacheable;
+    }
+
     /**
      * Returns a string description of this action.
      *
@@ -143,6 +172,27 @@ class IfAction : public Action
     }
 
   private:
+    /**
+     * Executes the condition action.
+     *
+     * Returns the cached result if it is still valid.  Otherwise executes the
+     * condition action and caches the result if possible.
+     *
+     * @param environment action execution environment
+     * @return return value from condition action
+     */
+    bool executeCondition(ActionEnvironment& environment);
+
+    /**
+     * Returns whether the result of the specified action can be cached.
+     *
+     * See isConditionCacheable() for more information.
+     *
+     * @param action action to check
+     * @return true if action result can be cached, false otherwise
+     */
+    static bool isCacheable(const Action& action);
+
     /**
      * Action that tests whether the condition is true.
      */
@@ -157,6 +207,27 @@ class IfAction : public Action
      * Actions in the "else" clause.  Executed if condition is false.  Optional.
      */
     std::vector<std::unique_ptr<Action>> elseActions{};
+
+    /**
+     * Indicates whether the result of the condition action can be cached.
+     */
+    bool conditionCacheable{false};
+
+    /**
+     * Cached result of the condition action.  Has no value if the condition
+     * has not been executed or the result cannot be cached.
+     */
+    std::optional<bool> cachedConditionResult{};
+
+    /**
+     * Presence service cache epoch when the condition result was cached.
+     */
+    uint64_t presenceEpoch{0};
+
+    /**
+     * VPD cache epoch when the condition result was cached.
+     */
+    uint64_t vpdEpoch{0};
 };
 
 } // namespace phosphor::power::regulators
@@ -17,7 +17,9 @@
 
 #include "action.hpp"
 #include "action_environment.hpp"
+#include "profiler.hpp"
 #include "rule.hpp"
+#include "services.hpp"
 
 #include <string>
 
@@ -60,6 +62,8 @@ class RunRuleAction : public Action
      * Throws an exception if an error occurs and an action cannot be
      * successfully executed.
      *
+     * If profiling is enabled, the execution time of the rule is recorded.
+     *
      * @param environment action execution environment
      * @return return value from last action in rule
      */
@@ -70,6 +74,7 @@ class RunRuleAction : public Action
         environment.incrementRuleDepth(ruleID);
 
         // Execute rule
+        ProfileScope scope{environment.getServices().getProfiler(), ruleID};
         bool returnValue = environment.getRule(ruleID).execute(environment);
 
         // Decrement rule depth since rule has returned
@@ -18,6 +18,7 @@
 
 #include "config_file_parser_error.hpp"
 #include "i2c_interface.hpp"
+#include "i2c_read_optimizer.hpp"
 #include "pmbus_utils.hpp"
 
 #include <exception>
@@ -1044,6 +1045,17 @@ std::unique_ptr<Rule> parseRule(const json& element)
         parseActionArray(actionsElement);
     ++propertyCount;
 
+    // Optional coalesce_i2c_reads property
+    auto coalesceIt = element.find("coalesce_i2c_reads");
+    if (coalesceIt != element.end())
+    {
+        if (parseBoolean(*coalesceIt))
+        {
+            i2c_read_optimizer::optimize(actions);
+        }
+        ++propertyCount;
+    }
+
     // Verify no invalid properties exist
     verifyPropertyCount(element, propertyCount);
 
@@ -1136,10 +1148,20 @@ std::unique_ptr<SensorMonitoring> parseSensorMonitoring(const json& element)
     actions = parseRuleIDOrActionsProperty(element);
     ++propertyCount;
 
+    // Optional max_backoff_cycles property
+    unsigned int maxBackoffCycles{SensorMonitoring::defaultMaxBackoffCycles};
+    auto maxBackoffCyclesIt = element.find("max_backoff_cycles");
+    if (maxBackoffCyclesIt != element.end())
+    {
+        maxBackoffCycles = parseUnsignedInteger(*maxBackoffCyclesIt);
+        ++propertyCount;
+    }
+
     // Verify no invalid properties exist
     verifyPropertyCount(element, propertyCount);
 
-    return std::make_unique<SensorMonitoring>(std::move(actions));
+    return std::make_unique<SensorMonitoring>(std::move(actions),
+                                              maxBackoffCycles);
 }
 
 SensorType parseSensorType(const json& element)
@@ -16,8 +16,16 @@
 
 #include "dbus_sensor.hpp"
 
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/sdbus.hpp>
+#include <sdbusplus/server.hpp>
+
+#include <cerrno>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <limits>
+#include <optional>
 #include <utility>
 
 namespace phosphor::power::regulators
@@ -66,12 +74,23 @@ constexpr double voltageMaxValue = 15.0;
 constexpr double voltageHysteresis = 0.001;
 constexpr const char* voltageNamespace = "voltage";
 
+/**
+ * Constants for sensor statistics.
+ *
+ * Sensors are read once per second.  The sample capacity is large enough to
+ * hold the samples for the longest window.
+ */
+constexpr std::size_t statisticsCapacity = 64;
+const std::vector<std::chrono::seconds> statisticsWindows{
+    std::chrono::seconds{10}, std::chrono::seconds{60}};
+
 DBusSensor::DBusSensor(sdbusplus::bus::bus& bus, const std::string& name,
                        SensorType type, double value, const std::string& rail,
                        const std::string& deviceInventoryPath,
                        const std::string& chassisInventoryPath) :
     bus{bus},
-    name{name}, type{type}, rail{rail}
+    name{name}, type{type}, rail{rail},
+    statistics{statisticsCapacity, statisticsWindows}
 {
     // Get sensor properties that are based on the sensor type
     std::string objectPath;
@@ -104,6 +123,16 @@ DBusSensor::DBusSensor(sdbusplus::bus::bus& bus, const std::string& name,
     // Set properties on the Association.Definitions interface
     dbusObject->associations(std::move(associations), skipSignal);
 
+    // Create the SensorStatistics interface.  This must be done before
+    // emitting the signal so the interface is included.
+    statisticsDBusInterface =
+        std::make_unique<sdbusplus::server::interface::interface>(
+            bus, objectPath.c_str(), statisticsInterface, statisticsVtable,
+            this);
+
+    // Store initial value in the sensor statistics
+    statistics.addSample(value);
+
     // Now emit signal that object has been created
     dbusObject->emit_object_added();
 
@@ -116,6 +145,10 @@ void DBusSensor::disable()
     // Set sensor value to NaN
     setValueToNaN();
 
+    // Clear sensor statistics.  Values read before the sensor was disabled
+    // should not be combined with values read after it is enabled again.
+    statistics.clear();
+
     // Set the sensor to unavailable since it is disabled
     dbusObject->available(false);
 
@@ -123,7 +156,7 @@ void DBusSensor::disable()
     setLastUpdateTime();
 }
 
-void DBusSensor::setToErrorState()
+void DBusSensor::setToErrorState(bool backingOff)
 {
     // Set sensor value to NaN
     setValueToNaN();
@@ -131,6 +164,10 @@ void DBusSensor::setToErrorState()
     // Set the sensor to non-functional since it could not be read
     dbusObject->functional(false);
 
+    // Set the sensor to unavailable if it is not being read every monitoring
+    // cycle due to back-off
+    dbusObject->available(!backingOff);
+
     // Set the last update time
     setLastUpdateTime();
 }
@@ -149,10 +186,63 @@ void DBusSensor::setValue(double value)
     // Set the sensor to available since it is not disabled
     dbusObject->available(true);
 
+    // Store value in the sensor statistics.  This is done even if the value
+    // on D-Bus was not updated due to the update policy.
+    statistics.addSample(value);
+
     // Set the last update time
     setLastUpdateTime();
 }
 
+int DBusSensor::callbackGetStatistics(sd_bus_message* msg, void* context,
+                                      sd_bus_error* error)
+{
+    if (msg == nullptr || context == nullptr)
+    {
+        // The message or context were null
+        return -EINVAL;
+    }
+
+    try
+    {
+        uint64_t windowSeconds{};
+        auto m = sdbusplus::message::message(msg);
+        m.read(windowSeconds);
+
+        // Get statistics for the requested window
+        auto sensor = static_cast<DBusSensor*>(context);
+        std::optional<SensorStatistics::Statistics> stats =
+            sensor->statistics.getStatistics(
+                std::chrono::seconds{static_cast<int64_t>(windowSeconds)});
+        if (!stats)
+        {
+            return sd_bus_error_set(
+                error, "xyz.openbmc_project.Common.Error.InvalidArgument",
+                "Unsupported statistics window");
+        }
+
+        // Return minimum, maximum, average, 99th percentile, and count
+        auto reply = m.new_method_return();
+        reply.append(stats->minimum, stats->maximum, stats->average,
+                     stats->p99, static_cast<uint64_t>(stats->count));
+        reply.method_return();
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+
+    return 1;
+}
+
+const sdbusplus::vtable::vtable_t DBusSensor::statisticsVtable[] = {
+    sdbusplus::vtable::start(),
+    // GetStatistics method takes the window in seconds.  Returns the minimum,
+    // maximum, average, 99th percentile, and number of samples.
+    sdbusplus::vtable::method("GetStatistics", "t", "ddddt",
+                              callbackGetStatistics),
+    sdbusplus::vtable::end()};
+
 std::vector<AssocationTuple>
     DBusSensor::getAssociations(const std::string& deviceInventoryPath,
                                 const std::string& chassisInventoryPath)
@@ -15,10 +15,13 @@
  */
 #pragma once
 
+#include "sensor_statistics.hpp"
 #include "sensors.hpp"
 
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
 #include <sdbusplus/server/object.hpp>
+#include <sdbusplus/vtable.hpp>
 #include <xyz/openbmc_project/Association/Definitions/server.hpp>
 #include <xyz/openbmc_project/Sensor/Value/server.hpp>
 #include <xyz/openbmc_project/State/Decorator/Availability/server.hpp>
@@ -85,6 +88,12 @@ using AssocationTuple = std::tuple<std::string, std::string, std::string>;
  */
 constexpr const char* sensorsObjectPath = "/xyz/openbmc_project/sensors";
 
+/**
+ * D-Bus interface that provides rolling statistics for a sensor.
+ */
+constexpr const char* statisticsInterface =
+    "xyz.openbmc_project.Power.Regulators.SensorStatistics";
+
 /**
  * @class DBusSensor
  *
@@ -93,6 +102,12 @@ constexpr const char* sensorsObjectPath = "/xyz/openbmc_project/sensors";
  * Each voltage rail in the system may provide multiple types of sensor data,
  * such as temperature, output voltage, and output current.  A DBusSensor tracks
  * one of these data types for a voltage rail.
+ *
+ * The recent values of the sensor are stored in memory.  Rolling statistics
+ * over those values are available using the GetStatistics method of the
+ * xyz.openbmc_project.Power.Regulators.SensorStatistics interface.  This allows
+ * collectors to obtain the minimum, maximum, and average value without
+ * frequently polling the Value property.
  */
 class DBusSensor
 {
@@ -166,6 +181,16 @@ class DBusSensor
         return rail;
     }
 
+    /**
+     * Return the rolling statistics for the recent values of this sensor.
+     *
+     * @return sensor statistics
+     */
+    SensorStatistics& getStatistics()
+    {
+        return statistics;
+    }
+
     /**
      * Return the sensor type.
      *
@@ -181,8 +206,14 @@ class DBusSensor
      *
      * Updates the sensor properties on D-Bus to indicate an error occurred and
      * the sensor value could not be read.
+     *
+     * If sensor monitoring is backing off due to repeated errors, the sensor
+     * is also set to unavailable since it is not being read every monitoring
+     * cycle.
+     *
+     * @param backingOff specifies whether sensor monitoring is backing off
      */
-    void setToErrorState();
+    void setToErrorState(bool backingOff);
 
     /**
      * Set the value of this sensor.
@@ -261,6 +292,17 @@ class DBusSensor
         lowest
     };
 
+    /**
+     * Systemd bus callback for the GetStatistics method.
+     */
+    static int callbackGetStatistics(sd_bus_message* msg, void* context,
+                                     sd_bus_error* error);
+
+    /**
+     * Systemd vtable structure for the SensorStatistics interface.
+     */
+    static const sdbusplus::vtable::vtable_t statisticsVtable[];
+
     /**
      * Get the D-Bus associations to create for this sensor.
      *
@@ -349,6 +391,17 @@ class DBusSensor
      */
     std::unique_ptr<DBusSensorObject> dbusObject{};
 
+    /**
+     * Rolling statistics for the recent values of this sensor.
+     */
+    SensorStatistics statistics;
+
+    /**
+     * Implementation of the SensorStatistics interface on D-Bus.
+     */
+    std::unique_ptr<sdbusplus::server::interface::interface>
+        statisticsDBusInterface{};
+
     /**
      * Last time this sensor was updated.
      */
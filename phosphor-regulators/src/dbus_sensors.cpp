@@ -48,7 +48,7 @@ void DBusSensors::endCycle()
     }
 }
 
-void DBusSensors::endRail(bool errorOccurred)
+void DBusSensors::endRail(bool errorOccurred, bool backingOff)
 {
     // If an error occurred, set all sensors for current rail to the error state
     if (errorOccurred)
@@ -57,7 +57,7 @@ void DBusSensors::endRail(bool errorOccurred)
         {
             if (sensor->getRail() == rail)
             {
-                sensor->setToErrorState();
+                sensor->setToErrorState(backingOff);
             }
         }
     }
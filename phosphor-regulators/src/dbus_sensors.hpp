@@ -61,7 +61,7 @@ class DBusSensors : public Sensors
     virtual void endCycle() override;
 
     /** @copydoc Sensors::endRail() */
-    virtual void endRail(bool errorOccurred) override;
+    virtual void endRail(bool errorOccurred, bool backingOff) override;
 
     /** @copydoc Sensors::disable() */
     virtual void disable() override;
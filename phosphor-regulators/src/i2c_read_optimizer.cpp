@@ -0,0 +1,104 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "i2c_read_optimizer.hpp"
+
+#include "i2c_coalesced_read_action.hpp"
+#include "i2c_read_action.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace phosphor::power::regulators::i2c_read_optimizer
+{
+
+/**
+ * Moves the specified group of I2C read actions to the end of an action
+ * sequence.
+ *
+ * If the group contains more than one action, the actions are combined into
+ * an I2CCoalescedReadAction.  The group is empty when this function returns.
+ *
+ * @param group group of I2C read actions
+ * @param actions action sequence to append to
+ */
+static void appendGroup(std::vector<std::unique_ptr<I2CReadAction>>& group,
+                        std::vector<std::unique_ptr<Action>>& actions)
+{
+    if (group.size() > 1)
+    {
+        actions.emplace_back(
+            std::make_unique<I2CCoalescedReadAction>(std::move(group)));
+    }
+    else if (group.size() == 1)
+    {
+        actions.emplace_back(std::move(group.front()));
+    }
+    group.clear();
+}
+
+void optimize(std::vector<std::unique_ptr<Action>>& actions)
+{
+    std::vector<std::unique_ptr<Action>> optimizedActions{};
+    std::vector<std::unique_ptr<I2CReadAction>> group{};
+
+    // Register range read by the current group: [groupFirst, groupEnd)
+    unsigned int groupFirst{0}, groupEnd{0};
+
+    for (std::unique_ptr<Action>& action : actions)
+    {
+        I2CReadAction* readAction = dynamic_cast<I2CReadAction*>(action.get());
+        if (readAction == nullptr)
+        {
+            // Action is not an I2C read; end the current group
+            appendGroup(group, optimizedActions);
+            optimizedActions.emplace_back(std::move(action));
+            continue;
+        }
+
+        unsigned int first = readAction->getRegister();
+        unsigned int end = first + readAction->getReadSize();
+        if (!group.empty())
+        {
+            // Check if register range is adjacent to or overlaps the group
+            // range and the combined range fits in one I2C block read
+            unsigned int combinedFirst = std::min(groupFirst, first);
+            unsigned int combinedEnd = std::max(groupEnd, end);
+            if ((first <= groupEnd) && (end >= groupFirst) &&
+                ((combinedEnd - combinedFirst) <=
+                 I2CCoalescedReadAction::maxReadSize))
+            {
+                first = combinedFirst;
+                end = combinedEnd;
+            }
+            else
+            {
+                appendGroup(group, optimizedActions);
+            }
+        }
+
+        // Add action to the current group
+        action.release();
+        group.emplace_back(readAction);
+        groupFirst = first;
+        groupEnd = end;
+    }
+    appendGroup(group, optimizedActions);
+
+    actions = std::move(optimizedActions);
+}
+
+} // namespace phosphor::power::regulators::i2c_read_optimizer
@@ -0,0 +1,54 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "action.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace phosphor::power::regulators::i2c_read_optimizer
+{
+
+/**
+ * This file contains functions that reduce the number of I2C operations
+ * performed by a sequence of actions.
+ */
+
+/**
+ * Coalesces adjacent I2C register reads within the specified action sequence.
+ *
+ * Finds consecutive I2C read actions, such as i2c_compare_byte and
+ * i2c_capture_bytes, that read a contiguous range of device registers.  Each
+ * group of two or more such actions is replaced by an I2CCoalescedReadAction
+ * that reads the entire register range in one I2C block read.
+ *
+ * A group ends at any other type of action, such as an I2C write or
+ * set_device.  A group also ends when the next register range is not adjacent
+ * to or overlapping with the current range, or the combined range would exceed
+ * the maximum I2C block read size.
+ *
+ * The order and return values of the actions are not changed.  However, the
+ * device must support reading consecutive registers in one I2C block read, and
+ * a register read by multiple actions in the same group is only read once.
+ * For this reason the optimization is only performed when enabled in the
+ * config file.
+ *
+ * @param actions action sequence to optimize; modified in place
+ */
+void optimize(std::vector<std::unique_ptr<Action>>& actions);
+
+} // namespace phosphor::power::regulators::i2c_read_optimizer
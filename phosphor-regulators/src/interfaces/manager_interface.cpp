@@ -21,8 +21,10 @@
 #include <sdbusplus/sdbus.hpp>
 #include <sdbusplus/server.hpp>
 
+#include <cstdint>
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace phosphor
 {
@@ -104,12 +106,92 @@ int ManagerInterface::callbackMonitor(sd_bus_message* msg, void* context,
     return 1;
 }
 
+int ManagerInterface::callbackSetProfilingEnabled(sd_bus_message* msg,
+                                                  void* context,
+                                                  sd_bus_error* error)
+{
+    if (msg != nullptr && context != nullptr)
+    {
+        try
+        {
+            bool enable{};
+            auto m = sdbusplus::message::message(msg);
+
+            m.read(enable);
+
+            auto mgrObj = static_cast<ManagerInterface*>(context);
+            mgrObj->setProfilingEnabled(enable);
+
+            auto reply = m.new_method_return();
+
+            reply.method_return();
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            return sd_bus_error_set(error, e.name(), e.description());
+        }
+    }
+    else
+    {
+        // The message or context were null
+        using namespace phosphor::logging;
+        log<level::ERR>(
+            "Unable to service SetProfilingEnabled method callback");
+        return -1;
+    }
+
+    return 1;
+}
+
+int ManagerInterface::callbackGetProfile(sd_bus_message* msg, void* context,
+                                         sd_bus_error* error)
+{
+    if (msg != nullptr && context != nullptr)
+    {
+        try
+        {
+            uint64_t maxEntries{};
+            auto m = sdbusplus::message::message(msg);
+
+            m.read(maxEntries);
+
+            auto mgrObj = static_cast<ManagerInterface*>(context);
+            std::vector<ProfileEntry> entries = mgrObj->getProfile(maxEntries);
+
+            auto reply = m.new_method_return();
+            reply.append(entries);
+
+            reply.method_return();
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            return sd_bus_error_set(error, e.name(), e.description());
+        }
+    }
+    else
+    {
+        // The message or context were null
+        using namespace phosphor::logging;
+        log<level::ERR>("Unable to service GetProfile method callback");
+        return -1;
+    }
+
+    return 1;
+}
+
 const sdbusplus::vtable::vtable_t ManagerInterface::_vtable[] = {
     sdbusplus::vtable::start(),
     // No configure method parameters and returns void
     sdbusplus::vtable::method("Configure", "", "", callbackConfigure),
     // Monitor method takes a boolean parameter and returns void
     sdbusplus::vtable::method("Monitor", "b", "", callbackMonitor),
+    // SetProfilingEnabled method takes a boolean parameter and returns void
+    sdbusplus::vtable::method("SetProfilingEnabled", "b", "",
+                              callbackSetProfilingEnabled),
+    // GetProfile method takes the maximum number of entries and returns an
+    // array of (category, name, count, total usec, max usec) structures
+    sdbusplus::vtable::method("GetProfile", "t", "a(ssttt)",
+                              callbackGetProfile),
     sdbusplus::vtable::end()};
 
 } // namespace interface
@@ -6,7 +6,10 @@
 #include <sdbusplus/server/interface.hpp>
 #include <sdbusplus/vtable.hpp>
 
+#include <cstdint>
 #include <string>
+#include <tuple>
+#include <vector>
 
 namespace phosphor
 {
@@ -17,6 +20,18 @@ namespace regulators
 namespace interface
 {
 
+/**
+ * Profiling data for one rule or action type returned by the GetProfile
+ * method.
+ *
+ * Contains the category ("rule" or "action"), the rule ID or action type name,
+ * the number of calls, the cumulative execution time in microseconds, and the
+ * maximum execution time in microseconds.  The execution times exclude nested
+ * actions and rules.
+ */
+using ProfileEntry =
+    std::tuple<std::string, std::string, uint64_t, uint64_t, uint64_t>;
+
 class ManagerInterface
 {
   public:
@@ -59,6 +74,26 @@ class ManagerInterface
      */
     virtual void monitor(bool enable) = 0;
 
+    /**
+     * @brief Implementation for the SetProfilingEnabled method
+     * Enable or disable profiling of rule and action execution time.
+     *
+     * @param[in] enable - Enable or disable profiling.
+     */
+    virtual void setProfilingEnabled(bool enable) = 0;
+
+    /**
+     * @brief Implementation for the GetProfile method
+     * Get the rules and action types with the highest cumulative
+     * execution time.
+     *
+     * @param[in] maxEntries - Maximum number of rules and maximum number
+     *                         of action types to return.
+     *
+     * @return Profiling data for the rules and action types.
+     */
+    virtual std::vector<ProfileEntry> getProfile(uint64_t maxEntries) = 0;
+
     /**
      * @brief This dbus interface's name
      */
@@ -78,6 +113,18 @@ class ManagerInterface
     static int callbackMonitor(sd_bus_message* msg, void* context,
                                sd_bus_error* error);
 
+    /**
+     * @brief Systemd bus callback for the SetProfilingEnabled method
+     */
+    static int callbackSetProfilingEnabled(sd_bus_message* msg, void* context,
+                                           sd_bus_error* error);
+
+    /**
+     * @brief Systemd bus callback for the GetProfile method
+     */
+    static int callbackGetProfile(sd_bus_message* msg, void* context,
+                                  sd_bus_error* error);
+
     /**
      * @brief Systemd vtable structure that contains all the
      * methods, signals, and properties of this interface with their
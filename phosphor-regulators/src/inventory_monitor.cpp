@@ -0,0 +1,242 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "inventory_monitor.hpp"
+
+#include "types.hpp"
+
+#include <sdbusplus/exception.hpp>
+
+#include <exception>
+#include <functional>
+#include <utility>
+
+namespace phosphor::power::regulators
+{
+
+/**
+ * D-Bus interface containing the HW VPD keyword.
+ */
+constexpr auto viniInterface = "com.ibm.ipzvpd.VINI";
+
+InventoryMonitor::InventoryMonitor(sdbusplus::bus::bus& bus,
+                                   DBusPresenceService& presenceService,
+                                   DBusVPD& vpd, Journal& journal) :
+    bus{bus},
+    presenceService{presenceService}, vpd{vpd}, journal{journal}
+{
+    namespace rules = sdbusplus::bus::match::rules;
+
+    // Subscribe to D-Bus InterfacesAdded signal from inventory manager
+    signals.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, rules::interfacesAdded() + rules::sender(INVENTORY_MGR_IFACE),
+        std::bind(&InventoryMonitor::interfacesAddedHandler, this,
+                  std::placeholders::_1)));
+
+    // Subscribe to D-Bus InterfacesRemoved signal from inventory manager
+    signals.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, rules::interfacesRemoved() + rules::sender(INVENTORY_MGR_IFACE),
+        std::bind(&InventoryMonitor::interfacesRemovedHandler, this,
+                  std::placeholders::_1)));
+
+    // Subscribe to D-Bus PropertiesChanged signal for all inventory paths
+    signals.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus,
+        rules::type::signal() + rules::member("PropertiesChanged") +
+            rules::interface("org.freedesktop.DBus.Properties") +
+            rules::path_namespace(INVENTORY_OBJ_PATH) +
+            rules::sender(INVENTORY_MGR_IFACE),
+        std::bind(&InventoryMonitor::propertiesChangedHandler, this,
+                  std::placeholders::_1)));
+}
+
+void InventoryMonitor::prefetch()
+{
+    try
+    {
+        // Get interfaces and properties of all inventory items
+        auto method = bus.new_method_call(INVENTORY_MGR_IFACE,
+                                          INVENTORY_OBJ_PATH,
+                                          "org.freedesktop.DBus.ObjectManager",
+                                          "GetManagedObjects");
+        auto reply = bus.call(method);
+        std::map<sdbusplus::message::object_path, InterfaceMap> objects{};
+        reply.read(objects);
+
+        for (const auto& [path, interfaces] : objects)
+        {
+            updateCaches(path.str, interfaces);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        // Any presence data and VPD values that are not already cached will
+        // be obtained individually when needed.  Callers clear the caches
+        // before calling prefetch() if the cached values might be stale.
+        journal.logError(
+            std::string{"Unable to prefetch inventory data: "} + e.what());
+    }
+}
+
+void InventoryMonitor::interfacesAddedHandler(sdbusplus::message::message& msg)
+{
+    try
+    {
+        sdbusplus::message::object_path path{};
+        InterfaceMap interfaces{};
+        msg.read(path, interfaces);
+        updateCaches(path.str, interfaces);
+    }
+    catch (const std::exception& e)
+    {
+        journal.logError(
+            std::string{"Unable to read InterfacesAdded signal: "} + e.what());
+    }
+}
+
+void InventoryMonitor::interfacesRemovedHandler(
+    sdbusplus::message::message& msg)
+{
+    try
+    {
+        sdbusplus::message::object_path path{};
+        std::vector<std::string> interfaces{};
+        msg.read(path, interfaces);
+        removeInterfaces(path.str, interfaces);
+    }
+    catch (const std::exception& e)
+    {
+        journal.logError(
+            std::string{"Unable to read InterfacesRemoved signal: "} +
+            e.what());
+    }
+}
+
+void InventoryMonitor::propertiesChangedHandler(
+    sdbusplus::message::message& msg)
+{
+    try
+    {
+        std::string interface{};
+        PropertyMap properties{};
+        std::vector<std::string> invalidatedProperties{};
+        msg.read(interface, properties, invalidatedProperties);
+        updateProperties(msg.get_path(), interface, properties,
+                         invalidatedProperties);
+    }
+    catch (const std::exception& e)
+    {
+        journal.logError(
+            std::string{"Unable to read PropertiesChanged signal: "} +
+            e.what());
+    }
+}
+
+void InventoryMonitor::removeInterfaces(
+    const std::string& inventoryPath,
+    const std::vector<std::string>& interfaces)
+{
+    // Remove cached values; they will be obtained from D-Bus if needed
+    for (const auto& interface : interfaces)
+    {
+        if (interface == INVENTORY_IFACE)
+        {
+            presenceService.removeCachedValue(inventoryPath);
+        }
+        else if ((interface == ASSET_IFACE) || (interface == viniInterface))
+        {
+            vpd.removeCachedValues(inventoryPath);
+        }
+    }
+}
+
+void InventoryMonitor::updateProperties(
+    const std::string& inventoryPath, const std::string& interface,
+    const PropertyMap& properties,
+    const std::vector<std::string>& invalidatedProperties)
+{
+    InterfaceMap interfaces{};
+    interfaces.emplace(interface, properties);
+    updateCaches(inventoryPath, interfaces);
+
+    // Remove cached values of invalidated properties; they will be obtained
+    // from D-Bus if needed
+    for (const auto& property : invalidatedProperties)
+    {
+        if ((interface == INVENTORY_IFACE) && (property == PRESENT_PROP))
+        {
+            presenceService.removeCachedValue(inventoryPath);
+        }
+        else if (interface == ASSET_IFACE)
+        {
+            vpd.removeCachedValue(inventoryPath, property);
+            if (property == "Model")
+            {
+                vpd.removeCachedValue(inventoryPath, "CCIN");
+            }
+        }
+        else if ((interface == viniInterface) && (property == "HW"))
+        {
+            vpd.removeCachedValue(inventoryPath, property);
+        }
+    }
+}
+
+void InventoryMonitor::updateCaches(const std::string& inventoryPath,
+                                    const InterfaceMap& interfaces)
+{
+    for (const auto& [interface, properties] : interfaces)
+    {
+        for (const auto& [property, value] : properties)
+        {
+            if ((interface == INVENTORY_IFACE) && (property == PRESENT_PROP))
+            {
+                if (const bool* present = std::get_if<bool>(&value))
+                {
+                    presenceService.setCachedValue(inventoryPath, *present);
+                }
+            }
+            else if (interface == ASSET_IFACE)
+            {
+                // Asset properties have string values.  The property name is
+                // the VPD keyword, except the CCIN keyword is stored in the
+                // Model property.
+                if (const std::string* stringValue =
+                        std::get_if<std::string>(&value))
+                {
+                    std::vector<uint8_t> keywordValue{stringValue->begin(),
+                                                      stringValue->end()};
+                    vpd.setCachedValue(inventoryPath, property, keywordValue);
+                    if (property == "Model")
+                    {
+                        vpd.setCachedValue(inventoryPath, "CCIN",
+                                           keywordValue);
+                    }
+                }
+            }
+            else if ((interface == viniInterface) && (property == "HW"))
+            {
+                if (const std::vector<uint8_t>* bytesValue =
+                        std::get_if<std::vector<uint8_t>>(&value))
+                {
+                    vpd.setCachedValue(inventoryPath, property, *bytesValue);
+                }
+            }
+        }
+    }
+}
+
+} // namespace phosphor::power::regulators
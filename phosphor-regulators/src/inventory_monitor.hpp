@@ -0,0 +1,197 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "journal.hpp"
+#include "presence_service.hpp"
+#include "vpd.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace phosphor::power::regulators
+{
+
+/**
+ * @class InventoryMonitor
+ *
+ * Obtains hardware presence data and VPD values from the inventory manager and
+ * stores them in the DBusPresenceService and DBusVPD caches.
+ *
+ * The prefetch() method obtains the data for all inventory items using a single
+ * GetManagedObjects D-Bus method call.  This avoids a separate D-Bus method
+ * call for each inventory path and VPD keyword that is checked by rules.
+ *
+ * After the caches have been filled, they are kept up to date using the
+ * InterfacesAdded, InterfacesRemoved, and PropertiesChanged D-Bus signals from
+ * the inventory manager.
+ */
+class InventoryMonitor
+{
+  public:
+    // Specify which compiler-generated methods we want
+    InventoryMonitor() = delete;
+    InventoryMonitor(const InventoryMonitor&) = delete;
+    InventoryMonitor(InventoryMonitor&&) = delete;
+    InventoryMonitor& operator=(const InventoryMonitor&) = delete;
+    InventoryMonitor& operator=(InventoryMonitor&&) = delete;
+    ~InventoryMonitor() = default;
+
+    /**
+     * Constructor.
+     *
+     * Subscribes to the D-Bus signals from the inventory manager.
+     *
+     * @param bus D-Bus bus object
+     * @param presenceService presence service whose cache should be updated
+     * @param vpd VPD service whose cache should be updated
+     * @param journal journal used to log error messages
+     */
+    explicit InventoryMonitor(sdbusplus::bus::bus& bus,
+                              DBusPresenceService& presenceService,
+                              DBusVPD& vpd, Journal& journal);
+
+    /**
+     * Obtains the presence data and VPD values for all inventory items and
+     * stores them in the caches.
+     *
+     * Values that are already cached are replaced, but cached values of
+     * inventory items that no longer exist are not removed.  Clear the caches
+     * first if they might contain stale values.
+     *
+     * If an error occurs, a message is written to the journal.  Any presence
+     * data and VPD values that are not cached will then be obtained
+     * individually when needed.
+     */
+    void prefetch();
+
+    /**
+     * D-Bus property value types used by the presence and VPD properties.
+     *
+     * Properties of other types are ignored.
+     */
+    using PropertyValue =
+        std::variant<bool, std::string, std::vector<uint8_t>>;
+
+    /**
+     * Map from property names to values.
+     */
+    using PropertyMap = std::map<std::string, PropertyValue>;
+
+    /**
+     * Map from interface names to properties.
+     */
+    using InterfaceMap = std::map<std::string, PropertyMap>;
+
+    /**
+     * Updates the caches using the specified interfaces and properties of an
+     * inventory item.
+     *
+     * Used for the GetManagedObjects reply and InterfacesAdded signals.
+     *
+     * @param inventoryPath D-Bus inventory path of the hardware
+     * @param interfaces interfaces and properties of the inventory item
+     */
+    void updateCaches(const std::string& inventoryPath,
+                      const InterfaceMap& interfaces);
+
+    /**
+     * Removes the cached values of the specified interfaces of an inventory
+     * item.
+     *
+     * Used for InterfacesRemoved signals.  The values will be obtained from
+     * D-Bus if needed.
+     *
+     * @param inventoryPath D-Bus inventory path of the hardware
+     * @param interfaces interfaces that were removed
+     */
+    void removeInterfaces(const std::string& inventoryPath,
+                          const std::vector<std::string>& interfaces);
+
+    /**
+     * Updates the caches using the changed and invalidated properties of an
+     * interface of an inventory item.
+     *
+     * Used for PropertiesChanged signals.  Cached values of invalidated
+     * properties are removed, so they will be obtained from D-Bus if needed.
+     *
+     * @param inventoryPath D-Bus inventory path of the hardware
+     * @param interface interface containing the properties
+     * @param properties changed properties and their new values
+     * @param invalidatedProperties properties whose values were invalidated
+     */
+    void updateProperties(
+        const std::string& inventoryPath, const std::string& interface,
+        const PropertyMap& properties,
+        const std::vector<std::string>& invalidatedProperties);
+
+  private:
+    /**
+     * Callback function to handle InterfacesAdded D-Bus signals.
+     *
+     * @param msg D-Bus signal message
+     */
+    void interfacesAddedHandler(sdbusplus::message::message& msg);
+
+    /**
+     * Callback function to handle InterfacesRemoved D-Bus signals.
+     *
+     * @param msg D-Bus signal message
+     */
+    void interfacesRemovedHandler(sdbusplus::message::message& msg);
+
+    /**
+     * Callback function to handle PropertiesChanged D-Bus signals.
+     *
+     * @param msg D-Bus signal message
+     */
+    void propertiesChangedHandler(sdbusplus::message::message& msg);
+
+    /**
+     * D-Bus bus object.
+     */
+    sdbusplus::bus::bus& bus;
+
+    /**
+     * Presence service whose cache is updated.
+     */
+    DBusPresenceService& presenceService;
+
+    /**
+     * VPD service whose cache is updated.
+     */
+    DBusVPD& vpd;
+
+    /**
+     * Journal used to log error messages.
+     */
+    Journal& journal;
+
+    /**
+     * D-Bus signal matches.
+     */
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> signals{};
+};
+
+} // namespace phosphor::power::regulators
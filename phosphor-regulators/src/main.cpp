@@ -14,19 +14,48 @@
  * limitations under the License.
  */
 
+#include "i2c_trace.hpp"
 #include "manager.hpp"
 
+#include <CLI/CLI.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/signal.hpp>
 #include <stdplus/signal.hpp>
 
 #include <functional>
+#include <string>
 
-int main(void)
+int main(int argc, char* argv[])
 {
     using namespace phosphor::power;
 
+    CLI::App app{"OpenBMC Voltage Regulators Application"};
+    std::string traceRecordFile{};
+    std::string traceReplayFile{};
+    bool simulateLatency{false};
+    auto recordOption = app.add_option("--i2c-trace-record", traceRecordFile,
+                                       "Record all I2C operations to a file");
+    auto replayOption =
+        app.add_option("--i2c-trace-replay", traceReplayFile,
+                       "Replay I2C operations from a file instead of "
+                       "accessing hardware")
+            ->excludes(recordOption);
+    app.add_flag("--i2c-trace-latency", simulateLatency,
+                 "Simulate the recorded latency of replayed I2C operations")
+        ->needs(replayOption);
+    CLI11_PARSE(app, argc, argv);
+
+    // Start I2C trace before the config file creates any I2C interfaces
+    if (!traceRecordFile.empty())
+    {
+        i2c::startTraceRecording(traceRecordFile);
+    }
+    else if (!traceReplayFile.empty())
+    {
+        i2c::startTraceReplay(traceReplayFile, simulateLatency);
+    }
+
     auto bus = sdbusplus::bus::new_default();
     auto event = sdeventplus::Event::get_default();
     bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
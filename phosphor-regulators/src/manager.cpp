@@ -19,6 +19,7 @@
 #include "chassis.hpp"
 #include "config_file_parser.hpp"
 #include "exception_utils.hpp"
+#include "profiler.hpp"
 #include "rule.hpp"
 #include "utility.hpp"
 
@@ -30,10 +31,12 @@
 #include <exception>
 #include <functional>
 #include <map>
+#include <string>
 #include <thread>
 #include <tuple>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace phosphor::power::regulators
 {
@@ -113,6 +116,10 @@ void Manager::configure()
     // Clear any cached data or error history related to hardware devices
     clearHardwareData();
 
+    // Obtain presence data and VPD values for all inventory items using one
+    // D-Bus method call rather than one call per item and keyword
+    services.getInventoryMonitor().prefetch();
+
     // Wait until the config file has been loaded or hit max wait time
     waitUntilConfigFileLoaded();
 
@@ -138,6 +145,32 @@ void Manager::configure()
     }
 }
 
+std::vector<interface::ProfileEntry> Manager::getProfile(uint64_t maxEntries)
+{
+    std::vector<interface::ProfileEntry> entries{};
+    Profiler& profiler = services.getProfiler();
+
+    // Add entries for rules followed by entries for action types
+    auto addEntries = [&entries](const std::string& category,
+                                 const std::vector<Profiler::Entry>& data) {
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        for (const Profiler::Entry& entry : data)
+        {
+            entries.emplace_back(
+                category, entry.name, entry.count,
+                static_cast<uint64_t>(
+                    duration_cast<microseconds>(entry.totalTime).count()),
+                static_cast<uint64_t>(
+                    duration_cast<microseconds>(entry.maxTime).count()));
+        }
+    };
+    addEntries("rule", profiler.getRuleEntries(maxEntries));
+    addEntries("action", profiler.getActionEntries(maxEntries));
+
+    return entries;
+}
+
 void Manager::interfacesAddedHandler(sdbusplus::message::message& msg)
 {
     // Verify message is valid
@@ -258,6 +291,20 @@ void Manager::sensorTimerExpired()
     services.getSensors().endCycle();
 }
 
+void Manager::setProfilingEnabled(bool enable)
+{
+    if (enable)
+    {
+        services.getJournal().logDebug("Profiling enabled");
+        services.getProfiler().enable();
+    }
+    else
+    {
+        services.getJournal().logDebug("Profiling disabled");
+        services.getProfiler().disable();
+    }
+}
+
 void Manager::sighupHandler(sdeventplus::source::Signal& /*sigSrc*/,
                             const struct signalfd_siginfo* /*sigInfo*/)
 {
@@ -267,7 +314,9 @@ void Manager::sighupHandler(sdeventplus::source::Signal& /*sigSrc*/,
 
 void Manager::clearHardwareData()
 {
-    // Clear any cached hardware presence data and VPD values
+    // Clear any cached hardware presence data and VPD values.  The inventory
+    // monitor could have missed a D-Bus signal while the system was powered
+    // off, so the values are prefetched again before configuration.
     services.getPresenceService().clearCache();
     services.getVPD().clearCache();
 
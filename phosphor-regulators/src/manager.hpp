@@ -68,6 +68,19 @@ class Manager : public ManagerObject
      */
     void configure() override;
 
+    /**
+     * Implements the D-Bus "GetProfile" method.
+     *
+     * Returns the rules and action types with the highest cumulative
+     * execution time.
+     *
+     * @param maxEntries maximum number of rules and maximum number of action
+     *                   types to return
+     * @return profiling data for the rules and action types
+     */
+    std::vector<interface::ProfileEntry>
+        getProfile(uint64_t maxEntries) override;
+
     /**
      * Callback function to handle interfacesAdded D-Bus signals
      *
@@ -113,6 +126,17 @@ class Manager : public ManagerObject
      */
     void sensorTimerExpired();
 
+    /**
+     * Implements the D-Bus "SetProfilingEnabled" method.
+     *
+     * Sets whether profiling of rule and action execution time is enabled.
+     * Enabling profiling clears any previously recorded profiling data.
+     *
+     * @param enable true if profiling should be enabled, false if it should be
+     *               disabled
+     */
+    void setProfilingEnabled(bool enable) override;
+
     /**
      * Callback function to handle receiving a HUP signal
      * to reload the configuration data.
@@ -18,7 +18,9 @@
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/exception.hpp>
 
+#include <cstdint>
 #include <map>
+#include <optional>
 #include <string>
 
 namespace phosphor::power::regulators
@@ -47,6 +49,17 @@ class PresenceService
      */
     virtual void clearCache(void) = 0;
 
+    /**
+     * Returns the current cache epoch.
+     *
+     * The epoch changes whenever cached hardware presence data is cleared or
+     * modified.  Callers can store a value derived from presence data along
+     * with the epoch.  The value remains valid while the epoch is unchanged.
+     *
+     * @return cache epoch
+     */
+    virtual uint64_t getCacheEpoch(void) const = 0;
+
     /**
      * Returns whether the hardware with the specified inventory path is
      * present.
@@ -90,11 +103,72 @@ class DBusPresenceService : public PresenceService
     virtual void clearCache(void) override
     {
         cache.clear();
+        ++cacheEpoch;
+    }
+
+    /** @copydoc PresenceService::getCacheEpoch() */
+    virtual uint64_t getCacheEpoch(void) const override
+    {
+        return cacheEpoch;
     }
 
     /** @copydoc PresenceService::isPresent() */
     virtual bool isPresent(const std::string& inventoryPath) override;
 
+    /**
+     * Returns the cached presence value for the specified inventory path, if
+     * any.
+     *
+     * Does not obtain the presence value from D-Bus.
+     *
+     * @param inventoryPath D-Bus inventory path of the hardware
+     * @return cached presence value, or std::nullopt if none is cached
+     */
+    std::optional<bool> getCachedValue(const std::string& inventoryPath) const
+    {
+        auto it = cache.find(inventoryPath);
+        if (it == cache.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * Removes any cached presence value for the specified inventory path.
+     *
+     * The presence value will be obtained from D-Bus the next time it is
+     * needed.
+     *
+     * @param inventoryPath D-Bus inventory path of the hardware
+     */
+    void removeCachedValue(const std::string& inventoryPath)
+    {
+        if (cache.erase(inventoryPath) > 0)
+        {
+            ++cacheEpoch;
+        }
+    }
+
+    /**
+     * Sets the cached presence value for the specified inventory path.
+     *
+     * Used when the presence value has been obtained from a source other than
+     * isPresent(), such as a D-Bus signal.
+     *
+     * @param inventoryPath D-Bus inventory path of the hardware
+     * @param present true if hardware is present, false otherwise
+     */
+    void setCachedValue(const std::string& inventoryPath, bool present)
+    {
+        auto [it, wasInserted] = cache.try_emplace(inventoryPath, present);
+        if (!wasInserted && (it->second != present))
+        {
+            it->second = present;
+            ++cacheEpoch;
+        }
+    }
+
   private:
     /**
      * Returns whether the specified D-Bus exception is one of the expected
@@ -115,6 +189,12 @@ class DBusPresenceService : public PresenceService
      * Map from inventory paths to presence values.
      */
     std::map<std::string, bool> cache{};
+
+    /**
+     * Cache epoch.  Incremented when cached presence values are cleared or
+     * modified.
+     */
+    uint64_t cacheEpoch{0};
 };
 
 } // namespace phosphor::power::regulators
@@ -0,0 +1,108 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profiler.hpp"
+
+#include "action.hpp"
+
+#include <algorithm>
+#include <typeinfo>
+
+namespace phosphor::power::regulators
+{
+
+/**
+ * Returns the specified entries sorted by cumulative execution time in
+ * descending order.
+ *
+ * @param entries map containing profiling data entries
+ * @param maxEntries maximum number of entries to return
+ * @return sorted profiling data entries
+ */
+template <typename Key>
+static std::vector<Profiler::Entry>
+    getSortedEntries(const std::map<Key, Profiler::Entry>& entries,
+                     std::size_t maxEntries)
+{
+    std::vector<Profiler::Entry> sortedEntries{};
+    for (const auto& [key, entry] : entries)
+    {
+        sortedEntries.emplace_back(entry);
+    }
+
+    std::sort(sortedEntries.begin(), sortedEntries.end(),
+              [](const Profiler::Entry& a, const Profiler::Entry& b) {
+                  return (a.totalTime > b.totalTime);
+              });
+
+    if (sortedEntries.size() > maxEntries)
+    {
+        sortedEntries.resize(maxEntries);
+    }
+    return sortedEntries;
+}
+
+std::vector<Profiler::Entry>
+    Profiler::getActionEntries(std::size_t maxEntries) const
+{
+    return getSortedEntries(actionEntries, maxEntries);
+}
+
+std::vector<Profiler::Entry>
+    Profiler::getRuleEntries(std::size_t maxEntries) const
+{
+    return getSortedEntries(ruleEntries, maxEntries);
+}
+
+void Profiler::recordAction(const Action& action, Clock::duration time)
+{
+    if (!enabled)
+    {
+        return;
+    }
+
+    // Find entry for the action type.  Create entry if it doesn't exist.
+    auto [it, wasInserted] =
+        actionEntries.try_emplace(std::type_index{typeid(action)});
+    Entry& entry = it->second;
+    if (wasInserted)
+    {
+        // Get action type name from the action description.  The description
+        // starts with the type name followed by a colon.
+        std::string description = action.toString();
+        entry.name = description.substr(0, description.find(':'));
+    }
+    update(entry, time);
+}
+
+void Profiler::recordRule(const std::string& ruleID, Clock::duration time)
+{
+    if (!enabled)
+    {
+        return;
+    }
+
+    // Find entry for the rule.  Create entry if it doesn't exist.
+    auto [it, wasInserted] = ruleEntries.try_emplace(ruleID);
+    Entry& entry = it->second;
+    if (wasInserted)
+    {
+        entry.name = ruleID;
+    }
+    update(entry, time);
+}
+
+} // namespace phosphor::power::regulators
@@ -0,0 +1,360 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace phosphor::power::regulators
+{
+
+// Forward declarations to avoid circular dependencies
+class Action;
+class ProfileScope;
+
+/**
+ * @class Profiler
+ *
+ * Measures the execution time of actions and rules.
+ *
+ * Records the number of calls, the cumulative execution time, and the maximum
+ * execution time of each rule and each action type.  This information is used
+ * to find the rules that consume the most time so the configuration file can
+ * be tuned.
+ *
+ * The execution time recorded is self time.  The time of an action excludes
+ * the time of the actions and rules nested within it, such as the actions in
+ * an if action or the rule run by a run_rule action.  The time of a rule
+ * excludes the time of the rules it runs.  As a result, the time of a nested
+ * action or rule is only counted once.
+ *
+ * Profiling is disabled by default.  When disabled, no time measurements are
+ * made and no data is recorded.
+ */
+class Profiler
+{
+  public:
+    /**
+     * Clock used to measure execution time.
+     */
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Profiling data for one rule or action type.
+     */
+    struct Entry
+    {
+        /**
+         * Rule ID or action type name, such as "i2c_compare_byte".
+         */
+        std::string name{};
+
+        /**
+         * Number of times the rule or action type was executed.
+         */
+        uint64_t count{0};
+
+        /**
+         * Cumulative execution time, excluding nested actions and rules.
+         */
+        Clock::duration totalTime{};
+
+        /**
+         * Maximum execution time of a single call, excluding nested actions
+         * and rules.
+         */
+        Clock::duration maxTime{};
+    };
+
+    // Specify which compiler-generated methods we want
+    Profiler() = default;
+    Profiler(const Profiler&) = delete;
+    Profiler(Profiler&&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+    Profiler& operator=(Profiler&&) = delete;
+    ~Profiler() = default;
+
+    /**
+     * Clears all profiling data.
+     */
+    void clear()
+    {
+        actionEntries.clear();
+        ruleEntries.clear();
+    }
+
+    /**
+     * Disables profiling.
+     *
+     * Profiling data that has been recorded is retained.
+     */
+    void disable()
+    {
+        enabled = false;
+    }
+
+    /**
+     * Enables profiling.
+     *
+     * Any previously recorded profiling data is cleared.
+     */
+    void enable()
+    {
+        clear();
+        enabled = true;
+    }
+
+    /**
+     * Returns the profiling data for action types.
+     *
+     * Entries are sorted by cumulative execution time in descending order.
+     *
+     * @param maxEntries maximum number of entries to return
+     * @return profiling data for action types
+     */
+    std::vector<Entry> getActionEntries(std::size_t maxEntries) const;
+
+    /**
+     * Returns the profiling data for rules.
+     *
+     * Entries are sorted by cumulative execution time in descending order.
+     *
+     * @param maxEntries maximum number of entries to return
+     * @return profiling data for rules
+     */
+    std::vector<Entry> getRuleEntries(std::size_t maxEntries) const;
+
+    /**
+     * Returns whether profiling is enabled.
+     *
+     * @return true if profiling is enabled, false otherwise
+     */
+    bool isEnabled() const
+    {
+        return enabled;
+    }
+
+    /**
+     * Records one execution of the specified action.
+     *
+     * Does nothing if profiling is disabled.
+     *
+     * @param action action that was executed
+     * @param time execution time, excluding nested actions and rules
+     */
+    void recordAction(const Action& action, Clock::duration time);
+
+    /**
+     * Records one execution of the specified rule.
+     *
+     * Does nothing if profiling is disabled.
+     *
+     * @param ruleID ID of the rule that was executed
+     * @param time execution time, excluding nested rules
+     */
+    void recordRule(const std::string& ruleID, Clock::duration time);
+
+  private:
+    friend class ProfileScope;
+
+    /**
+     * Updates the specified entry with one execution.
+     *
+     * @param entry profiling data entry
+     * @param time execution time
+     */
+    static void update(Entry& entry, Clock::duration time)
+    {
+        ++entry.count;
+        entry.totalTime += time;
+        if (time > entry.maxTime)
+        {
+            entry.maxTime = time;
+        }
+    }
+
+    /**
+     * Indicates whether profiling is enabled.
+     */
+    bool enabled{false};
+
+    /**
+     * Profiling data for action types.
+     *
+     * The map key is the dynamic type of the action.  This avoids building the
+     * action description string for every execution.
+     */
+    std::map<std::type_index, Entry> actionEntries{};
+
+    /**
+     * Profiling data for rules.  The map key is the rule ID.
+     */
+    std::map<std::string, Entry> ruleEntries{};
+
+    /**
+     * Innermost ProfileScope that is currently measuring, if any.
+     */
+    ProfileScope* currentScope{nullptr};
+};
+
+/**
+ * @class ProfileScope
+ *
+ * Measures the execution time of one action or rule using the scope of this
+ * object.
+ *
+ * The time is recorded in the Profiler when this object is destroyed, even if
+ * an exception was thrown.  If profiling is disabled when this object is
+ * created, no time measurement is made.
+ *
+ * ProfileScope objects for nested actions and rules must be destroyed in the
+ * reverse order they were created.  The time measured by a nested object is
+ * subtracted from the time recorded by the enclosing object.  See Profiler
+ * for details.
+ */
+class ProfileScope
+{
+  public:
+    // Specify which compiler-generated methods we want
+    ProfileScope() = delete;
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope(ProfileScope&&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+    ProfileScope& operator=(ProfileScope&&) = delete;
+
+    /**
+     * Constructor for measuring an action.
+     *
+     * @param profiler profiler to record the execution time in
+     * @param action action being executed
+     */
+    explicit ProfileScope(Profiler& profiler, const Action& action) :
+        profiler{profiler}, action{&action}
+    {
+        start();
+    }
+
+    /**
+     * Constructor for measuring a rule.
+     *
+     * @param profiler profiler to record the execution time in
+     * @param ruleID ID of the rule being executed
+     */
+    explicit ProfileScope(Profiler& profiler, const std::string& ruleID) :
+        profiler{profiler}, ruleID{&ruleID}
+    {
+        start();
+    }
+
+    /**
+     * Destructor.  Records the execution time if it was measured.
+     */
+    ~ProfileScope()
+    {
+        if (isMeasuring)
+        {
+            Profiler::Clock::duration time = Profiler::Clock::now() - startTime;
+            if (action != nullptr)
+            {
+                profiler.recordAction(*action, time - nestedTime);
+            }
+            else
+            {
+                profiler.recordRule(*ruleID, time - nestedTime);
+            }
+
+            // Exclude this time from the enclosing action, if any, and from
+            // the enclosing rule if this is a rule
+            if ((parent != nullptr) && (parent->action != nullptr))
+            {
+                parent->nestedTime += time;
+            }
+            if ((ruleID != nullptr) && (parentRule != nullptr))
+            {
+                parentRule->nestedTime += time;
+            }
+            profiler.currentScope = parent;
+        }
+    }
+
+  private:
+    /**
+     * Starts measuring the execution time if profiling is enabled.
+     */
+    void start()
+    {
+        if (profiler.isEnabled())
+        {
+            parent = profiler.currentScope;
+            if (parent != nullptr)
+            {
+                parentRule = (parent->ruleID != nullptr) ? parent
+                                                         : parent->parentRule;
+            }
+            profiler.currentScope = this;
+            startTime = Profiler::Clock::now();
+            isMeasuring = true;
+        }
+    }
+
+    /**
+     * Profiler to record the execution time in.
+     */
+    Profiler& profiler;
+
+    /**
+     * Action being executed, if any.
+     */
+    const Action* action{nullptr};
+
+    /**
+     * ID of the rule being executed, if any.
+     */
+    const std::string* ruleID{nullptr};
+
+    /**
+     * Indicates whether the execution time is being measured.
+     */
+    bool isMeasuring{false};
+
+    /**
+     * Time when the execution started.
+     */
+    Profiler::Clock::time_point startTime{};
+
+    /**
+     * Enclosing ProfileScope that is measuring an action or rule, if any.
+     */
+    ProfileScope* parent{nullptr};
+
+    /**
+     * Nearest enclosing ProfileScope that is measuring a rule, if any.
+     */
+    ProfileScope* parentRule{nullptr};
+
+    /**
+     * Execution time of the nested actions and rules that is excluded from
+     * the time recorded by this object.
+     */
+    Profiler::Clock::duration nestedTime{};
+};
+
+} // namespace phosphor::power::regulators
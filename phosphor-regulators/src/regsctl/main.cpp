@@ -19,12 +19,48 @@
 #include <CLI/CLI.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <exception>
+#include <iomanip>
 #include <iostream>
 #include <string>
+#include <tuple>
+#include <vector>
 
 using namespace phosphor::power::regulators::control;
 
+/**
+ * Profiling data for one rule or action type returned by the GetProfile
+ * method: category, name, count, total usec, max usec.
+ */
+using ProfileEntry =
+    std::tuple<std::string, std::string, uint64_t, uint64_t, uint64_t>;
+
+/**
+ * Prints the profiling data for the specified category.
+ *
+ * @param entries profiling data returned by the GetProfile method
+ * @param category category to print: "rule" or "action"
+ * @param title column title for the rule ID or action type name
+ */
+void printProfile(const std::vector<ProfileEntry>& entries,
+                  const std::string& category, const std::string& title)
+{
+    std::cout << std::left << std::setw(40) << title << std::right
+              << std::setw(12) << "Calls" << std::setw(16) << "Total (us)"
+              << std::setw(12) << "Max (us)" << std::endl;
+    for (const auto& [entryCategory, name, count, totalTime, maxTime] :
+         entries)
+    {
+        if (entryCategory == category)
+        {
+            std::cout << std::left << std::setw(40) << name << std::right
+                      << std::setw(12) << count << std::setw(16) << totalTime
+                      << std::setw(12) << maxTime << std::endl;
+        }
+    }
+}
+
 int main(int argc, char* argv[])
 {
     auto rc = 0;
@@ -33,6 +69,9 @@ int main(int argc, char* argv[])
     {
         bool monitorEnable = false;
         bool monitorDisable = false;
+        bool profileEnable = false;
+        bool profileDisable = false;
+        uint64_t profileCount = 10;
 
         CLI::App app{"Regulators control app for OpenBMC phosphor-regulators"};
 
@@ -52,6 +91,20 @@ int main(int argc, char* argv[])
                           "Disable regulator monitoring");
         // Monitor subcommand requires only 1 option be provided
         monitor->require_option(1);
+        // Profile methods
+        CLI::App* profile = methods->add_subcommand(
+            "profile", "Profile rule and action execution time");
+        profile->set_help_flag("-h,--help", "Profile methods help");
+        auto profileEnableFlag = profile->add_flag(
+            "-e,--enable", profileEnable,
+            "Enable profiling; clears previous profiling data");
+        auto profileDisableFlag = profile->add_flag(
+            "-d,--disable", profileDisable, "Disable profiling");
+        profileEnableFlag->excludes(profileDisableFlag);
+        profile
+            ->add_option("-n,--count", profileCount,
+                         "Number of rules and action types to display")
+            ->capture_default_str();
         // Methods group requires only 1 subcommand to be given
         methods->require_subcommand(1);
 
@@ -65,6 +118,23 @@ int main(int argc, char* argv[])
         {
             callMethod("Monitor", monitorEnable);
         }
+        else if (app.got_subcommand("profile"))
+        {
+            if (profileEnable || profileDisable)
+            {
+                callMethod("SetProfilingEnabled", profileEnable);
+            }
+            else
+            {
+                // Display the rules and action types that took the most time
+                auto reply = callMethod("GetProfile", profileCount);
+                std::vector<ProfileEntry> entries{};
+                reply.read(entries);
+                printProfile(entries, "rule", "Rule");
+                std::cout << std::endl;
+                printProfile(entries, "action", "Action Type");
+            }
+        }
     }
     catch (const std::exception& e)
     {
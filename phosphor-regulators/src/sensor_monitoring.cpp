@@ -26,6 +26,7 @@
 #include "sensors.hpp"
 #include "system.hpp"
 
+#include <algorithm>
 #include <exception>
 
 namespace phosphor::power::regulators
@@ -48,6 +49,15 @@ void SensorMonitoring::execute(Services& services, System& system,
     sensors.startRail(rail.getID(), device.getFRU(),
                       chassis.getInventoryPath());
 
+    // If backing off due to repeated errors, skip reading the sensors during
+    // this cycle.  The sensors for this rail remain in the error state.
+    if (skipCount > 0)
+    {
+        --skipCount;
+        sensors.endRail(true, true);
+        return;
+    }
+
     // Read all sensors defined for this rail
     try
     {
@@ -58,8 +68,10 @@ void SensorMonitoring::execute(Services& services, System& system,
         // Execute the actions
         action_utils::execute(actions, environment);
 
-        // Reset consecutive error count since sensors were read successfully
+        // Reset consecutive error count and back-off since sensors were read
+        // successfully
         errorCount = 0;
+        backoffCycles = 0;
     }
     catch (const std::exception& e)
     {
@@ -79,11 +91,38 @@ void SensorMonitoring::execute(Services& services, System& system,
                                               errorHistory);
             }
         }
+
+        // If at the maximum consecutive error count, back off before trying
+        // to read the sensors again
+        if (errorCount >= maxErrorCount)
+        {
+            increaseBackoff();
+        }
     }
 
     // Notify sensors service that monitoring has ended for this rail
     bool errorOccurred = (errorCount > 0);
-    sensors.endRail(errorOccurred);
+    bool backingOff = (getHealthState() == HealthState::backingOff);
+    sensors.endRail(errorOccurred, backingOff);
+}
+
+void SensorMonitoring::increaseBackoff()
+{
+    // Double the number of cycles to skip, starting at 1.  Do not exceed the
+    // maximum.  A maximum of 0 disables backing off.
+    if (backoffCycles == 0)
+    {
+        backoffCycles = std::min(1u, maxBackoffCycles);
+    }
+    else if (backoffCycles > (maxBackoffCycles / 2))
+    {
+        backoffCycles = maxBackoffCycles;
+    }
+    else
+    {
+        backoffCycles *= 2;
+    }
+    skipCount = backoffCycles;
 }
 
 } // namespace phosphor::power::regulators
@@ -45,10 +45,46 @@ class System;
  *
  * Sensors are read by executing actions, such as PMBusReadSensorAction.  To
  * read multiple sensors for a rail, multiple actions need to be executed.
+ *
+ * If the sensors for a rail cannot be read repeatedly, sensor monitoring backs
+ * off.  Each failure after the maximum number of consecutive errors doubles the
+ * number of monitoring cycles to skip, up to a ceiling.  This prevents a
+ * failing rail from slowing down the monitoring of other rails due to I2C
+ * timeouts and retries.  The sensors remain in the error state while sensor
+ * monitoring is backing off.  The normal rate resumes after the sensors are
+ * read successfully.
  */
 class SensorMonitoring
 {
   public:
+    /**
+     * Health state of sensor monitoring for the rail.
+     */
+    enum class HealthState : unsigned char
+    {
+        /**
+         * Sensors were read successfully the last time they were read.
+         */
+        healthy,
+
+        /**
+         * Errors have occurred, but the maximum number of consecutive errors
+         * has not been reached.
+         */
+        failing,
+
+        /**
+         * The maximum number of consecutive errors has been reached.  Monitoring
+         * cycles are being skipped to reduce the load on the I2C bus.
+         */
+        backingOff
+    };
+
+    /**
+     * Default maximum number of monitoring cycles to skip when backing off.
+     */
+    static constexpr unsigned int defaultMaxBackoffCycles{60};
+
     // Specify which compiler-generated methods we want
     SensorMonitoring() = delete;
     SensorMonitoring(const SensorMonitoring&) = delete;
@@ -61,9 +97,15 @@ class SensorMonitoring
      * Constructor.
      *
      * @param actions actions that read the sensors for a rail
+     * @param maxBackoffCycles maximum number of monitoring cycles to skip when
+     *                         backing off due to repeated errors.  Specify 0 to
+     *                         disable backing off.
      */
-    explicit SensorMonitoring(std::vector<std::unique_ptr<Action>> actions) :
-        actions{std::move(actions)}
+    explicit SensorMonitoring(
+        std::vector<std::unique_ptr<Action>> actions,
+        unsigned int maxBackoffCycles = defaultMaxBackoffCycles) :
+        actions{std::move(actions)},
+        maxBackoffCycles{maxBackoffCycles}
     {}
 
     /**
@@ -78,6 +120,8 @@ class SensorMonitoring
     {
         errorHistory.clear();
         errorCount = 0;
+        backoffCycles = 0;
+        skipCount = 0;
     }
 
     /**
@@ -102,7 +146,52 @@ class SensorMonitoring
         return actions;
     }
 
+    /**
+     * Returns the current number of monitoring cycles skipped between attempts
+     * to read the sensors.
+     *
+     * Returns 0 if sensor monitoring is not backing off.
+     *
+     * @return number of monitoring cycles skipped between attempts
+     */
+    unsigned int getBackoffCycles() const
+    {
+        return backoffCycles;
+    }
+
+    /**
+     * Returns the current health state of sensor monitoring for the rail.
+     *
+     * @return health state
+     */
+    HealthState getHealthState() const
+    {
+        if (backoffCycles > 0)
+        {
+            return HealthState::backingOff;
+        }
+        return (errorCount > 0) ? HealthState::failing : HealthState::healthy;
+    }
+
+    /**
+     * Returns the maximum number of monitoring cycles to skip when backing off
+     * due to repeated errors.
+     *
+     * @return maximum number of monitoring cycles to skip
+     */
+    unsigned int getMaxBackoffCycles() const
+    {
+        return maxBackoffCycles;
+    }
+
   private:
+    /**
+     * Increases the number of monitoring cycles to skip after an error.
+     *
+     * The number of cycles doubles after each error, up to maxBackoffCycles.
+     */
+    void increaseBackoff();
+
     /**
      * Actions that read the sensors for a rail.
      */
@@ -120,6 +209,23 @@ class SensorMonitoring
      * Number of consecutive errors that have occurred.
      */
     unsigned short errorCount{0};
+
+    /**
+     * Maximum number of monitoring cycles to skip when backing off.
+     */
+    unsigned int maxBackoffCycles{defaultMaxBackoffCycles};
+
+    /**
+     * Current number of monitoring cycles skipped between attempts to read the
+     * sensors.  Set to 0 when not backing off.
+     */
+    unsigned int backoffCycles{0};
+
+    /**
+     * Number of monitoring cycles remaining to skip before the next attempt to
+     * read the sensors.
+     */
+    unsigned int skipCount{0};
 };
 
 } // namespace phosphor::power::regulators
@@ -0,0 +1,195 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sensor_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace phosphor::power::regulators
+{
+
+SensorStatistics::SensorStatistics(
+    std::size_t capacity, const std::vector<std::chrono::seconds>& windows)
+{
+    if (capacity == 0)
+    {
+        throw std::invalid_argument{"Invalid sample capacity: Must be > 0"};
+    }
+    if (windows.empty())
+    {
+        throw std::invalid_argument{"No statistics windows specified"};
+    }
+
+    // Allocate all memory now so none is needed when samples are added
+    samples.resize(capacity);
+    percentileBuffer.reserve(capacity);
+    this->windows.reserve(windows.size());
+    for (const std::chrono::seconds& duration : windows)
+    {
+        this->windows.emplace_back(duration, capacity);
+    }
+}
+
+void SensorStatistics::addSample(double value, Clock::time_point time)
+{
+    // If ring buffer is full, discard the oldest sample.  Remove it first from
+    // any windows that still contain it.
+    if (getSampleCount() == samples.size())
+    {
+        for (Window& window : windows)
+        {
+            if (window.firstSequence == oldestSequence)
+            {
+                removeOldestSample(window);
+            }
+        }
+        ++oldestSequence;
+    }
+
+    // Store new sample in ring buffer
+    uint64_t sequence = nextSequence++;
+    samples[sequence % samples.size()] = Sample{time, value};
+
+    for (Window& window : windows)
+    {
+        // Add sample to window sum
+        window.sum += value;
+
+        // Add sample to the monotonic queues.  Remove samples from the back
+        // that can never be the minimum/maximum again.
+        while (!window.minQueue.empty() &&
+               (getSample(window.minQueue.back()).value >= value))
+        {
+            window.minQueue.popBack();
+        }
+        window.minQueue.pushBack(sequence);
+
+        while (!window.maxQueue.empty() &&
+               (getSample(window.maxQueue.back()).value <= value))
+        {
+            window.maxQueue.popBack();
+        }
+        window.maxQueue.pushBack(sequence);
+
+        // Remove samples that are now outside of the window
+        removeExpiredSamples(window, time);
+    }
+}
+
+void SensorStatistics::clear()
+{
+    oldestSequence = nextSequence;
+    for (Window& window : windows)
+    {
+        window.firstSequence = nextSequence;
+        window.sum = 0.0;
+        window.minQueue.clear();
+        window.maxQueue.clear();
+    }
+}
+
+std::optional<SensorStatistics::Statistics>
+    SensorStatistics::getStatistics(std::chrono::seconds window,
+                                    Clock::time_point now)
+{
+    // Find the requested window
+    auto it = std::find_if(windows.begin(), windows.end(),
+                           [window](const Window& w) {
+                               return (w.duration == window);
+                           });
+    if (it == windows.end())
+    {
+        return std::nullopt;
+    }
+
+    // Remove samples that are now outside of the window
+    removeExpiredSamples(*it, now);
+
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    Statistics statistics{nan, nan, nan, nan, 0};
+    std::size_t count =
+        static_cast<std::size_t>(nextSequence - it->firstSequence);
+    if (count > 0)
+    {
+        statistics.count = count;
+        statistics.minimum = getSample(it->minQueue.front()).value;
+        statistics.maximum = getSample(it->maxQueue.front()).value;
+        statistics.average = it->sum / count;
+
+        // Find the 99th percentile using the nearest-rank method
+        percentileBuffer.clear();
+        for (uint64_t seq = it->firstSequence; seq < nextSequence; ++seq)
+        {
+            percentileBuffer.emplace_back(getSample(seq).value);
+        }
+        std::size_t rank =
+            static_cast<std::size_t>(std::ceil(0.99 * count)) - 1;
+        std::nth_element(percentileBuffer.begin(),
+                         percentileBuffer.begin() + rank,
+                         percentileBuffer.end());
+        statistics.p99 = percentileBuffer[rank];
+    }
+    return statistics;
+}
+
+std::vector<std::chrono::seconds> SensorStatistics::getWindows() const
+{
+    std::vector<std::chrono::seconds> durations{};
+    for (const Window& window : windows)
+    {
+        durations.emplace_back(window.duration);
+    }
+    return durations;
+}
+
+void SensorStatistics::removeExpiredSamples(Window& window,
+                                            Clock::time_point now)
+{
+    while ((window.firstSequence < nextSequence) &&
+           ((now - getSample(window.firstSequence).time) >= window.duration))
+    {
+        removeOldestSample(window);
+    }
+}
+
+void SensorStatistics::removeOldestSample(Window& window)
+{
+    uint64_t sequence = window.firstSequence++;
+    if (window.firstSequence == nextSequence)
+    {
+        // Window is now empty.  Reset sum to avoid accumulating rounding
+        // errors.
+        window.sum = 0.0;
+    }
+    else
+    {
+        window.sum -= getSample(sequence).value;
+    }
+
+    if (!window.minQueue.empty() && (window.minQueue.front() == sequence))
+    {
+        window.minQueue.popFront();
+    }
+    if (!window.maxQueue.empty() && (window.maxQueue.front() == sequence))
+    {
+        window.maxQueue.popFront();
+    }
+}
+
+} // namespace phosphor::power::regulators
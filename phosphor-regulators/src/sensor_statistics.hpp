@@ -0,0 +1,314 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace phosphor::power::regulators
+{
+
+/**
+ * @class SensorStatistics
+ *
+ * Rolling statistics for the recent values of a voltage regulator sensor.
+ *
+ * Sensor values are stored in a fixed-size ring buffer of samples.  The
+ * statistics are calculated over one or more time windows, such as the last 10
+ * seconds and the last 60 seconds.
+ *
+ * The minimum, maximum, and average value of each window are updated
+ * incrementally when a sample is added.  This requires amortized O(1) time per
+ * sample.  The 99th percentile value is calculated when the statistics are
+ * obtained since it cannot be maintained incrementally.
+ *
+ * Memory is only allocated when this object is constructed.
+ *
+ * This class is not thread-safe.  It is designed to be used by the single
+ * thread that runs the sensor monitoring event loop.
+ */
+class SensorStatistics
+{
+  public:
+    /**
+     * Clock used to timestamp samples.
+     */
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Statistics for the samples within one time window.
+     */
+    struct Statistics
+    {
+        /**
+         * Minimum sample value.
+         */
+        double minimum;
+
+        /**
+         * Maximum sample value.
+         */
+        double maximum;
+
+        /**
+         * Average (mean) sample value.
+         */
+        double average;
+
+        /**
+         * 99th percentile sample value using the nearest-rank method.
+         */
+        double p99;
+
+        /**
+         * Number of samples in the window.
+         *
+         * If the count is 0, all the other fields are NaN.
+         */
+        std::size_t count;
+    };
+
+    // Specify which compiler-generated methods we want
+    SensorStatistics() = delete;
+    SensorStatistics(const SensorStatistics&) = delete;
+    SensorStatistics(SensorStatistics&&) = delete;
+    SensorStatistics& operator=(const SensorStatistics&) = delete;
+    SensorStatistics& operator=(SensorStatistics&&) = delete;
+    ~SensorStatistics() = default;
+
+    /**
+     * Constructor.
+     *
+     * Throws invalid_argument if capacity is 0 or windows is empty.
+     *
+     * @param capacity maximum number of samples to store
+     * @param windows time windows to calculate statistics over
+     */
+    explicit SensorStatistics(std::size_t capacity,
+                              const std::vector<std::chrono::seconds>& windows);
+
+    /**
+     * Adds a sample to the statistics.
+     *
+     * Samples must be added in chronological order.
+     *
+     * If the ring buffer is full, the oldest sample is discarded.  Samples that
+     * are now older than a time window are removed from that window.
+     *
+     * @param value sensor value
+     * @param time time the sensor value was read
+     */
+    void addSample(double value, Clock::time_point time = Clock::now());
+
+    /**
+     * Removes all samples.
+     */
+    void clear();
+
+    /**
+     * Returns the maximum number of samples that can be stored.
+     *
+     * @return sample capacity
+     */
+    std::size_t getCapacity() const
+    {
+        return samples.size();
+    }
+
+    /**
+     * Returns the number of samples currently stored.
+     *
+     * @return sample count
+     */
+    std::size_t getSampleCount() const
+    {
+        return static_cast<std::size_t>(nextSequence - oldestSequence);
+    }
+
+    /**
+     * Returns the statistics for the specified time window.
+     *
+     * Samples that are older than the time window relative to the specified
+     * time are removed from the window first.
+     *
+     * @param window time window; must be one of the windows specified in the
+     *               constructor
+     * @param now current time
+     * @return statistics for the window, or an empty optional if the window
+     *         was not specified in the constructor
+     */
+    std::optional<Statistics> getStatistics(std::chrono::seconds window,
+                                            Clock::time_point now = Clock::now());
+
+    /**
+     * Returns the time windows that statistics are calculated over.
+     *
+     * @return time windows
+     */
+    std::vector<std::chrono::seconds> getWindows() const;
+
+  private:
+    /**
+     * One sensor value and the time it was read.
+     */
+    struct Sample
+    {
+        Clock::time_point time;
+        double value;
+    };
+
+    /**
+     * Fixed-capacity double-ended queue of sample sequence numbers.
+     *
+     * Used to implement the monotonic queues that track the minimum and
+     * maximum value within a window.
+     */
+    class SequenceQueue
+    {
+      public:
+        explicit SequenceQueue(std::size_t capacity) : buffer(capacity) {}
+
+        void clear()
+        {
+            head = 0;
+            size = 0;
+        }
+
+        bool empty() const
+        {
+            return (size == 0);
+        }
+
+        uint64_t front() const
+        {
+            return buffer[head];
+        }
+
+        uint64_t back() const
+        {
+            return buffer[(head + size - 1) % buffer.size()];
+        }
+
+        void popBack()
+        {
+            --size;
+        }
+
+        void popFront()
+        {
+            head = (head + 1) % buffer.size();
+            --size;
+        }
+
+        void pushBack(uint64_t sequence)
+        {
+            buffer[(head + size) % buffer.size()] = sequence;
+            ++size;
+        }
+
+      private:
+        std::vector<uint64_t> buffer;
+        std::size_t head{0};
+        std::size_t size{0};
+    };
+
+    /**
+     * Incrementally maintained statistics for one time window.
+     *
+     * The window contains the samples with sequence numbers in the range
+     * [firstSequence, nextSequence).
+     */
+    struct Window
+    {
+        Window(std::chrono::seconds duration, std::size_t capacity) :
+            duration{duration}, minQueue{capacity}, maxQueue{capacity}
+        {}
+
+        std::chrono::seconds duration;
+        uint64_t firstSequence{0};
+        double sum{0.0};
+
+        /**
+         * Sequence numbers of samples with increasing values.  The front is
+         * the minimum value in the window.
+         */
+        SequenceQueue minQueue;
+
+        /**
+         * Sequence numbers of samples with decreasing values.  The front is
+         * the maximum value in the window.
+         */
+        SequenceQueue maxQueue;
+    };
+
+    /**
+     * Returns the sample with the specified sequence number.
+     *
+     * @param sequence sample sequence number
+     * @return sample
+     */
+    const Sample& getSample(uint64_t sequence) const
+    {
+        return samples[sequence % samples.size()];
+    }
+
+    /**
+     * Removes samples from the specified window that are older than the
+     * window duration relative to the specified time.
+     *
+     * @param window time window
+     * @param now current time
+     */
+    void removeExpiredSamples(Window& window, Clock::time_point now);
+
+    /**
+     * Removes the oldest sample from the specified window.
+     *
+     * @param window time window
+     */
+    void removeOldestSample(Window& window);
+
+    /**
+     * Ring buffer of samples indexed by sequence number modulo capacity.
+     */
+    std::vector<Sample> samples;
+
+    /**
+     * Sequence number of the oldest sample stored.
+     */
+    uint64_t oldestSequence{0};
+
+    /**
+     * Sequence number to assign to the next sample added.
+     */
+    uint64_t nextSequence{0};
+
+    /**
+     * Time windows that statistics are calculated over.
+     */
+    std::vector<Window> windows{};
+
+    /**
+     * Buffer used to calculate percentiles.  Allocated once to avoid memory
+     * allocation when statistics are obtained.
+     */
+    std::vector<double> percentileBuffer{};
+};
+
+} // namespace phosphor::power::regulators
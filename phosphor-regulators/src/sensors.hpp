@@ -190,8 +190,10 @@ class Sensors
      *
      * @param errorOccurred specifies whether an error occurred while trying to
      *                      read all the sensors for the current rail
+     * @param backingOff specifies whether sensor monitoring is backing off for
+     *                   the current rail due to repeated errors
      */
-    virtual void endRail(bool errorOccurred) = 0;
+    virtual void endRail(bool errorOccurred, bool backingOff) = 0;
 
     /**
      * Disable the sensors service.
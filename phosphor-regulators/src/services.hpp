@@ -17,8 +17,10 @@
 
 #include "dbus_sensors.hpp"
 #include "error_logging.hpp"
+#include "inventory_monitor.hpp"
 #include "journal.hpp"
 #include "presence_service.hpp"
+#include "profiler.hpp"
 #include "sensors.hpp"
 #include "vpd.hpp"
 
@@ -75,6 +77,14 @@ class Services
      */
     virtual PresenceService& getPresenceService() = 0;
 
+    /**
+     * Returns the profiler that measures the execution time of actions and
+     * rules.
+     *
+     * @return profiler
+     */
+    virtual Profiler& getProfiler() = 0;
+
     /**
      * Returns the sensors interface.
      *
@@ -113,7 +123,8 @@ class BMCServices : public Services
      */
     explicit BMCServices(sdbusplus::bus::bus& bus) :
         bus{bus}, errorLogging{bus},
-        presenceService{bus}, sensors{bus}, vpd{bus}
+        presenceService{bus}, sensors{bus}, vpd{bus},
+        inventoryMonitor{bus, presenceService, vpd, journal}
     {}
 
     /** @copydoc Services::getBus() */
@@ -128,6 +139,17 @@ class BMCServices : public Services
         return errorLogging;
     }
 
+    /**
+     * Returns the object that prefetches hardware presence data and VPD values
+     * from the inventory manager.
+     *
+     * @return inventory monitor
+     */
+    InventoryMonitor& getInventoryMonitor()
+    {
+        return inventoryMonitor;
+    }
+
     /** @copydoc Services::getJournal() */
     virtual Journal& getJournal() override
     {
@@ -140,6 +162,12 @@ class BMCServices : public Services
         return presenceService;
     }
 
+    /** @copydoc Services::getProfiler() */
+    virtual Profiler& getProfiler() override
+    {
+        return profiler;
+    }
+
     /** @copydoc Services::getSensors() */
     virtual Sensors& getSensors() override
     {
@@ -174,6 +202,11 @@ class BMCServices : public Services
      */
     DBusPresenceService presenceService;
 
+    /**
+     * Profiler that measures the execution time of actions and rules.
+     */
+    Profiler profiler{};
+
     /**
      * Implementation of the Sensors interface using D-Bus.
      */
@@ -183,6 +216,12 @@ class BMCServices : public Services
      * Implementation of the VPD interface using D-Bus method calls.
      */
     DBusVPD vpd;
+
+    /**
+     * Keeps the presence and VPD caches up to date using inventory manager
+     * data.  Must be declared after the objects whose caches it updates.
+     */
+    InventoryMonitor inventoryMonitor;
 };
 
 } // namespace phosphor::power::regulators
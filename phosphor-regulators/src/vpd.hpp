@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -50,6 +51,17 @@ class VPD
      */
     virtual void clearCache(void) = 0;
 
+    /**
+     * Returns the current cache epoch.
+     *
+     * The epoch changes whenever cached hardware VPD values are cleared or
+     * modified.  Callers can store a value derived from VPD values along with
+     * the epoch.  The value remains valid while the epoch is unchanged.
+     *
+     * @return cache epoch
+     */
+    virtual uint64_t getCacheEpoch(void) const = 0;
+
     /**
      * Returns the value of the specified VPD keyword for the specified
      * inventory path.
@@ -95,12 +107,105 @@ class DBusVPD : public VPD
     virtual void clearCache(void) override
     {
         cache.clear();
+        ++cacheEpoch;
+    }
+
+    /** @copydoc VPD::getCacheEpoch() */
+    virtual uint64_t getCacheEpoch(void) const override
+    {
+        return cacheEpoch;
     }
 
     /** @copydoc VPD::getValue() */
     virtual std::vector<uint8_t> getValue(const std::string& inventoryPath,
                                           const std::string& keyword) override;
 
+    /**
+     * Returns the cached value of the specified VPD keyword for the specified
+     * inventory path, if any.
+     *
+     * Does not obtain the keyword value from D-Bus.
+     *
+     * @param inventoryPath D-Bus inventory path of the hardware
+     * @param keyword VPD keyword
+     * @return cached keyword value, or std::nullopt if none is cached
+     */
+    std::optional<std::vector<uint8_t>>
+        getCachedValue(const std::string& inventoryPath,
+                       const std::string& keyword) const
+    {
+        auto it = cache.find(inventoryPath);
+        if (it != cache.end())
+        {
+            auto keywordIt = it->second.find(keyword);
+            if (keywordIt != it->second.end())
+            {
+                return keywordIt->second;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Removes any cached value of the specified VPD keyword for the specified
+     * inventory path.
+     *
+     * The keyword value will be obtained from D-Bus the next time it is
+     * needed.
+     *
+     * @param inventoryPath D-Bus inventory path of the hardware
+     * @param keyword VPD keyword
+     */
+    void removeCachedValue(const std::string& inventoryPath,
+                           const std::string& keyword)
+    {
+        auto it = cache.find(inventoryPath);
+        if ((it != cache.end()) && (it->second.erase(keyword) > 0))
+        {
+            ++cacheEpoch;
+        }
+    }
+
+    /**
+     * Removes any cached VPD keyword values for the specified inventory path.
+     *
+     * The keyword values will be obtained from D-Bus the next time they are
+     * needed.
+     *
+     * @param inventoryPath D-Bus inventory path of the hardware
+     */
+    void removeCachedValues(const std::string& inventoryPath)
+    {
+        if (cache.erase(inventoryPath) > 0)
+        {
+            ++cacheEpoch;
+        }
+    }
+
+    /**
+     * Sets the cached value of the specified VPD keyword for the specified
+     * inventory path.
+     *
+     * Used when the keyword value has been obtained from a source other than
+     * getValue(), such as a D-Bus signal.
+     *
+     * @param inventoryPath D-Bus inventory path of the hardware
+     * @param keyword VPD keyword
+     * @param value VPD keyword value
+     */
+    void setCachedValue(const std::string& inventoryPath,
+                        const std::string& keyword,
+                        const std::vector<uint8_t>& value)
+    {
+        auto [it, wasInserted] = cache[inventoryPath].try_emplace(keyword,
+                                                                  value);
+        if (!wasInserted && (it->second != value))
+        {
+            it->second = value;
+            ++cacheEpoch;
+        }
+    }
+
   private:
     /**
      * Gets the value of the specified VPD keyword from a D-Bus interface and
@@ -144,6 +249,12 @@ class DBusVPD : public VPD
      * Map from inventory paths to VPD keywords.
      */
     std::map<std::string, KeywordMap> cache{};
+
+    /**
+     * Cache epoch.  Incremented when cached VPD values are cleared or
+     * modified.
+     */
+    uint64_t cacheEpoch{0};
 };
 
 } // namespace phosphor::power::regulators
@@ -124,4 +124,39 @@ TEST(ActionUtilsTests, Execute)
     {
         ADD_FAILURE() << "Should not have caught exception.";
     }
+
+    // Test where profiling is enabled
+    try
+    {
+        services.getProfiler().enable();
+
+        std::vector<std::unique_ptr<Action>> actions{};
+        std::unique_ptr<MockAction> action;
+
+        // Action description is only obtained the first time the action type
+        // is recorded
+        action = std::make_unique<MockAction>();
+        EXPECT_CALL(*action, execute).Times(2).WillRepeatedly(Return(true));
+        EXPECT_CALL(*action, toString)
+            .Times(1)
+            .WillOnce(Return("mock_action: { value: 1 }"));
+        actions.push_back(std::move(action));
+
+        EXPECT_EQ(action_utils::execute(actions, env), true);
+        EXPECT_EQ(action_utils::execute(actions, env), true);
+
+        std::vector<Profiler::Entry> entries =
+            services.getProfiler().getActionEntries(10);
+        EXPECT_EQ(entries.size(), 1);
+        EXPECT_EQ(entries[0].name, "mock_action");
+        EXPECT_EQ(entries[0].count, 2);
+        EXPECT_GE(entries[0].totalTime, entries[0].maxTime);
+        EXPECT_TRUE(services.getProfiler().getRuleEntries(10).empty());
+
+        services.getProfiler().disable();
+    }
+    catch (const std::exception& error)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
 }
@@ -0,0 +1,279 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "action_environment.hpp"
+#include "action_error.hpp"
+#include "device.hpp"
+#include "i2c_capture_bytes_action.hpp"
+#include "i2c_coalesced_read_action.hpp"
+#include "i2c_compare_bit_action.hpp"
+#include "i2c_compare_byte_action.hpp"
+#include "i2c_compare_bytes_action.hpp"
+#include "i2c_interface.hpp"
+#include "i2c_read_action.hpp"
+#include "id_map.hpp"
+#include "mock_services.hpp"
+#include "mocked_i2c_interface.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::regulators;
+
+using ::testing::A;
+using ::testing::NotNull;
+using ::testing::Return;
+using ::testing::SetArrayArgument;
+using ::testing::Throw;
+using ::testing::TypedEq;
+
+TEST(I2CCoalescedReadActionTests, Constructor)
+{
+    // Test where works
+    try
+    {
+        std::vector<std::unique_ptr<I2CReadAction>> actions{};
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x12, 0x01));
+        actions.emplace_back(std::make_unique<I2CCaptureBytesAction>(0x10, 2));
+        actions.emplace_back(std::make_unique<I2CCompareBitAction>(0x13, 0, 1));
+        I2CCoalescedReadAction action{std::move(actions)};
+        EXPECT_EQ(action.getRegister(), 0x10);
+        EXPECT_EQ(action.getReadSize(), 4);
+        EXPECT_EQ(action.getActions().size(), 3);
+    }
+    catch (...)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+
+    // Test where fails: Actions vector is empty
+    try
+    {
+        std::vector<std::unique_ptr<I2CReadAction>> actions{};
+        I2CCoalescedReadAction action{std::move(actions)};
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "Actions vector is empty");
+    }
+    catch (...)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+
+    // Test where fails: Register range too large
+    try
+    {
+        std::vector<std::unique_ptr<I2CReadAction>> actions{};
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x00, 0x01));
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x20, 0x01));
+        I2CCoalescedReadAction action{std::move(actions)};
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "Register range too large: 33");
+    }
+    catch (...)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+}
+
+TEST(I2CCoalescedReadActionTests, Execute)
+{
+    // Test where works: Last action returns true
+    try
+    {
+        // Create mock I2CInterface: read() returns values 0xD7, 0x96, 0x3C,
+        // 0x01.  Verify only one read occurs for all the actions.
+        std::unique_ptr<i2c::MockedI2CInterface> i2cInterface =
+            std::make_unique<i2c::MockedI2CInterface>();
+        uint8_t values[] = {0xD7, 0x96, 0x3C, 0x01};
+        EXPECT_CALL(*i2cInterface, isOpen).Times(1).WillOnce(Return(true));
+        EXPECT_CALL(*i2cInterface, read(0x10, TypedEq<uint8_t&>(4), NotNull(),
+                                        i2c::I2CInterface::Mode::I2C))
+            .Times(1)
+            .WillOnce(SetArrayArgument<2>(values, values + 4));
+        EXPECT_CALL(*i2cInterface, read(A<uint8_t>(), A<uint8_t&>())).Times(0);
+
+        // Create Device, IDMap, MockServices, and ActionEnvironment
+        Device device{
+            "vdd1", true,
+            "/xyz/openbmc_project/inventory/system/chassis/motherboard/vdd1",
+            std::move(i2cInterface)};
+        IDMap idMap{};
+        idMap.addDevice(device);
+        MockServices services{};
+        ActionEnvironment env{idMap, "vdd1", services};
+
+        // First action returns false; other actions return true
+        std::vector<std::unique_ptr<I2CReadAction>> actions{};
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x10, 0x00));
+        actions.emplace_back(std::make_unique<I2CCaptureBytesAction>(0x11, 2));
+        actions.emplace_back(std::make_unique<I2CCompareBytesAction>(
+            0x12, std::vector<uint8_t>{0x3C, 0x01}));
+        actions.emplace_back(std::make_unique<I2CCompareBitAction>(0x13, 0, 1));
+        I2CCoalescedReadAction action{std::move(actions)};
+        EXPECT_EQ(action.execute(env), true);
+        EXPECT_EQ(env.getAdditionalErrorData().size(), 1);
+        EXPECT_EQ(env.getAdditionalErrorData().at("vdd1_register_0x11"),
+                  "[ 0x96, 0x3C ]");
+    }
+    catch (...)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+
+    // Test where works: Last action returns false
+    try
+    {
+        // Create mock I2CInterface: read() returns values 0x01, 0x02
+        std::unique_ptr<i2c::MockedI2CInterface> i2cInterface =
+            std::make_unique<i2c::MockedI2CInterface>();
+        uint8_t values[] = {0x01, 0x02};
+        EXPECT_CALL(*i2cInterface, isOpen).Times(1).WillOnce(Return(true));
+        EXPECT_CALL(*i2cInterface, read(0x20, TypedEq<uint8_t&>(2), NotNull(),
+                                        i2c::I2CInterface::Mode::I2C))
+            .Times(1)
+            .WillOnce(SetArrayArgument<2>(values, values + 2));
+
+        // Create Device, IDMap, MockServices, and ActionEnvironment
+        Device device{
+            "vdd1", true,
+            "/xyz/openbmc_project/inventory/system/chassis/motherboard/vdd1",
+            std::move(i2cInterface)};
+        IDMap idMap{};
+        idMap.addDevice(device);
+        MockServices services{};
+        ActionEnvironment env{idMap, "vdd1", services};
+
+        std::vector<std::unique_ptr<I2CReadAction>> actions{};
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x20, 0x01));
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x21, 0x03));
+        I2CCoalescedReadAction action{std::move(actions)};
+        EXPECT_EQ(action.execute(env), false);
+    }
+    catch (...)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+
+    // Test where fails: Reading bytes fails
+    try
+    {
+        // Create mock I2CInterface: read() throws an I2CException
+        std::unique_ptr<i2c::MockedI2CInterface> i2cInterface =
+            std::make_unique<i2c::MockedI2CInterface>();
+        EXPECT_CALL(*i2cInterface, isOpen).Times(1).WillOnce(Return(true));
+        EXPECT_CALL(*i2cInterface, read(0x20, TypedEq<uint8_t&>(2), NotNull(),
+                                        i2c::I2CInterface::Mode::I2C))
+            .Times(1)
+            .WillOnce(Throw(i2c::I2CException{"Failed to read i2c block data",
+                                              "/dev/i2c-1", 0x70}));
+
+        // Create Device, IDMap, MockServices, and ActionEnvironment
+        Device device{
+            "vdd1", true,
+            "/xyz/openbmc_project/inventory/system/chassis/motherboard/vdd1",
+            std::move(i2cInterface)};
+        IDMap idMap{};
+        idMap.addDevice(device);
+        MockServices services{};
+        ActionEnvironment env{idMap, "vdd1", services};
+
+        std::vector<std::unique_ptr<I2CReadAction>> actions{};
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x20, 0x01));
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x21, 0x03));
+        I2CCoalescedReadAction action{std::move(actions)};
+        action.execute(env);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const ActionError& e)
+    {
+        // Verify error describes first action
+        EXPECT_STREQ(e.what(), "ActionError: i2c_compare_byte: { register: "
+                               "0x20, value: 0x1, mask: 0xFF }");
+        try
+        {
+            // Re-throw inner I2CException
+            std::rethrow_if_nested(e);
+            ADD_FAILURE() << "Should not have reached this line.";
+        }
+        catch (const i2c::I2CException& ie)
+        {
+            EXPECT_STREQ(ie.what(),
+                         "I2CException: Failed to read i2c block data: bus "
+                         "/dev/i2c-1, addr 0x70");
+        }
+        catch (...)
+        {
+            ADD_FAILURE() << "Should not have caught exception.";
+        }
+    }
+    catch (...)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
+}
+
+TEST(I2CCoalescedReadActionTests, GetActions)
+{
+    std::vector<std::unique_ptr<I2CReadAction>> actions{};
+    actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x20, 0x01));
+    actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x21, 0x03));
+    const I2CReadAction* firstAction = actions[0].get();
+    I2CCoalescedReadAction action{std::move(actions)};
+    EXPECT_EQ(action.getActions().size(), 2);
+    EXPECT_EQ(action.getActions()[0].get(), firstAction);
+}
+
+TEST(I2CCoalescedReadActionTests, GetReadSize)
+{
+    std::vector<std::unique_ptr<I2CReadAction>> actions{};
+    actions.emplace_back(std::make_unique<I2CCaptureBytesAction>(0x20, 3));
+    actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x21, 0x03));
+    I2CCoalescedReadAction action{std::move(actions)};
+    EXPECT_EQ(action.getReadSize(), 3);
+}
+
+TEST(I2CCoalescedReadActionTests, GetRegister)
+{
+    std::vector<std::unique_ptr<I2CReadAction>> actions{};
+    actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x21, 0x03));
+    actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x20, 0x01));
+    I2CCoalescedReadAction action{std::move(actions)};
+    EXPECT_EQ(action.getRegister(), 0x20);
+}
+
+TEST(I2CCoalescedReadActionTests, ToString)
+{
+    std::vector<std::unique_ptr<I2CReadAction>> actions{};
+    actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x20, 0x01));
+    actions.emplace_back(std::make_unique<I2CCaptureBytesAction>(0x21, 2));
+    I2CCoalescedReadAction action{std::move(actions)};
+    EXPECT_EQ(action.toString(),
+              "i2c_coalesced_read: { register: 0x20, count: 3, actions: [ "
+              "i2c_compare_byte: { register: 0x20, value: 0x1, mask: 0xFF }, "
+              "i2c_capture_bytes: { register: 0x21, count: 2 } ] }");
+}
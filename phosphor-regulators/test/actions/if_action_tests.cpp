@@ -15,14 +15,24 @@
  */
 #include "action.hpp"
 #include "action_environment.hpp"
+#include "action_error.hpp"
+#include "and_action.hpp"
+#include "compare_presence_action.hpp"
+#include "compare_vpd_action.hpp"
 #include "id_map.hpp"
 #include "if_action.hpp"
 #include "mock_action.hpp"
+#include "mock_presence_service.hpp"
 #include "mock_services.hpp"
+#include "mock_vpd.hpp"
+#include "not_action.hpp"
+#include "or_action.hpp"
 
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -34,6 +44,9 @@ using namespace phosphor::power::regulators;
 using ::testing::Return;
 using ::testing::Throw;
 
+static const std::string fru{
+    "/xyz/openbmc_project/inventory/system/chassis/motherboard/cpu2"};
+
 TEST(IfActionTests, Constructor)
 {
     // Test where else clause is not specified
@@ -250,6 +263,133 @@ TEST(IfActionTests, Execute)
     }
 }
 
+TEST(IfActionTests, ExecuteCachedCondition)
+{
+    // Test where condition result is cached and re-used
+    {
+        // Create mock services.  Presence service returns true once.  Cache
+        // epochs do not change.
+        MockServices services{};
+        MockPresenceService& presenceService =
+            services.getMockPresenceService();
+        EXPECT_CALL(presenceService, isPresent(fru))
+            .Times(1)
+            .WillOnce(Return(true));
+        EXPECT_CALL(presenceService, getCacheEpoch)
+            .WillRepeatedly(Return(1));
+        MockVPD& vpd = services.getMockVPD();
+        EXPECT_CALL(vpd, getCacheEpoch).WillRepeatedly(Return(5));
+
+        IDMap idMap{};
+        ActionEnvironment env{idMap, "", services};
+
+        // Create then action that is executed every time
+        std::vector<std::unique_ptr<Action>> thenActions{};
+        std::unique_ptr<MockAction> thenAction = std::make_unique<MockAction>();
+        EXPECT_CALL(*thenAction, execute).Times(3).WillRepeatedly(Return(true));
+        thenActions.push_back(std::move(thenAction));
+
+        IfAction ifAction{std::make_unique<ComparePresenceAction>(fru, true),
+                          std::move(thenActions)};
+        EXPECT_EQ(ifAction.execute(env), true);
+        EXPECT_EQ(ifAction.execute(env), true);
+        EXPECT_EQ(ifAction.execute(env), true);
+    }
+
+    // Test where cached condition result is invalidated by an epoch change
+    {
+        // Create mock services.  Presence service returns true and then false.
+        // Presence cache epoch changes between the second and third execution.
+        // Epoch is obtained twice for each execution that runs the condition.
+        MockServices services{};
+        MockPresenceService& presenceService =
+            services.getMockPresenceService();
+        EXPECT_CALL(presenceService, isPresent(fru))
+            .Times(2)
+            .WillOnce(Return(true))
+            .WillOnce(Return(false));
+        EXPECT_CALL(presenceService, getCacheEpoch)
+            .WillOnce(Return(1))
+            .WillOnce(Return(1))
+            .WillOnce(Return(1))
+            .WillRepeatedly(Return(2));
+        MockVPD& vpd = services.getMockVPD();
+        EXPECT_CALL(vpd, getCacheEpoch).WillRepeatedly(Return(0));
+
+        IDMap idMap{};
+        ActionEnvironment env{idMap, "", services};
+
+        // Create then and else actions
+        std::vector<std::unique_ptr<Action>> thenActions{};
+        std::unique_ptr<MockAction> thenAction = std::make_unique<MockAction>();
+        EXPECT_CALL(*thenAction, execute).Times(2).WillRepeatedly(Return(true));
+        thenActions.push_back(std::move(thenAction));
+
+        std::vector<std::unique_ptr<Action>> elseActions{};
+        std::unique_ptr<MockAction> elseAction = std::make_unique<MockAction>();
+        EXPECT_CALL(*elseAction, execute).Times(1).WillOnce(Return(false));
+        elseActions.push_back(std::move(elseAction));
+
+        IfAction ifAction{std::make_unique<ComparePresenceAction>(fru, true),
+                          std::move(thenActions), std::move(elseActions)};
+        EXPECT_EQ(ifAction.execute(env), true);
+        EXPECT_EQ(ifAction.execute(env), true);
+        EXPECT_EQ(ifAction.execute(env), false);
+    }
+
+    // Test where condition throws an exception.  Result is not cached.
+    {
+        MockServices services{};
+        MockPresenceService& presenceService =
+            services.getMockPresenceService();
+        EXPECT_CALL(presenceService, isPresent(fru))
+            .Times(2)
+            .WillOnce(Throw(std::runtime_error{"D-Bus error"}))
+            .WillOnce(Return(false));
+        EXPECT_CALL(presenceService, getCacheEpoch)
+            .WillRepeatedly(Return(1));
+        MockVPD& vpd = services.getMockVPD();
+        EXPECT_CALL(vpd, getCacheEpoch).WillRepeatedly(Return(0));
+
+        IDMap idMap{};
+        ActionEnvironment env{idMap, "", services};
+
+        std::vector<std::unique_ptr<Action>> thenActions{};
+        thenActions.push_back(std::make_unique<MockAction>());
+
+        IfAction ifAction{std::make_unique<ComparePresenceAction>(fru, true),
+                          std::move(thenActions)};
+        EXPECT_THROW(ifAction.execute(env), ActionError);
+        EXPECT_EQ(ifAction.execute(env), false);
+    }
+
+    // Test where condition is not cacheable.  Epochs are not obtained.
+    {
+        MockServices services{};
+        MockPresenceService& presenceService =
+            services.getMockPresenceService();
+        EXPECT_CALL(presenceService, getCacheEpoch).Times(0);
+        MockVPD& vpd = services.getMockVPD();
+        EXPECT_CALL(vpd, getCacheEpoch).Times(0);
+
+        IDMap idMap{};
+        ActionEnvironment env{idMap, "", services};
+
+        std::unique_ptr<MockAction> conditionAction =
+            std::make_unique<MockAction>();
+        EXPECT_CALL(*conditionAction, execute)
+            .Times(2)
+            .WillRepeatedly(Return(false));
+
+        std::vector<std::unique_ptr<Action>> thenActions{};
+        thenActions.push_back(std::make_unique<MockAction>());
+
+        IfAction ifAction{std::move(conditionAction), std::move(thenActions)};
+        EXPECT_EQ(ifAction.execute(env), false);
+        EXPECT_EQ(ifAction.execute(env), false);
+    }
+}
+
 TEST(IfActionTests, GetConditionAction)
 {
     MockAction* conditionAction = new MockAction{};
@@ -301,6 +441,67 @@ TEST(IfActionTests, GetElseActions)
     EXPECT_EQ(ifAction.getElseActions()[1].get(), elseAction2);
 }
 
+TEST(IfActionTests, IsConditionCacheable)
+{
+    // Test where condition is compare_presence
+    {
+        std::vector<std::unique_ptr<Action>> thenActions{};
+        IfAction ifAction{std::make_unique<ComparePresenceAction>(fru, true),
+                          std::move(thenActions)};
+        EXPECT_TRUE(ifAction.isConditionCacheable());
+    }
+
+    // Test where condition is compare_vpd
+    {
+        std::vector<std::unique_ptr<Action>> thenActions{};
+        IfAction ifAction{std::make_unique<CompareVPDAction>(
+                              fru, "CCIN", std::vector<uint8_t>{0x32, 0x44}),
+                          std::move(thenActions)};
+        EXPECT_TRUE(ifAction.isConditionCacheable());
+    }
+
+    // Test where condition is and/or/not of compare_presence and compare_vpd
+    {
+        std::vector<std::unique_ptr<Action>> orActions{};
+        orActions.push_back(std::make_unique<ComparePresenceAction>(fru, true));
+        orActions.push_back(std::make_unique<CompareVPDAction>(
+            fru, "HW", std::vector<uint8_t>{0x00, 0x01}));
+
+        std::vector<std::unique_ptr<Action>> andActions{};
+        andActions.push_back(
+            std::make_unique<NotAction>(std::make_unique<ComparePresenceAction>(
+                "/xyz/openbmc_project/inventory/system/chassis/motherboard/"
+                "cpu3",
+                false)));
+        andActions.push_back(std::make_unique<OrAction>(std::move(orActions)));
+
+        std::vector<std::unique_ptr<Action>> thenActions{};
+        IfAction ifAction{std::make_unique<AndAction>(std::move(andActions)),
+                          std::move(thenActions)};
+        EXPECT_TRUE(ifAction.isConditionCacheable());
+    }
+
+    // Test where condition contains another type of action
+    {
+        std::vector<std::unique_ptr<Action>> andActions{};
+        andActions.push_back(std::make_unique<ComparePresenceAction>(fru, true));
+        andActions.push_back(std::make_unique<MockAction>());
+
+        std::vector<std::unique_ptr<Action>> thenActions{};
+        IfAction ifAction{std::make_unique<AndAction>(std::move(andActions)),
+                          std::move(thenActions)};
+        EXPECT_FALSE(ifAction.isConditionCacheable());
+    }
+
+    // Test where condition is another type of action
+    {
+        std::vector<std::unique_ptr<Action>> thenActions{};
+        IfAction ifAction{std::make_unique<MockAction>(),
+                          std::move(thenActions)};
+        EXPECT_FALSE(ifAction.isConditionCacheable());
+    }
+}
+
 TEST(IfActionTests, ToString)
 {
     // Test where else clause is not specified
@@ -186,6 +186,45 @@ TEST(RunRuleActionTests, Execute)
     {
         ADD_FAILURE() << "Should not have caught exception.";
     }
+
+    // Test where profiling is enabled
+    try
+    {
+        // Create rule with one action
+        std::vector<std::unique_ptr<Action>> actions{};
+        std::unique_ptr<MockAction> action = std::make_unique<MockAction>();
+        EXPECT_CALL(*action, execute).Times(3).WillRepeatedly(Return(true));
+        EXPECT_CALL(*action, toString)
+            .Times(1)
+            .WillOnce(Return("mock_action: { value: 1 }"));
+        actions.push_back(std::move(action));
+        Rule rule("read_sensors_rule", std::move(actions));
+
+        // Create ActionEnvironment.  Enable profiling.
+        IDMap idMap{};
+        idMap.addRule(rule);
+        MockServices services{};
+        services.getProfiler().enable();
+        ActionEnvironment env{idMap, "", services};
+
+        // Execute RunRuleAction 3 times
+        RunRuleAction runRuleAction{"read_sensors_rule"};
+        for (int i = 1; i <= 3; ++i)
+        {
+            EXPECT_EQ(runRuleAction.execute(env), true);
+        }
+
+        std::vector<Profiler::Entry> entries =
+            services.getProfiler().getRuleEntries(10);
+        EXPECT_EQ(entries.size(), 1);
+        EXPECT_EQ(entries[0].name, "read_sensors_rule");
+        EXPECT_EQ(entries[0].count, 3);
+        EXPECT_GE(entries[0].totalTime, entries[0].maxTime);
+    }
+    catch (const std::exception& error)
+    {
+        ADD_FAILURE() << "Should not have caught exception.";
+    }
 }
 
 TEST(RunRuleActionTests, GetRuleID)
@@ -580,7 +580,7 @@ TEST_F(ChassisTests, MonitorSensors)
                                        defaultInventoryPath))
             .Times(1);
         EXPECT_CALL(sensors, setValue).Times(0);
-        EXPECT_CALL(sensors, endRail(false)).Times(2);
+        EXPECT_CALL(sensors, endRail(false, false)).Times(2);
 
         std::vector<std::unique_ptr<Device>> devices{};
 
@@ -23,6 +23,7 @@
 #include "configuration.hpp"
 #include "device.hpp"
 #include "i2c_capture_bytes_action.hpp"
+#include "i2c_coalesced_read_action.hpp"
 #include "i2c_compare_bit_action.hpp"
 #include "i2c_compare_byte_action.hpp"
 #include "i2c_compare_bytes_action.hpp"
@@ -4588,6 +4589,49 @@ TEST(ConfigFileParserTests, ParseRule)
         EXPECT_EQ(rule->getActions().size(), 3);
     }
 
+    // Test where works: coalesce_i2c_reads property is true
+    {
+        const json element = R"(
+            {
+              "id": "read_version_rule",
+              "coalesce_i2c_reads": true,
+              "actions": [
+                { "i2c_compare_byte": { "register": "0x10", "value": "0x01" } },
+                { "i2c_compare_byte": { "register": "0x11", "value": "0x02" } },
+                { "i2c_write_byte": { "register": "0x20", "value": "0x00" } }
+              ]
+            }
+        )"_json;
+        std::unique_ptr<Rule> rule = parseRule(element);
+        EXPECT_EQ(rule->getID(), "read_version_rule");
+        EXPECT_EQ(rule->getActions().size(), 2);
+        auto* coalescedAction = dynamic_cast<I2CCoalescedReadAction*>(
+            rule->getActions()[0].get());
+        ASSERT_NE(coalescedAction, nullptr);
+        EXPECT_EQ(coalescedAction->getRegister(), 0x10);
+        EXPECT_EQ(coalescedAction->getReadSize(), 2);
+        EXPECT_EQ(coalescedAction->getActions().size(), 2);
+    }
+
+    // Test where works: coalesce_i2c_reads property is false
+    {
+        const json element = R"(
+            {
+              "id": "read_version_rule",
+              "coalesce_i2c_reads": false,
+              "actions": [
+                { "i2c_compare_byte": { "register": "0x10", "value": "0x01" } },
+                { "i2c_compare_byte": { "register": "0x11", "value": "0x02" } }
+              ]
+            }
+        )"_json;
+        std::unique_ptr<Rule> rule = parseRule(element);
+        EXPECT_EQ(rule->getActions().size(), 2);
+        EXPECT_NE(dynamic_cast<I2CCompareByteAction*>(
+                      rule->getActions()[0].get()),
+                  nullptr);
+    }
+
     // Test where fails: Element is not an object
     try
     {
@@ -4671,6 +4715,26 @@ TEST(ConfigFileParserTests, ParseRule)
         EXPECT_STREQ(e.what(), "Element is not an array");
     }
 
+    // Test where fails: coalesce_i2c_reads property is invalid
+    try
+    {
+        const json element = R"(
+            {
+              "id": "read_version_rule",
+              "coalesce_i2c_reads": 1,
+              "actions": [
+                { "i2c_compare_byte": { "register": "0x10", "value": "0x01" } }
+              ]
+            }
+        )"_json;
+        parseRule(element);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "Element is not a boolean");
+    }
+
     // Test where fails: Invalid property specified
     try
     {
@@ -4952,6 +5016,22 @@ TEST(ConfigFileParserTests, ParseSensorMonitoring)
         std::unique_ptr<SensorMonitoring> sensorMonitoring =
             parseSensorMonitoring(element);
         EXPECT_EQ(sensorMonitoring->getActions().size(), 1);
+        EXPECT_EQ(sensorMonitoring->getMaxBackoffCycles(),
+                  SensorMonitoring::defaultMaxBackoffCycles);
+    }
+
+    // Test where works: max_backoff_cycles property specified
+    {
+        const json element = R"(
+            {
+              "rule_id": "read_sensors_rule",
+              "max_backoff_cycles": 10
+            }
+        )"_json;
+        std::unique_ptr<SensorMonitoring> sensorMonitoring =
+            parseSensorMonitoring(element);
+        EXPECT_EQ(sensorMonitoring->getActions().size(), 1);
+        EXPECT_EQ(sensorMonitoring->getMaxBackoffCycles(), 10);
     }
 
     // Test where fails: actions object is invalid
@@ -4986,6 +5066,23 @@ TEST(ConfigFileParserTests, ParseSensorMonitoring)
         EXPECT_STREQ(e.what(), "Element is not a string");
     }
 
+    // Test where fails: max_backoff_cycles value is invalid
+    try
+    {
+        const json element = R"(
+            {
+              "rule_id": "read_sensors_rule",
+              "max_backoff_cycles": -1
+            }
+        )"_json;
+        parseSensorMonitoring(element);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "Element is not an unsigned integer");
+    }
+
     // Test where fails: Required actions or rule_id property not specified
     try
     {
@@ -983,7 +983,7 @@ TEST_F(DeviceTests, MonitorSensors)
         EXPECT_CALL(sensors, startRail("vio0", deviceInvPath, chassisInvPath))
             .Times(1);
         EXPECT_CALL(sensors, setValue).Times(0);
-        EXPECT_CALL(sensors, endRail(false)).Times(2);
+        EXPECT_CALL(sensors, endRail(false, false)).Times(2);
 
         std::vector<std::unique_ptr<Rail>> rails{};
 
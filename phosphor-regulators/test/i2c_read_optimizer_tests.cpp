@@ -0,0 +1,133 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "action.hpp"
+#include "i2c_capture_bytes_action.hpp"
+#include "i2c_coalesced_read_action.hpp"
+#include "i2c_compare_bit_action.hpp"
+#include "i2c_compare_byte_action.hpp"
+#include "i2c_compare_bytes_action.hpp"
+#include "i2c_read_optimizer.hpp"
+#include "i2c_write_byte_action.hpp"
+#include "set_device_action.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::regulators;
+
+TEST(I2CReadOptimizerTests, Optimize)
+{
+    // Test where no actions specified
+    {
+        std::vector<std::unique_ptr<Action>> actions{};
+        i2c_read_optimizer::optimize(actions);
+        EXPECT_TRUE(actions.empty());
+    }
+
+    // Test where no I2C read actions specified
+    {
+        std::vector<std::unique_ptr<Action>> actions{};
+        actions.emplace_back(std::make_unique<SetDeviceAction>("vdd_reg"));
+        actions.emplace_back(std::make_unique<I2CWriteByteAction>(0x10, 0x01));
+        i2c_read_optimizer::optimize(actions);
+        EXPECT_EQ(actions.size(), 2);
+        EXPECT_NE(dynamic_cast<SetDeviceAction*>(actions[0].get()), nullptr);
+        EXPECT_NE(dynamic_cast<I2CWriteByteAction*>(actions[1].get()),
+                  nullptr);
+    }
+
+    // Test where adjacent and overlapping reads are combined
+    {
+        std::vector<std::unique_ptr<Action>> actions{};
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x12, 0x01));
+        actions.emplace_back(std::make_unique<I2CCaptureBytesAction>(0x10, 2));
+        actions.emplace_back(std::make_unique<I2CCompareBitAction>(0x11, 0, 1));
+        actions.emplace_back(std::make_unique<I2CCompareBytesAction>(
+            0x13, std::vector<uint8_t>{0x01, 0x02}));
+        i2c_read_optimizer::optimize(actions);
+        EXPECT_EQ(actions.size(), 1);
+        auto* action = dynamic_cast<I2CCoalescedReadAction*>(actions[0].get());
+        ASSERT_NE(action, nullptr);
+        EXPECT_EQ(action->getRegister(), 0x10);
+        EXPECT_EQ(action->getReadSize(), 5);
+        EXPECT_EQ(action->getActions().size(), 4);
+
+        // Verify order of actions is unchanged
+        EXPECT_NE(dynamic_cast<I2CCompareByteAction*>(
+                      action->getActions()[0].get()),
+                  nullptr);
+        EXPECT_NE(dynamic_cast<I2CCompareBytesAction*>(
+                      action->getActions()[3].get()),
+                  nullptr);
+    }
+
+    // Test where other actions end a group of reads
+    {
+        std::vector<std::unique_ptr<Action>> actions{};
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x10, 0x01));
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x11, 0x01));
+        actions.emplace_back(std::make_unique<I2CWriteByteAction>(0x12, 0x01));
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x12, 0x01));
+        actions.emplace_back(std::make_unique<SetDeviceAction>("vdd_reg"));
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x13, 0x01));
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x14, 0x01));
+        i2c_read_optimizer::optimize(actions);
+        EXPECT_EQ(actions.size(), 5);
+        EXPECT_NE(dynamic_cast<I2CCoalescedReadAction*>(actions[0].get()),
+                  nullptr);
+        EXPECT_NE(dynamic_cast<I2CWriteByteAction*>(actions[1].get()),
+                  nullptr);
+        EXPECT_NE(dynamic_cast<I2CCompareByteAction*>(actions[2].get()),
+                  nullptr);
+        EXPECT_NE(dynamic_cast<SetDeviceAction*>(actions[3].get()), nullptr);
+        EXPECT_NE(dynamic_cast<I2CCoalescedReadAction*>(actions[4].get()),
+                  nullptr);
+    }
+
+    // Test where register ranges are not contiguous
+    {
+        std::vector<std::unique_ptr<Action>> actions{};
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x10, 0x01));
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x12, 0x01));
+        actions.emplace_back(std::make_unique<I2CCompareByteAction>(0x13, 0x01));
+        i2c_read_optimizer::optimize(actions);
+        EXPECT_EQ(actions.size(), 2);
+        EXPECT_NE(dynamic_cast<I2CCompareByteAction*>(actions[0].get()),
+                  nullptr);
+        auto* action = dynamic_cast<I2CCoalescedReadAction*>(actions[1].get());
+        ASSERT_NE(action, nullptr);
+        EXPECT_EQ(action->getRegister(), 0x12);
+        EXPECT_EQ(action->getReadSize(), 2);
+    }
+
+    // Test where combined range would exceed maximum read size
+    {
+        std::vector<std::unique_ptr<Action>> actions{};
+        actions.emplace_back(std::make_unique<I2CCaptureBytesAction>(0x00, 31));
+        actions.emplace_back(std::make_unique<I2CCaptureBytesAction>(0x1F, 1));
+        actions.emplace_back(std::make_unique<I2CCaptureBytesAction>(0x20, 1));
+        i2c_read_optimizer::optimize(actions);
+        EXPECT_EQ(actions.size(), 2);
+        auto* action = dynamic_cast<I2CCoalescedReadAction*>(actions[0].get());
+        ASSERT_NE(action, nullptr);
+        EXPECT_EQ(action->getReadSize(), 32);
+        EXPECT_NE(dynamic_cast<I2CCaptureBytesAction*>(actions[1].get()),
+                  nullptr);
+    }
+}
@@ -0,0 +1,173 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "inventory_monitor.hpp"
+#include "mock_journal.hpp"
+#include "mock_services.hpp"
+#include "presence_service.hpp"
+#include "types.hpp"
+#include "vpd.hpp"
+
+#include <sdbusplus/bus.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::regulators;
+
+using ::testing::HasSubstr;
+
+class InventoryMonitorTests : public ::testing::Test
+{
+  protected:
+    using InterfaceMap = InventoryMonitor::InterfaceMap;
+
+    /**
+     * Inventory path of the hardware used by the tests.
+     */
+    const std::string path{
+        "/xyz/openbmc_project/inventory/system/chassis/motherboard/vdd_vrm0"};
+
+    /**
+     * Interfaces and properties of the hardware used by the tests.
+     */
+    const InterfaceMap interfaces{
+        {INVENTORY_IFACE, {{PRESENT_PROP, true}, {"PrettyName", std::string{"VRM"}}}},
+        {ASSET_IFACE,
+         {{"Model", std::string{"2D35"}}, {"PartNumber", std::string{"PN1"}}}},
+        {"com.ibm.ipzvpd.VINI",
+         {{"HW", std::vector<uint8_t>{0x00, 0x01}},
+          {"CC", std::vector<uint8_t>{0x32}}}}};
+
+    MockServices services{};
+    DBusPresenceService presenceService{services.getBus()};
+    DBusVPD vpd{services.getBus()};
+    InventoryMonitor monitor{services.getBus(), presenceService, vpd,
+                             services.getMockJournal()};
+
+    std::vector<uint8_t> bytes(const std::string& value)
+    {
+        return std::vector<uint8_t>{value.begin(), value.end()};
+    }
+};
+
+TEST_F(InventoryMonitorTests, Prefetch)
+{
+    // The inventory manager is not running, so the presence data and VPD
+    // values will be obtained individually when needed
+    EXPECT_CALL(services.getMockJournal(),
+                logError(::testing::Matcher<const std::string&>(
+                    HasSubstr("Unable to prefetch inventory data: "))))
+        .Times(1);
+    monitor.prefetch();
+    EXPECT_EQ(presenceService.getCachedValue(path), std::nullopt);
+    EXPECT_EQ(vpd.getCachedValue(path, "HW"), std::nullopt);
+}
+
+TEST_F(InventoryMonitorTests, UpdateCaches)
+{
+    // Objects of the GetManagedObjects reply or an InterfacesAdded signal
+    monitor.updateCaches(path, interfaces);
+    EXPECT_EQ(presenceService.getCachedValue(path), true);
+    EXPECT_EQ(vpd.getCachedValue(path, "Model"), bytes("2D35"));
+    EXPECT_EQ(vpd.getCachedValue(path, "CCIN"), bytes("2D35"));
+    EXPECT_EQ(vpd.getCachedValue(path, "PartNumber"), bytes("PN1"));
+    EXPECT_EQ(vpd.getCachedValue(path, "HW"),
+              (std::vector<uint8_t>{0x00, 0x01}));
+
+    // Only the HW keyword is obtained from the VINI interface
+    EXPECT_EQ(vpd.getCachedValue(path, "CC"), std::nullopt);
+    EXPECT_EQ(vpd.getCachedValue(path, "PrettyName"), std::nullopt);
+
+    // Same values do not change the cache epochs
+    auto presenceEpoch = presenceService.getCacheEpoch();
+    auto vpdEpoch = vpd.getCacheEpoch();
+    monitor.updateCaches(path, interfaces);
+    EXPECT_EQ(presenceService.getCacheEpoch(), presenceEpoch);
+    EXPECT_EQ(vpd.getCacheEpoch(), vpdEpoch);
+
+    // Different values do
+    monitor.updateCaches(path, {{INVENTORY_IFACE, {{PRESENT_PROP, false}}}});
+    EXPECT_EQ(presenceService.getCachedValue(path), false);
+    EXPECT_NE(presenceService.getCacheEpoch(), presenceEpoch);
+    EXPECT_EQ(vpd.getCacheEpoch(), vpdEpoch);
+
+    // Values of the wrong type are ignored
+    monitor.updateCaches(path,
+                         {{INVENTORY_IFACE, {{PRESENT_PROP, std::string{}}}}});
+    EXPECT_EQ(presenceService.getCachedValue(path), false);
+}
+
+TEST_F(InventoryMonitorTests, RemoveInterfaces)
+{
+    monitor.updateCaches(path, interfaces);
+
+    // Other interfaces do not affect the caches
+    monitor.removeInterfaces(path, {"xyz.openbmc_project.Other"});
+    EXPECT_EQ(presenceService.getCachedValue(path), true);
+    EXPECT_EQ(vpd.getCachedValue(path, "HW"),
+              (std::vector<uint8_t>{0x00, 0x01}));
+
+    // Removing the item interface only removes the presence value
+    auto vpdEpoch = vpd.getCacheEpoch();
+    monitor.removeInterfaces(path, {INVENTORY_IFACE});
+    EXPECT_EQ(presenceService.getCachedValue(path), std::nullopt);
+    EXPECT_EQ(vpd.getCachedValue(path, "Model"), bytes("2D35"));
+    EXPECT_EQ(vpd.getCacheEpoch(), vpdEpoch);
+
+    // Removing a VPD interface removes the VPD values
+    monitor.removeInterfaces(path, {ASSET_IFACE});
+    EXPECT_EQ(vpd.getCachedValue(path, "Model"), std::nullopt);
+    EXPECT_EQ(vpd.getCachedValue(path, "HW"), std::nullopt);
+    EXPECT_NE(vpd.getCacheEpoch(), vpdEpoch);
+}
+
+TEST_F(InventoryMonitorTests, UpdateProperties)
+{
+    monitor.updateCaches(path, interfaces);
+
+    // Changed properties
+    monitor.updateProperties(path, INVENTORY_IFACE, {{PRESENT_PROP, false}},
+                             {});
+    EXPECT_EQ(presenceService.getCachedValue(path), false);
+    monitor.updateProperties(path, ASSET_IFACE,
+                             {{"Model", std::string{"2D36"}}}, {});
+    EXPECT_EQ(vpd.getCachedValue(path, "Model"), bytes("2D36"));
+    EXPECT_EQ(vpd.getCachedValue(path, "CCIN"), bytes("2D36"));
+
+    // Invalidated properties are removed from the caches
+    auto vpdEpoch = vpd.getCacheEpoch();
+    monitor.updateProperties(path, ASSET_IFACE, {}, {"Model"});
+    EXPECT_EQ(vpd.getCachedValue(path, "Model"), std::nullopt);
+    EXPECT_EQ(vpd.getCachedValue(path, "CCIN"), std::nullopt);
+    EXPECT_EQ(vpd.getCachedValue(path, "PartNumber"), bytes("PN1"));
+    EXPECT_NE(vpd.getCacheEpoch(), vpdEpoch);
+
+    monitor.updateProperties(path, "com.ibm.ipzvpd.VINI", {}, {"HW"});
+    EXPECT_EQ(vpd.getCachedValue(path, "HW"), std::nullopt);
+
+    // Invalidated properties of other interfaces are ignored
+    monitor.updateProperties(path, "xyz.openbmc_project.Other", {},
+                             {PRESENT_PROP});
+    EXPECT_EQ(presenceService.getCachedValue(path), false);
+
+    monitor.updateProperties(path, INVENTORY_IFACE, {}, {PRESENT_PROP});
+    EXPECT_EQ(presenceService.getCachedValue(path), std::nullopt);
+}
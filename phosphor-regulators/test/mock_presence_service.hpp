@@ -40,6 +40,8 @@ class MockPresenceService : public PresenceService
 
     MOCK_METHOD(void, clearCache, (), (override));
 
+    MOCK_METHOD(uint64_t, getCacheEpoch, (), (const, override));
+
     MOCK_METHOD(bool, isPresent, (const std::string& inventoryPath),
                 (override));
 };
@@ -44,7 +44,8 @@ class MockSensors : public Sensors
 
     MOCK_METHOD(void, endCycle, (), (override));
 
-    MOCK_METHOD(void, endRail, (bool errorOccurred), (override));
+    MOCK_METHOD(void, endRail, (bool errorOccurred, bool backingOff),
+                (override));
 
     MOCK_METHOD(void, disable, (), (override));
 
@@ -23,6 +23,7 @@
 #include "mock_sensors.hpp"
 #include "mock_vpd.hpp"
 #include "presence_service.hpp"
+#include "profiler.hpp"
 #include "sensors.hpp"
 #include "services.hpp"
 #include "vpd.hpp"
@@ -72,6 +73,12 @@ class MockServices : public Services
         return presenceService;
     }
 
+    /** @copydoc Services::getProfiler() */
+    virtual Profiler& getProfiler() override
+    {
+        return profiler;
+    }
+
     /** @copydoc Services::getSensors() */
     virtual Sensors& getSensors() override
     {
@@ -167,6 +174,11 @@ class MockServices : public Services
      */
     MockPresenceService presenceService{};
 
+    /**
+     * Profiler that measures the execution time of actions and rules.
+     */
+    Profiler profiler{};
+
     /**
      * Mock implementation of the Sensors interface.
      */
@@ -40,6 +40,8 @@ class MockVPD : public VPD
 
     MOCK_METHOD(void, clearCache, (), (override));
 
+    MOCK_METHOD(uint64_t, getCacheEpoch, (), (const, override));
+
     MOCK_METHOD(std::vector<uint8_t>, getValue,
                 (const std::string& inventoryPath, const std::string& keyword),
                 (override));
@@ -0,0 +1,230 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "profiler.hpp"
+#include "run_rule_action.hpp"
+#include "set_device_action.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::regulators;
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+TEST(ProfilerTests, Constructor)
+{
+    Profiler profiler{};
+    EXPECT_FALSE(profiler.isEnabled());
+    EXPECT_TRUE(profiler.getActionEntries(10).empty());
+    EXPECT_TRUE(profiler.getRuleEntries(10).empty());
+}
+
+TEST(ProfilerTests, Clear)
+{
+    Profiler profiler{};
+    profiler.enable();
+    profiler.recordAction(SetDeviceAction{"vdd_reg"}, microseconds{5});
+    profiler.recordRule("read_sensors_rule", microseconds{5});
+    EXPECT_EQ(profiler.getActionEntries(10).size(), 1);
+    EXPECT_EQ(profiler.getRuleEntries(10).size(), 1);
+
+    profiler.clear();
+    EXPECT_TRUE(profiler.isEnabled());
+    EXPECT_TRUE(profiler.getActionEntries(10).empty());
+    EXPECT_TRUE(profiler.getRuleEntries(10).empty());
+}
+
+TEST(ProfilerTests, Disable)
+{
+    Profiler profiler{};
+    profiler.enable();
+    profiler.recordRule("read_sensors_rule", microseconds{5});
+
+    // Verify data is retained but no longer recorded
+    profiler.disable();
+    EXPECT_FALSE(profiler.isEnabled());
+    profiler.recordRule("read_sensors_rule", microseconds{5});
+    profiler.recordRule("set_voltage_rule", microseconds{5});
+    std::vector<Profiler::Entry> entries = profiler.getRuleEntries(10);
+    EXPECT_EQ(entries.size(), 1);
+    EXPECT_EQ(entries[0].count, 1);
+}
+
+TEST(ProfilerTests, Enable)
+{
+    Profiler profiler{};
+
+    // Verify no data recorded while disabled
+    profiler.recordRule("read_sensors_rule", microseconds{5});
+    EXPECT_TRUE(profiler.getRuleEntries(10).empty());
+
+    profiler.enable();
+    EXPECT_TRUE(profiler.isEnabled());
+    profiler.recordRule("read_sensors_rule", microseconds{5});
+    EXPECT_EQ(profiler.getRuleEntries(10).size(), 1);
+
+    // Verify enabling again clears previous data
+    profiler.enable();
+    EXPECT_TRUE(profiler.getRuleEntries(10).empty());
+}
+
+TEST(ProfilerTests, GetActionEntries)
+{
+    Profiler profiler{};
+    profiler.enable();
+
+    // Action types are identified by their dynamic type, not their properties
+    profiler.recordAction(SetDeviceAction{"vdd_reg"}, microseconds{10});
+    profiler.recordAction(SetDeviceAction{"vio_reg"}, microseconds{30});
+    profiler.recordAction(RunRuleAction{"read_sensors_rule"},
+                          microseconds{100});
+
+    // Entries are sorted by total time in descending order
+    std::vector<Profiler::Entry> entries = profiler.getActionEntries(10);
+    EXPECT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries[0].name, "run_rule");
+    EXPECT_EQ(entries[0].count, 1);
+    EXPECT_EQ(entries[0].totalTime, microseconds{100});
+    EXPECT_EQ(entries[0].maxTime, microseconds{100});
+    EXPECT_EQ(entries[1].name, "set_device");
+    EXPECT_EQ(entries[1].count, 2);
+    EXPECT_EQ(entries[1].totalTime, microseconds{40});
+    EXPECT_EQ(entries[1].maxTime, microseconds{30});
+
+    // Test where number of entries is limited
+    entries = profiler.getActionEntries(1);
+    EXPECT_EQ(entries.size(), 1);
+    EXPECT_EQ(entries[0].name, "run_rule");
+}
+
+TEST(ProfilerTests, GetRuleEntries)
+{
+    Profiler profiler{};
+    profiler.enable();
+
+    profiler.recordRule("set_voltage_rule", microseconds{20});
+    profiler.recordRule("read_sensors_rule", microseconds{50});
+    profiler.recordRule("read_sensors_rule", microseconds{70});
+    profiler.recordRule("set_voltage_rule", microseconds{5});
+
+    // Entries are sorted by total time in descending order
+    std::vector<Profiler::Entry> entries = profiler.getRuleEntries(10);
+    EXPECT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries[0].name, "read_sensors_rule");
+    EXPECT_EQ(entries[0].count, 2);
+    EXPECT_EQ(entries[0].totalTime, microseconds{120});
+    EXPECT_EQ(entries[0].maxTime, microseconds{70});
+    EXPECT_EQ(entries[1].name, "set_voltage_rule");
+    EXPECT_EQ(entries[1].count, 2);
+    EXPECT_EQ(entries[1].totalTime, microseconds{25});
+    EXPECT_EQ(entries[1].maxTime, microseconds{20});
+
+    // Test where number of entries is limited
+    EXPECT_TRUE(profiler.getRuleEntries(0).empty());
+}
+
+TEST(ProfilerTests, ProfileScope)
+{
+    Profiler profiler{};
+
+    // Test where profiling is disabled
+    {
+        SetDeviceAction action{"vdd_reg"};
+        ProfileScope scope{profiler, action};
+    }
+    EXPECT_TRUE(profiler.getActionEntries(10).empty());
+
+    // Test where action is measured
+    profiler.enable();
+    {
+        SetDeviceAction action{"vdd_reg"};
+        ProfileScope scope{profiler, action};
+    }
+    EXPECT_EQ(profiler.getActionEntries(10).size(), 1);
+    EXPECT_EQ(profiler.getActionEntries(10)[0].name, "set_device");
+
+    // Test where rule is measured and an exception is thrown
+    try
+    {
+        std::string ruleID{"read_sensors_rule"};
+        ProfileScope scope{profiler, ruleID};
+        throw std::runtime_error{"Communication error"};
+    }
+    catch (const std::runtime_error&)
+    {}
+    std::vector<Profiler::Entry> entries = profiler.getRuleEntries(10);
+    EXPECT_EQ(entries.size(), 1);
+    EXPECT_EQ(entries[0].name, "read_sensors_rule");
+    EXPECT_EQ(entries[0].count, 1);
+}
+
+TEST(ProfilerTests, ProfileScopeNested)
+{
+    Profiler profiler{};
+    profiler.enable();
+
+    // Measure a rule that sleeps and then runs another rule that contains an
+    // action that sleeps longer
+    std::string outerRuleID{"set_voltage_rule"};
+    std::string innerRuleID{"read_sensors_rule"};
+    RunRuleAction runRuleAction{innerRuleID};
+    SetDeviceAction setDeviceAction{"vdd_reg"};
+    {
+        ProfileScope outerRuleScope{profiler, outerRuleID};
+        std::this_thread::sleep_for(milliseconds{10});
+        {
+            ProfileScope runRuleScope{profiler, runRuleAction};
+            {
+                ProfileScope innerRuleScope{profiler, innerRuleID};
+                {
+                    ProfileScope setDeviceScope{profiler, setDeviceAction};
+                    std::this_thread::sleep_for(milliseconds{50});
+                }
+            }
+        }
+    }
+
+    // Verify the time of the inner rule is only counted once
+    std::vector<Profiler::Entry> rules = profiler.getRuleEntries(10);
+    EXPECT_EQ(rules.size(), 2);
+    EXPECT_EQ(rules[0].name, innerRuleID);
+    EXPECT_GE(rules[0].totalTime, milliseconds{50});
+    EXPECT_EQ(rules[1].name, outerRuleID);
+    EXPECT_GE(rules[1].totalTime, milliseconds{10});
+
+    // Verify the run_rule action does not include the time of the rule
+    std::vector<Profiler::Entry> actions = profiler.getActionEntries(10);
+    EXPECT_EQ(actions.size(), 2);
+    EXPECT_EQ(actions[0].name, "set_device");
+    EXPECT_GE(actions[0].totalTime, milliseconds{50});
+    EXPECT_EQ(actions[1].name, "run_rule");
+    EXPECT_LT(actions[1].totalTime, milliseconds{10});
+    EXPECT_EQ(actions[1].maxTime, actions[1].totalTime);
+
+    // Verify a scope created after the nested scopes is not affected by them
+    {
+        ProfileScope setDeviceScope{profiler, setDeviceAction};
+    }
+    actions = profiler.getActionEntries(10);
+    EXPECT_EQ(actions[0].name, "set_device");
+    EXPECT_EQ(actions[0].count, 2);
+}
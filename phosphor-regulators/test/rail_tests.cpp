@@ -143,7 +143,8 @@ TEST(RailTests, ClearErrorHistory)
         MockSensors& sensors = services.getMockSensors();
         EXPECT_CALL(sensors, startRail).Times(10);
         EXPECT_CALL(sensors, setValue).Times(0);
-        EXPECT_CALL(sensors, endRail(true)).Times(10);
+        EXPECT_CALL(sensors, endRail(true, false)).Times(5);
+        EXPECT_CALL(sensors, endRail(true, true)).Times(5);
 
         // Expect Journal service to be called 6 times to log error messages
         MockJournal& journal = services.getMockJournal();
@@ -380,7 +381,7 @@ TEST(RailTests, MonitorSensors)
                               chassisInvPath))
             .Times(1);
         EXPECT_CALL(sensors, setValue).Times(0);
-        EXPECT_CALL(sensors, endRail(false)).Times(1);
+        EXPECT_CALL(sensors, endRail(false, false)).Times(1);
 
         // Create SensorMonitoring
         std::unique_ptr<MockAction> action = std::make_unique<MockAction>();
@@ -119,11 +119,29 @@ std::tuple<std::unique_ptr<System>, Chassis*, Device*, i2c::MockedI2CInterface*,
 
 TEST(SensorMonitoringTests, Constructor)
 {
-    std::vector<std::unique_ptr<Action>> actions{};
-    actions.push_back(std::make_unique<MockAction>());
+    // Test where maxBackoffCycles not specified
+    {
+        std::vector<std::unique_ptr<Action>> actions{};
+        actions.push_back(std::make_unique<MockAction>());
+
+        SensorMonitoring sensorMonitoring(std::move(actions));
+        EXPECT_EQ(sensorMonitoring.getActions().size(), 1);
+        EXPECT_EQ(sensorMonitoring.getMaxBackoffCycles(),
+                  SensorMonitoring::defaultMaxBackoffCycles);
+        EXPECT_EQ(sensorMonitoring.getBackoffCycles(), 0);
+        EXPECT_EQ(sensorMonitoring.getHealthState(),
+                  SensorMonitoring::HealthState::healthy);
+    }
 
-    SensorMonitoring sensorMonitoring(std::move(actions));
-    EXPECT_EQ(sensorMonitoring.getActions().size(), 1);
+    // Test where maxBackoffCycles specified
+    {
+        std::vector<std::unique_ptr<Action>> actions{};
+        actions.push_back(std::make_unique<MockAction>());
+
+        SensorMonitoring sensorMonitoring(std::move(actions), 10);
+        EXPECT_EQ(sensorMonitoring.getActions().size(), 1);
+        EXPECT_EQ(sensorMonitoring.getMaxBackoffCycles(), 10);
+    }
 }
 
 TEST(SensorMonitoringTests, ClearErrorHistory)
@@ -159,7 +177,8 @@ TEST(SensorMonitoringTests, ClearErrorHistory)
         MockSensors& sensors = services.getMockSensors();
         EXPECT_CALL(sensors, startRail).Times(10);
         EXPECT_CALL(sensors, setValue).Times(0);
-        EXPECT_CALL(sensors, endRail(true)).Times(10);
+        EXPECT_CALL(sensors, endRail(true, false)).Times(5);
+        EXPECT_CALL(sensors, endRail(true, true)).Times(5);
 
         // Expect Journal service to be called 6 times to log error messages
         MockJournal& journal = services.getMockJournal();
@@ -183,9 +202,14 @@ TEST(SensorMonitoringTests, ClearErrorHistory)
             monitoring->execute(services, *system, *chassis, *device, *rail);
         }
     }
+    EXPECT_EQ(monitoring->getHealthState(),
+              SensorMonitoring::HealthState::backingOff);
 
     // Clear error history
     monitoring->clearErrorHistory();
+    EXPECT_EQ(monitoring->getHealthState(),
+              SensorMonitoring::HealthState::healthy);
+    EXPECT_EQ(monitoring->getBackoffCycles(), 0);
 
     // Call execute() 10 more times.  Should log errors again.
     {
@@ -238,7 +262,7 @@ TEST(SensorMonitoringTests, Execute)
                               "/xyz/openbmc_project/inventory/system/chassis"))
             .Times(1);
         EXPECT_CALL(sensors, setValue(SensorType::iout, 11.5)).Times(1);
-        EXPECT_CALL(sensors, endRail(false)).Times(1);
+        EXPECT_CALL(sensors, endRail(false, false)).Times(1);
 
         // Execute SensorMonitoring
         monitoring->execute(services, *system, *chassis, *device, *rail);
@@ -273,7 +297,8 @@ TEST(SensorMonitoringTests, Execute)
         // Create lambda that sets MockServices expectations.  The lambda allows
         // us to set expectations multiple times without duplicate code.
         auto setExpectations = [](MockServices& services, int executeCount,
-                                  int journalCount, int errorLogCount) {
+                                  bool backingOff, int journalCount,
+                                  int errorLogCount) {
             // Set Sensors service expectations
             MockSensors& sensors = services.getMockSensors();
             EXPECT_CALL(
@@ -284,7 +309,8 @@ TEST(SensorMonitoringTests, Execute)
                           "/xyz/openbmc_project/inventory/system/chassis"))
                 .Times(executeCount);
             EXPECT_CALL(sensors, setValue).Times(0);
-            EXPECT_CALL(sensors, endRail(true)).Times(executeCount);
+            EXPECT_CALL(sensors, endRail(true, backingOff))
+                .Times(executeCount);
 
             // Set Journal service expectations
             MockJournal& journal = services.getMockJournal();
@@ -311,7 +337,7 @@ TEST(SensorMonitoringTests, Execute)
         {
             // Create mock services.  Set expectations via lambda.
             MockServices services{};
-            setExpectations(services, 5, 5, 0);
+            setExpectations(services, 5, false, 5, 0);
 
             for (int i = 1; i <= 5; ++i)
             {
@@ -325,7 +351,7 @@ TEST(SensorMonitoringTests, Execute)
         {
             // Create mock services.  Set expectations via lambda.
             MockServices services{};
-            setExpectations(services, 1, 1, 1);
+            setExpectations(services, 1, true, 1, 1);
 
             monitoring->execute(services, *system, *chassis, *device, *rail);
         }
@@ -335,7 +361,7 @@ TEST(SensorMonitoringTests, Execute)
         {
             // Create mock services.  Set expectations via lambda.
             MockServices services{};
-            setExpectations(services, 5, 0, 0);
+            setExpectations(services, 5, true, 0, 0);
 
             for (int i = 1; i <= 5; ++i)
             {
@@ -346,6 +372,121 @@ TEST(SensorMonitoringTests, Execute)
     }
 }
 
+TEST(SensorMonitoringTests, ExecuteBackoff)
+{
+    // Create PMBusReadSensorAction
+    SensorType type{SensorType::iout};
+    uint8_t command{0x8C};
+    SensorDataFormat format{SensorDataFormat::linear_11};
+    std::optional<int8_t> exponent{};
+    std::unique_ptr<PMBusReadSensorAction> action =
+        std::make_unique<PMBusReadSensorAction>(type, command, format,
+                                                exponent);
+
+    // Create SensorMonitoring.  Skip at most 4 monitoring cycles.
+    std::vector<std::unique_ptr<Action>> actions{};
+    actions.emplace_back(std::move(action));
+    SensorMonitoring* monitoring = new SensorMonitoring(std::move(actions), 4);
+
+    // Create parent objects that contain SensorMonitoring
+    auto [system, chassis, device, i2cInterface, rail] =
+        createParentObjects(std::unique_ptr<SensorMonitoring>{monitoring});
+
+    // Call execute() 16 times with all reads failing.  Reads should occur
+    // during cycles 1-6, 8, 11, and 16.  Cycles 7, 9-10, and 12-15 should be
+    // skipped due to back-off.
+    {
+        EXPECT_CALL(*i2cInterface, isOpen).WillRepeatedly(Return(true));
+        EXPECT_CALL(*i2cInterface, read(TypedEq<uint8_t>(0x8C), A<uint16_t&>()))
+            .Times(9)
+            .WillRepeatedly(Throw(i2c::I2CException{"Failed to read word data",
+                                                    "/dev/i2c-1", 0x70}));
+
+        // Create mock services.  Set expectations.
+        MockServices services{};
+        MockSensors& sensors = services.getMockSensors();
+        EXPECT_CALL(sensors, startRail).Times(16);
+        EXPECT_CALL(sensors, setValue).Times(0);
+        EXPECT_CALL(sensors, endRail(true, false)).Times(5);
+        EXPECT_CALL(sensors, endRail(true, true)).Times(11);
+        MockJournal& journal = services.getMockJournal();
+        EXPECT_CALL(journal, logError(A<const std::vector<std::string>&>()))
+            .Times(6);
+        EXPECT_CALL(journal, logError(A<const std::string&>())).Times(6);
+        MockErrorLogging& errorLogging = services.getMockErrorLogging();
+        EXPECT_CALL(errorLogging, logI2CError).Times(1);
+
+        for (int i = 1; i <= 5; ++i)
+        {
+            monitoring->execute(services, *system, *chassis, *device, *rail);
+            EXPECT_EQ(monitoring->getHealthState(),
+                      SensorMonitoring::HealthState::failing);
+            EXPECT_EQ(monitoring->getBackoffCycles(), 0);
+        }
+
+        // Cycle 6: Maximum error count reached; skip 1 cycle
+        monitoring->execute(services, *system, *chassis, *device, *rail);
+        EXPECT_EQ(monitoring->getHealthState(),
+                  SensorMonitoring::HealthState::backingOff);
+        EXPECT_EQ(monitoring->getBackoffCycles(), 1);
+
+        // Cycles 7-8: Skip 1 cycle, then read fails; skip 2 cycles
+        for (int i = 7; i <= 8; ++i)
+        {
+            monitoring->execute(services, *system, *chassis, *device, *rail);
+        }
+        EXPECT_EQ(monitoring->getBackoffCycles(), 2);
+
+        // Cycles 9-11: Skip 2 cycles, then read fails; skip 4 cycles
+        for (int i = 9; i <= 11; ++i)
+        {
+            monitoring->execute(services, *system, *chassis, *device, *rail);
+        }
+        EXPECT_EQ(monitoring->getBackoffCycles(), 4);
+
+        // Cycles 12-16: Skip 4 cycles, then read fails; limited to 4 cycles
+        for (int i = 12; i <= 16; ++i)
+        {
+            monitoring->execute(services, *system, *chassis, *device, *rail);
+        }
+        EXPECT_EQ(monitoring->getBackoffCycles(), 4);
+    }
+
+    // Call execute() 6 more times with all reads succeeding.  Cycles 17-20
+    // should be skipped.  Reads should occur during cycles 21-22.
+    {
+        ::testing::Mock::VerifyAndClearExpectations(i2cInterface);
+        EXPECT_CALL(*i2cInterface, isOpen).WillRepeatedly(Return(true));
+        EXPECT_CALL(*i2cInterface, read(TypedEq<uint8_t>(0x8C), A<uint16_t&>()))
+            .Times(2)
+            .WillRepeatedly(SetArgReferee<1>(0xD2E0));
+
+        // Create mock services.  Set expectations.
+        MockServices services{};
+        MockSensors& sensors = services.getMockSensors();
+        EXPECT_CALL(sensors, startRail).Times(6);
+        EXPECT_CALL(sensors, setValue(SensorType::iout, 11.5)).Times(2);
+        EXPECT_CALL(sensors, endRail(true, true)).Times(4);
+        EXPECT_CALL(sensors, endRail(false, false)).Times(2);
+
+        for (int i = 17; i <= 20; ++i)
+        {
+            monitoring->execute(services, *system, *chassis, *device, *rail);
+            EXPECT_EQ(monitoring->getHealthState(),
+                      SensorMonitoring::HealthState::backingOff);
+        }
+
+        // Cycle 21: Read succeeds; back-off ends
+        monitoring->execute(services, *system, *chassis, *device, *rail);
+        EXPECT_EQ(monitoring->getHealthState(),
+                  SensorMonitoring::HealthState::healthy);
+        EXPECT_EQ(monitoring->getBackoffCycles(), 0);
+
+        // Cycle 22: Read succeeds
+        monitoring->execute(services, *system, *chassis, *device, *rail);
+    }
+}
+
 TEST(SensorMonitoringTests, GetActions)
 {
     std::vector<std::unique_ptr<Action>> actions{};
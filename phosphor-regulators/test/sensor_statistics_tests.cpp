@@ -0,0 +1,208 @@
+/**
+ * Copyright © 2021 IBM Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sensor_statistics.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace phosphor::power::regulators;
+
+using std::chrono::seconds;
+
+TEST(SensorStatisticsTests, Constructor)
+{
+    // Test where works
+    {
+        SensorStatistics statistics{64, {seconds{10}, seconds{60}}};
+        EXPECT_EQ(statistics.getCapacity(), 64);
+        EXPECT_EQ(statistics.getSampleCount(), 0);
+        EXPECT_EQ(statistics.getWindows().size(), 2);
+        EXPECT_EQ(statistics.getWindows()[0], seconds{10});
+        EXPECT_EQ(statistics.getWindows()[1], seconds{60});
+    }
+
+    // Test where fails: Capacity is 0
+    try
+    {
+        SensorStatistics statistics{0, {seconds{10}}};
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "Invalid sample capacity: Must be > 0");
+    }
+
+    // Test where fails: No windows specified
+    try
+    {
+        SensorStatistics statistics{64, {}};
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_STREQ(e.what(), "No statistics windows specified");
+    }
+}
+
+TEST(SensorStatisticsTests, AddSample)
+{
+    SensorStatistics::Clock::time_point time{};
+
+    // Test where samples expire from the shorter window
+    {
+        SensorStatistics statistics{64, {seconds{3}, seconds{60}}};
+        std::vector<double> values{5.0, 1.0, 4.0, 2.0, 3.0};
+        for (double value : values)
+        {
+            time += seconds{1};
+            statistics.addSample(value, time);
+        }
+        EXPECT_EQ(statistics.getSampleCount(), 5);
+
+        // 3 second window contains 4.0, 2.0, 3.0
+        auto shortStats = statistics.getStatistics(seconds{3}, time);
+        ASSERT_TRUE(shortStats.has_value());
+        EXPECT_EQ(shortStats->count, 3);
+        EXPECT_DOUBLE_EQ(shortStats->minimum, 2.0);
+        EXPECT_DOUBLE_EQ(shortStats->maximum, 4.0);
+        EXPECT_DOUBLE_EQ(shortStats->average, 3.0);
+        EXPECT_DOUBLE_EQ(shortStats->p99, 4.0);
+
+        // 60 second window contains all samples
+        auto longStats = statistics.getStatistics(seconds{60}, time);
+        ASSERT_TRUE(longStats.has_value());
+        EXPECT_EQ(longStats->count, 5);
+        EXPECT_DOUBLE_EQ(longStats->minimum, 1.0);
+        EXPECT_DOUBLE_EQ(longStats->maximum, 5.0);
+        EXPECT_DOUBLE_EQ(longStats->average, 3.0);
+        EXPECT_DOUBLE_EQ(longStats->p99, 5.0);
+    }
+
+    // Test where ring buffer is full and oldest samples are discarded
+    {
+        SensorStatistics statistics{4, {seconds{60}}};
+        std::vector<double> values{9.0, 1.0, 2.0, 3.0, 4.0, 5.0};
+        for (double value : values)
+        {
+            time += seconds{1};
+            statistics.addSample(value, time);
+        }
+        EXPECT_EQ(statistics.getSampleCount(), 4);
+
+        auto stats = statistics.getStatistics(seconds{60}, time);
+        ASSERT_TRUE(stats.has_value());
+        EXPECT_EQ(stats->count, 4);
+        EXPECT_DOUBLE_EQ(stats->minimum, 2.0);
+        EXPECT_DOUBLE_EQ(stats->maximum, 5.0);
+        EXPECT_DOUBLE_EQ(stats->average, 3.5);
+    }
+
+    // Test where 99th percentile excludes the highest value
+    {
+        SensorStatistics statistics{256, {seconds{300}}};
+        for (int i = 1; i <= 200; ++i)
+        {
+            time += seconds{1};
+            statistics.addSample(static_cast<double>(i), time);
+        }
+
+        auto stats = statistics.getStatistics(seconds{300}, time);
+        ASSERT_TRUE(stats.has_value());
+        EXPECT_EQ(stats->count, 200);
+        EXPECT_DOUBLE_EQ(stats->minimum, 1.0);
+        EXPECT_DOUBLE_EQ(stats->maximum, 200.0);
+        EXPECT_DOUBLE_EQ(stats->average, 100.5);
+        EXPECT_DOUBLE_EQ(stats->p99, 198.0);
+    }
+}
+
+TEST(SensorStatisticsTests, Clear)
+{
+    SensorStatistics::Clock::time_point time{};
+    SensorStatistics statistics{64, {seconds{60}}};
+    for (int i = 1; i <= 10; ++i)
+    {
+        time += seconds{1};
+        statistics.addSample(static_cast<double>(i), time);
+    }
+    EXPECT_EQ(statistics.getSampleCount(), 10);
+
+    statistics.clear();
+    EXPECT_EQ(statistics.getSampleCount(), 0);
+    auto stats = statistics.getStatistics(seconds{60}, time);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->count, 0);
+
+    // Verify samples can be added after clearing
+    time += seconds{1};
+    statistics.addSample(42.0, time);
+    stats = statistics.getStatistics(seconds{60}, time);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->count, 1);
+    EXPECT_DOUBLE_EQ(stats->minimum, 42.0);
+    EXPECT_DOUBLE_EQ(stats->maximum, 42.0);
+    EXPECT_DOUBLE_EQ(stats->average, 42.0);
+    EXPECT_DOUBLE_EQ(stats->p99, 42.0);
+}
+
+TEST(SensorStatisticsTests, GetStatistics)
+{
+    SensorStatistics::Clock::time_point time{};
+    SensorStatistics statistics{64, {seconds{10}}};
+
+    // Test where window was not specified in constructor
+    EXPECT_FALSE(statistics.getStatistics(seconds{20}, time).has_value());
+
+    // Test where window contains no samples
+    {
+        auto stats = statistics.getStatistics(seconds{10}, time);
+        ASSERT_TRUE(stats.has_value());
+        EXPECT_EQ(stats->count, 0);
+        EXPECT_TRUE(std::isnan(stats->minimum));
+        EXPECT_TRUE(std::isnan(stats->maximum));
+        EXPECT_TRUE(std::isnan(stats->average));
+        EXPECT_TRUE(std::isnan(stats->p99));
+    }
+
+    // Test where all samples expire because no new samples were added
+    {
+        for (int i = 1; i <= 5; ++i)
+        {
+            time += seconds{1};
+            statistics.addSample(static_cast<double>(i), time);
+        }
+        auto stats = statistics.getStatistics(seconds{10}, time);
+        ASSERT_TRUE(stats.has_value());
+        EXPECT_EQ(stats->count, 5);
+
+        stats = statistics.getStatistics(seconds{10}, time + seconds{30});
+        ASSERT_TRUE(stats.has_value());
+        EXPECT_EQ(stats->count, 0);
+        EXPECT_TRUE(std::isnan(stats->average));
+    }
+}
+
+TEST(SensorStatisticsTests, GetWindows)
+{
+    SensorStatistics statistics{8, {seconds{5}, seconds{15}, seconds{30}}};
+    std::vector<seconds> expected{seconds{5}, seconds{15}, seconds{30}};
+    EXPECT_EQ(statistics.getWindows(), expected);
+}
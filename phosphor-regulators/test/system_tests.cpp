@@ -459,7 +459,7 @@ TEST(SystemTests, MonitorSensors)
                                    chassisInvPath + '2'))
         .Times(1);
     EXPECT_CALL(sensors, setValue).Times(0);
-    EXPECT_CALL(sensors, endRail(false)).Times(2);
+    EXPECT_CALL(sensors, endRail(false, false)).Times(2);
 
     std::vector<std::unique_ptr<Chassis>> chassisVec{};
 
@@ -19,6 +19,11 @@ constexpr auto MFR_POUT_MAX = "max_power_out";
 // The max_power_out value expected to be read for 1400W IBM CFFPS type.
 constexpr auto IBM_CFFPS_1400W = 30725;
 
+// The raw READ_EIN and READ_EOUT energy accumulator blocks, when the device
+// driver makes them available in the hwmon device debug directory.
+constexpr auto READ_EIN = "read_ein";
+constexpr auto READ_EOUT = "read_eout";
+
 namespace in_input
 {
 // VIN thresholds in Volts
@@ -181,6 +186,7 @@ class PMBusBase
     virtual const fs::path& path() const = 0;
     virtual std::string insertPageNum(const std::string& templateName,
                                       size_t page) = 0;
+    virtual fs::path getPath(Type type) = 0;
 };
 
 /**
@@ -380,7 +386,7 @@ class PMBus : public PMBusBase
      *
      * @return fs::path - the full path
      */
-    fs::path getPath(Type type);
+    fs::path getPath(Type type) override;
 
   private:
     /**
@@ -0,0 +1,28 @@
+#pragma once
+#include "record_manager.hpp"
+
+#include <org/open_power/Sensor/Aggregation/History/Appended/server.hpp>
+
+namespace phosphor
+{
+namespace power
+{
+namespace history
+{
+
+/**
+ * Implements org.open_power.Sensor.Aggregation.History.Appended on a
+ * history object.
+ *
+ * The RecordAppended signal carries just the timestamp/value tuple of a
+ * new record, so subscribers can follow the history without reading the
+ * whole array property every time it changes.  The interface is a local
+ * extension of the history interfaces, defined in
+ * org/open_power/Sensor/Aggregation/History/Appended.interface.yaml.
+ */
+using Appended =
+    sdbusplus::org::open_power::Sensor::Aggregation::History::server::Appended;
+
+} // namespace history
+} // namespace power
+} // namespace phosphor
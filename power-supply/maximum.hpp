@@ -1,7 +1,10 @@
 #pragma once
+#include "appended.hpp"
+
 #include <org/open_power/Sensor/Aggregation/History/Maximum/server.hpp>
 
 #include <functional>
+#include <memory>
 
 namespace phosphor
 {
@@ -39,15 +42,50 @@ class Maximum : public ServerObject<MaximumInterface>
     /**
      * @brief Constructor
      *
+     * The Appended interface is a local extension of the history
+     * interfaces in phosphor-dbus-interfaces, so it is only added when
+     * requested.  The legacy power supply monitor does not send it.
+     *
      * @param[in] bus - D-Bus object
      * @param[in] objectPath - the D-Bus object path
+     * @param[in] appendedSignal - if the object implements the
+     *                             RecordAppended signal
      */
-    Maximum(sdbusplus::bus::bus& bus, const std::string& objectPath) :
-        ServerObject<MaximumInterface>(bus, objectPath.c_str())
+    Maximum(sdbusplus::bus::bus& bus, const std::string& objectPath,
+            bool appendedSignal = false) :
+        ServerObject<MaximumInterface>(
+            bus, objectPath.c_str(),
+            ServerObject<MaximumInterface>::action::defer_emit)
     {
-        unit(Maximum::Unit::Watts);
-        scale(0);
+        if (appendedSignal)
+        {
+            appended = std::make_unique<Appended>(bus, objectPath.c_str());
+        }
+
+        unit(Maximum::Unit::Watts, true);
+        scale(0, true);
+
+        // Now the object has all of its interfaces
+        emit_object_added();
     }
+
+    /**
+     * @brief Sends the RecordAppended signal for a new record, if the
+     *        object implements it
+     *
+     * @param[in] record - the new record
+     */
+    void recordAppended(const DBusRecord& record)
+    {
+        if (appended)
+        {
+            appended->recordAppended(record);
+        }
+    }
+
+  private:
+    /** @brief The RecordAppended signal interface, if requested */
+    std::unique_ptr<Appended> appended;
 };
 
 } // namespace history
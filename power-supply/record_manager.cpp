@@ -15,11 +15,20 @@
  */
 #include "record_manager.hpp"
 
+#include <fcntl.h>
 #include <math.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <phosphor-logging/log.hpp>
 
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <new>
 
 namespace phosphor
 {
@@ -30,13 +39,288 @@ namespace history
 
 using namespace phosphor::logging;
 
+namespace
+{
+
+/**
+ * @brief Fills in a D-Bus record list from a circular buffer
+ *
+ * @param[in] times - the record timestamps
+ * @param[in] values - the record values
+ * @param[in] capacity - the size of the circular buffer
+ * @param[in] newest - the index of the newest record
+ * @param[in] numRecords - the number of records
+ * @param[out] list - the list to fill in, newest record first
+ */
+void fillRecords(const int64_t* times, const int64_t* values,
+                 size_t capacity, size_t newest, size_t numRecords,
+                 DBusRecordList& list)
+{
+    list.resize(numRecords);
+
+    // Walk backwards from the newest record, wrapping at the start
+    auto i = newest;
+    for (auto& record : list)
+    {
+        record = DBusRecord{times[i], values[i]};
+        i = (i == 0) ? (capacity - 1) : (i - 1);
+    }
+}
+
+/**
+ * @brief Returns the last sequence ID if it is valid
+ *
+ * Throws std::invalid_argument if it is too large.
+ *
+ * @param[in] lastSequenceID - the last sequence ID
+ *
+ * @return size_t - the last sequence ID
+ */
+size_t checkSequenceID(size_t lastSequenceID)
+{
+    if (lastSequenceID > RecordBuffer::MAX_ID)
+    {
+        throw std::invalid_argument{"Invalid history record limits"};
+    }
+    return lastSequenceID;
+}
+
+} // namespace
+
+RecordBuffer::RecordBuffer(size_t maxRec, const std::string& filePath) :
+    maxRecords(maxRec), slots(maxRec + 1)
+{
+    if (maxRec > MAX_CAPACITY)
+    {
+        throw std::invalid_argument{"Invalid history record limits"};
+    }
+
+    if (filePath.empty() || (maxRecords == 0) || !mapFile(filePath))
+    {
+        memory.resize((sizeof(Header) / sizeof(uint64_t)) + (3 * slots));
+        header = new (memory.data()) Header;
+        header->magic = FILE_MAGIC;
+        header->version = FILE_VERSION;
+        header->capacity = maxRecords;
+        header->state.store(0);
+    }
+
+    times = reinterpret_cast<int64_t*>(header + 1);
+    averages = times + slots;
+    maximums = averages + slots;
+}
+
+RecordBuffer::~RecordBuffer()
+{
+    if (mapped != nullptr)
+    {
+        munmap(mapped, mappedSize);
+    }
+}
+
+bool RecordBuffer::mapFile(const std::string& filePath)
+{
+    auto size = sizeof(Header) + (3 * slots * sizeof(int64_t));
+
+    try
+    {
+        std::filesystem::create_directories(
+            std::filesystem::path{filePath}.parent_path());
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>("Unable to create INPUT_HISTORY directory",
+                        entry("FILE=%s", filePath.c_str()),
+                        entry("ERROR=%s", e.what()));
+        return false;
+    }
+
+    int fd = open(filePath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        log<level::ERR>("Unable to open INPUT_HISTORY file",
+                        entry("FILE=%s", filePath.c_str()),
+                        entry("ERRNO=%d", errno));
+        return false;
+    }
+
+    // A file with a different size was created for a different number
+    // of records, so start over with an empty one.
+    struct stat st;
+    bool existing = (fstat(fd, &st) == 0) &&
+                    (static_cast<size_t>(st.st_size) == size);
+    if (!existing && ((ftruncate(fd, 0) != 0) || (ftruncate(fd, size) != 0)))
+    {
+        log<level::ERR>("Unable to size INPUT_HISTORY file",
+                        entry("FILE=%s", filePath.c_str()),
+                        entry("ERRNO=%d", errno));
+        close(fd);
+        return false;
+    }
+
+    void* addr =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+    {
+        log<level::ERR>("Unable to map INPUT_HISTORY file",
+                        entry("FILE=%s", filePath.c_str()),
+                        entry("ERRNO=%d", errno));
+        return false;
+    }
+
+    mapped = addr;
+    mappedSize = size;
+    header = std::launder(static_cast<Header*>(addr));
+
+    if (existing && (header->magic == FILE_MAGIC) &&
+        (header->version == FILE_VERSION) && (header->capacity == maxRecords))
+    {
+        auto state = header->state.load(std::memory_order_acquire);
+        newest = state & MAX_CAPACITY;
+        numRecords = (state >> 24) & MAX_CAPACITY;
+        lastID = (state >> 48) & MAX_ID;
+
+        if ((newest < slots) && (numRecords <= maxRecords))
+        {
+            loaded = numRecords != 0;
+            log<level::INFO>("Loaded INPUT_HISTORY records",
+                             entry("FILE=%s", filePath.c_str()),
+                             entry("RECORDS=%zu", numRecords));
+            return true;
+        }
+    }
+
+    // New or invalid file.  The records of a new file are already
+    // zero, and those of an invalid one are not visible, so only the
+    // header is written.
+    newest = 0;
+    numRecords = 0;
+    lastID = 0;
+    header->magic = FILE_MAGIC;
+    header->version = FILE_VERSION;
+    header->capacity = maxRecords;
+    commit();
+
+    return true;
+}
+
+void RecordBuffer::commit()
+{
+    uint64_t state = newest | (static_cast<uint64_t>(numRecords) << 24) |
+                     (static_cast<uint64_t>(lastID) << 48);
+    header->state.store(state, std::memory_order_release);
+
+    sync(header, sizeof(Header));
+}
+
+void RecordBuffer::sync(const void* addr, size_t size)
+{
+    if (mapped == nullptr)
+    {
+        return;
+    }
+
+    // msync() needs a page aligned address.  Pages that are not dirty
+    // are not written again, so syncing a page twice costs nothing.
+    static const auto pageSize =
+        static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    auto start = reinterpret_cast<uintptr_t>(addr) & ~(pageSize - 1);
+    auto end = reinterpret_cast<uintptr_t>(addr) + size;
+    if (msync(reinterpret_cast<void*>(start), end - start, MS_SYNC) != 0)
+    {
+        log<level::ERR>("Unable to write INPUT_HISTORY file",
+                        entry("ERRNO=%d", errno));
+    }
+}
+
+void RecordBuffer::push(int64_t time, int64_t average, int64_t maximum,
+                        size_t id)
+{
+    if (maxRecords == 0)
+    {
+        return;
+    }
+
+    // The slot after the newest record is never visible, even when the
+    // buffer is full, so it can be written before the header.
+    auto slot = (newest + 1) % slots;
+    times[slot] = time;
+    averages[slot] = average;
+    maximums[slot] = maximum;
+
+    // Write the record to the file before the header that makes it
+    // visible, so the file is also consistent after a power loss.
+    sync(&times[slot], sizeof(int64_t));
+    sync(&averages[slot], sizeof(int64_t));
+    sync(&maximums[slot], sizeof(int64_t));
+
+    newest = slot;
+    lastID = id & MAX_ID;
+    if (numRecords < maxRecords)
+    {
+        numRecords++;
+    }
+
+    // Make the new record visible
+    commit();
+}
+
+void RecordBuffer::clear()
+{
+    numRecords = 0;
+    commit();
+}
+
+void RecordBuffer::getNewest(DBusRecord& average, DBusRecord& maximum) const
+{
+    average = DBusRecord{times[newest], averages[newest]};
+    maximum = DBusRecord{times[newest], maximums[newest]};
+}
+
+void RecordBuffer::getAverageRecords(DBusRecordList& list) const
+{
+    fillRecords(times, averages, slots, newest, numRecords, list);
+}
+
+void RecordBuffer::getMaximumRecords(DBusRecordList& list) const
+{
+    fillRecords(times, maximums, slots, newest, numRecords, list);
+}
+
+RecordManager::RecordManager(size_t maxRec, size_t lastSequenceID,
+                             const std::string& filePath) :
+    lastSequenceID(checkSequenceID(lastSequenceID)),
+    filePath(filePath), records(maxRec, filePath)
+{
+    loaded = records.isLoaded();
+}
+
+void RecordManager::clear()
+{
+    records.clear();
+    loaded = false;
+
+    for (auto& tier : tiers)
+    {
+        tier.reset();
+    }
+}
+
 bool RecordManager::add(const std::vector<uint8_t>& rawRecord)
 {
     if (rawRecord.size() == 0)
     {
+        // The records loaded from the file are from before the SYNC
+        // at startup, so keep them.
+        if (loaded)
+        {
+            return false;
+        }
+
         // The PS has no data - either the power supply just started up,
         // or it just got a SYNC.  Clear the history.
-        records.clear();
+        clear();
         return true;
     }
 
@@ -45,9 +329,9 @@ bool RecordManager::add(const std::vector<uint8_t>& rawRecord)
         // Peek at the ID to see if more processing is needed.
         auto id = getRawRecordID(rawRecord);
 
-        if (!records.empty())
+        if (records.getNumRecords() != 0)
         {
-            auto previousID = std::get<recIDPos>(records.front());
+            auto previousID = records.getLastID();
 
             // Already have this record.  Done.
             if (previousID == id)
@@ -65,7 +349,9 @@ bool RecordManager::add(const std::vector<uint8_t>& rawRecord)
                 auto rolledOver =
                     (previousID == lastSequenceID) && (id == FIRST_SEQUENCE_ID);
 
-                if (!rolledOver)
+                // The PS starts over after the SYNC at startup, so the
+                // first record continues the records loaded from the file.
+                if (!rolledOver && !loaded)
                 {
                     if (id != FIRST_SEQUENCE_ID)
                     {
@@ -75,18 +361,13 @@ bool RecordManager::add(const std::vector<uint8_t>& rawRecord)
                             entry("OLD_ID=%ld", previousID),
                             entry("NEW_ID=%ld", id));
                     }
-                    records.clear();
+                    clear();
                 }
             }
         }
 
-        records.push_front(std::move(createRecord(rawRecord)));
-
-        // If no more should be stored, prune the oldest
-        if (records.size() > maxRecords)
-        {
-            records.pop_back();
-        }
+        loaded = false;
+        push(createRecord(rawRecord));
     }
     catch (const InvalidRecordException& e)
     {
@@ -96,28 +377,125 @@ bool RecordManager::add(const std::vector<uint8_t>& rawRecord)
     return true;
 }
 
-auto RecordManager::getAverageRecords() -> DBusRecordList
+RollupTier::RollupTier(const std::string& name, size_t ratio, size_t maxRec,
+                       const std::string& filePath) :
+    name(name),
+    ratio(ratio)
 {
-    DBusRecordList list;
+    if ((ratio == 0) || (maxRec == 0))
+    {
+        throw std::invalid_argument{"Invalid rollup tier " + name};
+    }
+    records = std::make_unique<RecordBuffer>(maxRec, filePath);
+}
 
-    for (const auto& r : records)
+bool RollupTier::add(int64_t time, int64_t average, int64_t maximum)
+{
+    averageSum += average;
+    this->maximum = (count == 0) ? maximum : std::max(this->maximum, maximum);
+    count++;
+
+    if (count < ratio)
     {
-        list.emplace_back(std::get<recTimePos>(r), std::get<recAvgPos>(r));
+        return false;
     }
 
+    records->push(time, averageSum / static_cast<int64_t>(count),
+                  this->maximum, 0);
+
+    reset();
+    return true;
+}
+
+void RollupTier::reset()
+{
+    count = 0;
+    averageSum = 0;
+    maximum = 0;
+}
+
+void RollupTier::getNewest(int64_t& average, int64_t& maximum) const
+{
+    DBusRecord newestAverage;
+    DBusRecord newestMaximum;
+    records->getNewest(newestAverage, newestMaximum);
+    average = std::get<1>(newestAverage);
+    maximum = std::get<1>(newestMaximum);
+}
+
+void RollupTier::getNewest(DBusRecord& average, DBusRecord& maximum) const
+{
+    records->getNewest(average, maximum);
+}
+
+void RollupTier::getAverageRecords(DBusRecordList& list) const
+{
+    records->getAverageRecords(list);
+}
+
+void RollupTier::getMaximumRecords(DBusRecordList& list) const
+{
+    records->getMaximumRecords(list);
+}
+
+void RecordManager::getNewest(DBusRecord& average, DBusRecord& maximum) const
+{
+    records.getNewest(average, maximum);
+}
+
+auto RecordManager::getAverageRecords() -> DBusRecordList
+{
+    DBusRecordList list;
+    records.getAverageRecords(list);
     return list;
 }
 
+void RecordManager::getAverageRecords(DBusRecordList& list) const
+{
+    records.getAverageRecords(list);
+}
+
 auto RecordManager::getMaximumRecords() -> DBusRecordList
 {
     DBusRecordList list;
+    records.getMaximumRecords(list);
+    return list;
+}
+
+void RecordManager::getMaximumRecords(DBusRecordList& list) const
+{
+    records.getMaximumRecords(list);
+}
 
-    for (const auto& r : records)
+void RecordManager::addTier(const std::string& name, size_t ratio,
+                            size_t maxRec)
+{
+    std::string tierFile;
+    if (records.isPersistent())
     {
-        list.emplace_back(std::get<recTimePos>(r), std::get<recMaxPos>(r));
+        tierFile = filePath + '_' + name;
     }
+    tiers.emplace_back(name, ratio, maxRec, tierFile);
+}
 
-    return list;
+void RecordManager::push(const Record& record)
+{
+    auto time = std::get<recTimePos>(record);
+    auto average = std::get<recAvgPos>(record);
+    auto maximum = std::get<recMaxPos>(record);
+
+    records.push(time, average, maximum, std::get<recIDPos>(record));
+
+    // Cascade the record into the rollup tiers until one of them
+    // is still in the middle of an interval.
+    for (auto& tier : tiers)
+    {
+        if (!tier.add(time, average, maximum))
+        {
+            break;
+        }
+        tier.getNewest(average, maximum);
+    }
 }
 
 size_t RecordManager::getRawRecordID(const std::vector<uint8_t>& data) const
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
-#include <deque>
+#include <memory>
 #include <stdexcept>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -18,6 +20,8 @@ static constexpr auto recTimePos = 1;
 static constexpr auto recAvgPos = 2;
 static constexpr auto recMaxPos = 3;
 using Record = std::tuple<size_t, int64_t, int64_t, int64_t>;
+using DBusRecord = std::tuple<uint64_t, int64_t>;
+using DBusRecordList = std::vector<DBusRecord>;
 
 /**
  * @class InvalidRecordException
@@ -32,6 +36,399 @@ class InvalidRecordException : public std::runtime_error
     {}
 };
 
+/**
+ * @class RecordBuffer
+ *
+ * The storage of input power history records: a circular buffer with
+ * one array per record field, newest record last.
+ *
+ * The records can optionally be kept in a memory-mapped file, so they
+ * survive restarts of the application.  The file starts with a header,
+ * followed by the arrays.  The arrays have one more slot than the
+ * maximum number of records, so the slot a new record is written to is
+ * never one of the records the header makes visible, even when the
+ * buffer is full.  The new record is synced to the file first, and then
+ * made visible by atomically updating the header state and syncing it,
+ * so the file is consistent even if the application stops or the BMC
+ * loses power at any point.
+ *
+ * Only the pages holding the new record and the header are synced.  A
+ * history of 120 records fits in one page, so a new record every 30s
+ * writes that page twice: about 5800 page writes a day, which the wear
+ * leveling of the BMC flash file system spreads across the device.
+ */
+class RecordBuffer
+{
+  public:
+    static constexpr uint32_t FILE_MAGIC = 0x50534948; // "PSIH"
+    static constexpr uint32_t FILE_VERSION = 2;
+    static constexpr size_t MAX_CAPACITY = (1 << 24) - 1;
+    static constexpr size_t MAX_ID = 0xFFFF;
+
+    RecordBuffer() = delete;
+    ~RecordBuffer();
+    RecordBuffer(const RecordBuffer&) = delete;
+    RecordBuffer& operator=(const RecordBuffer&) = delete;
+    RecordBuffer(RecordBuffer&&) = delete;
+    RecordBuffer& operator=(RecordBuffer&&) = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * If the file exists and was created with the same maxRec, its
+     * records are used without reading them.  Otherwise it is created
+     * with no records.  If the file cannot be used, an error is logged
+     * and the records are only kept in memory.
+     *
+     * Throws std::invalid_argument if maxRec is too large.
+     *
+     * @param[in] maxRec - the maximum number of records to keep
+     * @param[in] filePath - the file to keep the records in, or an
+     *                       empty string to only keep them in memory
+     */
+    RecordBuffer(size_t maxRec, const std::string& filePath);
+
+    /**
+     * @brief Adds a record as the newest entry, overwriting the
+     *        oldest entry if the buffer is full.
+     *
+     * @param[in] time - the timestamp of the record
+     * @param[in] average - the average power
+     * @param[in] maximum - the maximum power
+     * @param[in] id - the sequence ID of the record, at most MAX_ID
+     */
+    void push(int64_t time, int64_t average, int64_t maximum, size_t id);
+
+    /**
+     * @brief Deletes all records
+     */
+    void clear();
+
+    /**
+     * @brief Returns the newest average and maximum record
+     *
+     * Only valid if getNumRecords() is not 0.
+     *
+     * @param[out] average - the newest average with its timestamp
+     * @param[out] maximum - the newest maximum with its timestamp
+     */
+    void getNewest(DBusRecord& average, DBusRecord& maximum) const;
+
+    /**
+     * @brief Fills in the average records in a representation
+     *        used by D-Bus, newest first.
+     *
+     * @param[out] list - A list of averages with a timestamp
+     *                    for each entry.
+     */
+    void getAverageRecords(DBusRecordList& list) const;
+
+    /**
+     * @brief Fills in the maximum records in a representation
+     *        used by D-Bus, newest first.
+     *
+     * @param[out] list - A list of maximums with a timestamp
+     *                    for each entry.
+     */
+    void getMaximumRecords(DBusRecordList& list) const;
+
+    /**
+     * @brief Returns the number of records
+     */
+    inline size_t getNumRecords() const
+    {
+        return numRecords;
+    }
+
+    /**
+     * @brief Returns the maximum number of records
+     */
+    inline size_t getMaxRecords() const
+    {
+        return maxRecords;
+    }
+
+    /**
+     * @brief Returns the sequence ID of the newest record
+     */
+    inline size_t getLastID() const
+    {
+        return lastID;
+    }
+
+    /**
+     * @brief Returns whether the records are kept in a file
+     */
+    inline bool isPersistent() const
+    {
+        return mapped != nullptr;
+    }
+
+    /**
+     * @brief Returns whether records were loaded from the file
+     */
+    inline bool isLoaded() const
+    {
+        return loaded;
+    }
+
+  private:
+    /**
+     * @brief Maps the record file, creating it if necessary
+     *
+     * @param[in] filePath - the file to keep the records in
+     *
+     * @return bool - If the file could be used
+     */
+    bool mapFile(const std::string& filePath);
+
+    /**
+     * @brief Atomically stores newest, numRecords, and lastID in
+     *        the header, which makes a new record visible, and
+     *        writes the header to the file.
+     */
+    void commit();
+
+    /**
+     * @brief Writes the pages of the mapped file that hold the
+     *        specified bytes to the file and waits for it to complete,
+     *        if the records are kept in one.
+     *
+     * @param[in] addr - the first byte to write
+     * @param[in] size - the number of bytes to write
+     */
+    void sync(const void* addr, size_t size);
+
+    /**
+     * @brief The header at the start of the record storage
+     */
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;
+
+        /**
+         * The newest index (bits 0-23), the number of records
+         * (bits 24-47), and the ID of the newest record (bits 48-63).
+         */
+        std::atomic<uint64_t> state;
+    };
+
+    /**
+     * @brief The maximum number of records to keep
+     */
+    const size_t maxRecords;
+
+    /**
+     * @brief The number of slots in each array, one more than
+     *        maxRecords
+     */
+    const size_t slots;
+
+    /**
+     * @brief The record storage when the records are only kept
+     *        in memory
+     */
+    std::vector<uint64_t> memory;
+
+    /**
+     * @brief The mapped record file, if any, and its size
+     */
+    void* mapped = nullptr;
+    size_t mappedSize = 0;
+
+    /**
+     * @brief The header of the record storage
+     */
+    Header* header = nullptr;
+
+    /**
+     * @brief The records, one array of slots entries per record
+     *        field.  The newest record is at index newest, and older
+     *        ones precede it.
+     */
+    int64_t* times = nullptr;
+    int64_t* averages = nullptr;
+    int64_t* maximums = nullptr;
+
+    /**
+     * @brief The storage index of the newest record
+     */
+    size_t newest = 0;
+
+    /**
+     * @brief The number of records in the circular buffer
+     */
+    size_t numRecords = 0;
+
+    /**
+     * @brief The sequence ID of the newest record
+     */
+    size_t lastID = 0;
+
+    /**
+     * @brief If records were loaded from the file
+     */
+    bool loaded = false;
+};
+
+/**
+ * @class RollupTier
+ *
+ * A lower resolution input power history that is built from the
+ * records of a higher resolution history.
+ *
+ * After every 'ratio' source records, a new record is created with
+ * the average of their averages and the maximum of their maximums,
+ * and the timestamp of the last source record.  The sums are kept
+ * as the source records arrive, so no source records are stored.
+ *
+ * The records can be kept in a file like those of RecordManager.
+ * The sums of the current interval are not, so the first interval
+ * after a restart only covers the source records since then.
+ */
+class RollupTier
+{
+  public:
+    RollupTier() = delete;
+    ~RollupTier() = default;
+    RollupTier(const RollupTier&) = delete;
+    RollupTier& operator=(const RollupTier&) = delete;
+    RollupTier(RollupTier&&) = default;
+    RollupTier& operator=(RollupTier&&) = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] name - the tier name, used in the D-Bus object path
+     * @param[in] ratio - the number of source records per record
+     * @param[in] maxRec - the maximum number of records to keep
+     * @param[in] filePath - the file to keep the records in, or an
+     *                       empty string to only keep them in memory
+     *
+     * Throws std::invalid_argument if ratio or maxRec is 0, or
+     * maxRec is too large.
+     */
+    RollupTier(const std::string& name, size_t ratio, size_t maxRec,
+               const std::string& filePath = std::string{});
+
+    /**
+     * @brief Adds a source record to the current interval
+     *
+     * @param[in] time - the timestamp of the source record
+     * @param[in] average - the average power of the source record
+     * @param[in] maximum - the maximum power of the source record
+     *
+     * @return bool - If the interval completed and a new record
+     *                was created.
+     */
+    bool add(int64_t time, int64_t average, int64_t maximum);
+
+    /**
+     * @brief Discards the source records of the current interval
+     *
+     * The records already created are kept.
+     */
+    void reset();
+
+    /**
+     * @brief Returns the average and maximum of the newest record
+     *
+     * Only valid if getNumRecords() is not 0.
+     *
+     * @param[out] average - the average power
+     * @param[out] maximum - the maximum power
+     */
+    void getNewest(int64_t& average, int64_t& maximum) const;
+
+    /**
+     * @brief Returns the newest record in a representation used
+     *        by D-Bus.
+     *
+     * Only valid if getNumRecords() is not 0.
+     *
+     * @param[out] average - the newest average with its timestamp
+     * @param[out] maximum - the newest maximum with its timestamp
+     */
+    void getNewest(DBusRecord& average, DBusRecord& maximum) const;
+
+    /**
+     * @brief Fills in the history of average input power
+     *        in a representation used by D-Bus.
+     *
+     * @param[out] list - A list of averages with a timestamp
+     *                    for each entry, newest first.
+     */
+    void getAverageRecords(DBusRecordList& list) const;
+
+    /**
+     * @brief Fills in the history of maximum input power
+     *        in a representation used by D-Bus.
+     *
+     * @param[out] list - A list of maximums with a timestamp
+     *                    for each entry, newest first.
+     */
+    void getMaximumRecords(DBusRecordList& list) const;
+
+    /**
+     * @brief Returns the tier name
+     */
+    inline const std::string& getName() const
+    {
+        return name;
+    }
+
+    /**
+     * @brief Returns the number of records
+     */
+    inline size_t getNumRecords() const
+    {
+        return records->getNumRecords();
+    }
+
+    /**
+     * @brief Returns whether the records are kept in a file
+     */
+    inline bool isPersistent() const
+    {
+        return records->isPersistent();
+    }
+
+  private:
+    /**
+     * @brief The tier name
+     */
+    std::string name;
+
+    /**
+     * @brief The number of source records per record
+     */
+    size_t ratio;
+
+    /**
+     * @brief The records
+     */
+    std::unique_ptr<RecordBuffer> records;
+
+    /**
+     * @brief The number of source records in the current interval
+     */
+    size_t count = 0;
+
+    /**
+     * @brief The sum of the source record averages in the
+     *        current interval
+     */
+    int64_t averageSum = 0;
+
+    /**
+     * @brief The maximum of the source record maximums in the
+     *        current interval
+     */
+    int64_t maximum = 0;
+};
+
 /**
  * @class RecordManager
  *
@@ -45,6 +442,16 @@ class InvalidRecordException : public std::runtime_error
  * sorted newest to oldest, and prunes out the oldest entries when
  * necessary.  If there is a problem with the ordering IDs coming
  * from the PS, it will clear out the old records and start over.
+ *
+ * The records can optionally be kept in a memory-mapped file, so
+ * they survive restarts of the application; see RecordBuffer.  The
+ * records of each rollup tier are then kept in a file too, named
+ * after the file of this history and the tier name.
+ *
+ * The power supplies are synced when the application starts, which
+ * restarts their sequence IDs.  So the first record after loading the
+ * records from the file continues them, instead of clearing them
+ * because of an unexpected ID.
  */
 class RecordManager
 {
@@ -54,15 +461,15 @@ class RecordManager
     static constexpr auto FIRST_SEQUENCE_ID = 0;
     static constexpr auto LAST_SEQUENCE_ID = 0xFF;
 
-    using DBusRecord = std::tuple<uint64_t, int64_t>;
-    using DBusRecordList = std::vector<DBusRecord>;
+    using DBusRecord = history::DBusRecord;
+    using DBusRecordList = history::DBusRecordList;
 
     RecordManager() = delete;
     ~RecordManager() = default;
-    RecordManager(const RecordManager&) = default;
-    RecordManager& operator=(const RecordManager&) = default;
-    RecordManager(RecordManager&&) = default;
-    RecordManager& operator=(RecordManager&&) = default;
+    RecordManager(const RecordManager&) = delete;
+    RecordManager& operator=(const RecordManager&) = delete;
+    RecordManager(RecordManager&&) = delete;
+    RecordManager& operator=(RecordManager&&) = delete;
 
     /**
      * @brief Constructor
@@ -82,9 +489,30 @@ class RecordManager
      *                             will use before starting over
      */
     RecordManager(size_t maxRec, size_t lastSequenceID) :
-        maxRecords(maxRec), lastSequenceID(lastSequenceID)
+        RecordManager(maxRec, lastSequenceID, std::string{})
     {}
 
+    /**
+     * @brief Constructor
+     *
+     * If the file exists and was created with the same maxRec, its
+     * records are used without reading them.  Otherwise it is created
+     * with no records.  If the file cannot be used, an error is logged
+     * and the records are only kept in memory.
+     *
+     * Throws std::invalid_argument if maxRec or lastSequenceID
+     * is too large.
+     *
+     * @param[in] maxRec - the maximum number of history
+     *                     records to keep at a time
+     * @param[in] lastSequenceID - the last sequence ID the power supply
+     *                             will use before starting over
+     * @param[in] filePath - the file to keep the records in, or an
+     *                       empty string to only keep them in memory
+     */
+    RecordManager(size_t maxRec, size_t lastSequenceID,
+                  const std::string& filePath);
+
     /**
      * @brief Adds a new entry to the history
      *
@@ -101,6 +529,18 @@ class RecordManager
      */
     bool add(const std::vector<uint8_t>& rawRecord);
 
+    /**
+     * @brief Returns the newest record in a representation used
+     *        by D-Bus.
+     *
+     * Only valid if getNumRecords() is not 0.  Use this instead of
+     * filling in the full lists when only the new record is needed.
+     *
+     * @param[out] average - the newest average with its timestamp
+     * @param[out] maximum - the newest maximum with its timestamp
+     */
+    void getNewest(DBusRecord& average, DBusRecord& maximum) const;
+
     /**
      * @brief Returns the history of average input power
      *        in a representation used by D-Bus.
@@ -110,6 +550,18 @@ class RecordManager
      */
     DBusRecordList getAverageRecords();
 
+    /**
+     * @brief Fills in the history of average input power
+     *        in a representation used by D-Bus.
+     *
+     * The list is overwritten in place, so its storage is reused
+     * when it is filled in again after a new record is added.
+     *
+     * @param[out] list - A list of averages with a timestamp
+     *                    for each entry.
+     */
+    void getAverageRecords(DBusRecordList& list) const;
+
     /**
      * @brief Returns the history of maximum input power
      *        in a representation used by D-Bus.
@@ -119,6 +571,18 @@ class RecordManager
      */
     DBusRecordList getMaximumRecords();
 
+    /**
+     * @brief Fills in the history of maximum input power
+     *        in a representation used by D-Bus.
+     *
+     * The list is overwritten in place, so its storage is reused
+     * when it is filled in again after a new record is added.
+     *
+     * @param[out] list - A list of maximums with a timestamp
+     *                    for each entry.
+     */
+    void getMaximumRecords(DBusRecordList& list) const;
+
     /**
      * @brief Converts a Linear Format power number to an integer
      *
@@ -140,15 +604,58 @@ class RecordManager
      */
     inline size_t getNumRecords() const
     {
-        return records.size();
+        return records.getNumRecords();
+    }
+
+    /**
+     * @brief Returns the maximum number of records
+     *
+     * @return size_t - the maximum number of records
+     */
+    inline size_t getMaxRecords() const
+    {
+        return records.getMaxRecords();
     }
 
     /**
      * @brief Deletes all records
+     *
+     * The rollup tiers keep their records, but discard the
+     * source records of their current intervals.
+     */
+    void clear();
+
+    /**
+     * @brief Returns whether the records are kept in a file
      */
-    inline void clear()
+    inline bool isPersistent() const
     {
-        records.clear();
+        return records.isPersistent();
+    }
+
+    /**
+     * @brief Adds a lower resolution rollup tier
+     *
+     * The first tier is built from the records of this history,
+     * and each additional tier from the records of the tier
+     * before it.
+     *
+     * If the records of this history are kept in a file, those of
+     * the tier are kept in the same file name followed by '_' and
+     * the tier name.
+     *
+     * @param[in] name - the tier name, used in the D-Bus object path
+     * @param[in] ratio - the number of source records per record
+     * @param[in] maxRec - the maximum number of records to keep
+     */
+    void addTier(const std::string& name, size_t ratio, size_t maxRec);
+
+    /**
+     * @brief Returns the rollup tiers, highest resolution first
+     */
+    inline const std::vector<RollupTier>& getTiers() const
+    {
+        return tiers;
     }
 
   private:
@@ -173,11 +680,12 @@ class RecordManager
     Record createRecord(const std::vector<uint8_t>& data);
 
     /**
-     * @brief The maximum number of entries to keep in the history.
+     * @brief Adds a record as the newest entry, overwriting the
+     *        oldest entry if the history is full.
      *
-     * When a new record is added, the oldest one will be removed.
+     * @param[in] record - the record to add
      */
-    const size_t maxRecords;
+    void push(const Record& record);
 
     /**
      * @brief The last ID the power supply returns before rolling over
@@ -186,11 +694,25 @@ class RecordManager
     const size_t lastSequenceID;
 
     /**
-     * @brief The list of timestamp/average/maximum records.
-     *        Newer records are added to the front, and older ones
-     *        removed from the back.
+     * @brief The file the records are kept in, if any
+     */
+    const std::string filePath;
+
+    /**
+     * @brief The records
+     */
+    RecordBuffer records;
+
+    /**
+     * @brief If the records were loaded from the file, and no record
+     *        has been added since.
+     */
+    bool loaded = false;
+
+    /**
+     * @brief The lower resolution rollup tiers
      */
-    std::deque<Record> records;
+    std::vector<RollupTier> tiers;
 };
 
 } // namespace history
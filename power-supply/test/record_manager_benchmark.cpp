@@ -0,0 +1,157 @@
+/**
+ * Measures the cost of a history update, the same as the power supply
+ * monitor does on each poll: add one record from the power supply and get
+ * the newest record for the appended signals.  Every --refresh-interval
+ * records, the average and maximum record lists published on D-Bus are
+ * refreshed too.
+ *
+ * The history is filled to capacity first, so every update also drops the
+ * oldest record.
+ */
+#include "../record_manager.hpp"
+
+#include <fmt/format.h>
+#include <time.h>
+
+#include <CLI/CLI.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace phosphor::power::history;
+
+namespace
+{
+
+std::atomic<size_t> allocationCount{0};
+
+} // namespace
+
+void* operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+
+/**
+ * Returns the CPU time used by this thread.
+ */
+std::chrono::nanoseconds threadCPUTime()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds{ts.tv_sec} +
+           std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    CLI::App app{"Power supply history record benchmark"};
+
+    size_t numRecords = 120;
+    size_t iterations = 1000000;
+    size_t refreshInterval = 1;
+    std::string filePath;
+    app.add_option("--records", numRecords, "Number of records to keep")
+        ->check(CLI::Range(1, RecordManager::LAST_SEQUENCE_ID));
+    app.add_option("--iterations", iterations, "Number of updates to run")
+        ->check(CLI::PositiveNumber);
+    app.add_option("--refresh-interval", refreshInterval,
+                   "Number of records between refreshes of the lists")
+        ->check(CLI::PositiveNumber);
+    app.add_option("--file", filePath,
+                   "File to keep the records in, instead of only in memory");
+    CLI11_PARSE(app, argc, argv);
+
+    RecordManager manager{numRecords, RecordManager::LAST_SEQUENCE_ID,
+                          filePath};
+
+    // Average 0x0050 and maximum 0x0054 in linear format
+    std::vector<uint8_t> rawRecord{0x00, 0x50, 0xf3, 0x54, 0xf3};
+    uint8_t sequenceID = 0;
+    auto nextRecord = [&]() -> const std::vector<uint8_t>& {
+        rawRecord[0] = sequenceID;
+        sequenceID = (sequenceID == RecordManager::LAST_SEQUENCE_ID)
+                         ? 0
+                         : sequenceID + 1;
+        return rawRecord;
+    };
+
+    RecordManager::DBusRecordList averages;
+    RecordManager::DBusRecordList maximums;
+    for (size_t i = 0; i < numRecords; i++)
+    {
+        manager.add(nextRecord());
+    }
+    manager.getAverageRecords(averages);
+    manager.getMaximumRecords(maximums);
+
+    RecordManager::DBusRecord newestAverage;
+    RecordManager::DBusRecord newestMaximum;
+    size_t changes = 0;
+    auto allocations = allocationCount.load();
+    auto wallStart = std::chrono::steady_clock::now();
+    auto cpuStart = threadCPUTime();
+
+    for (size_t i = 0; i < iterations; i++)
+    {
+        if (manager.add(nextRecord()))
+        {
+            manager.getNewest(newestAverage, newestMaximum);
+            if (++changes % refreshInterval == 0)
+            {
+                manager.getAverageRecords(averages);
+                manager.getMaximumRecords(maximums);
+            }
+        }
+    }
+
+    auto cpu = threadCPUTime() - cpuStart;
+    auto wall = std::chrono::steady_clock::now() - wallStart;
+    allocations = allocationCount.load() - allocations;
+
+    using ns = std::chrono::duration<double, std::nano>;
+    fmt::print("{} records kept {}, {} updates, {} changed the history, "
+               "lists refreshed every {}\n",
+               numRecords, filePath.empty() ? "in memory" : "in a file",
+               iterations, changes, refreshInterval);
+    fmt::print("Wall per update:        {:.1f} ns\n",
+               ns{wall}.count() / iterations);
+    fmt::print("CPU per update:         {:.1f} ns\n",
+               ns{cpu}.count() / iterations);
+    fmt::print("Allocations per update: {:.2f}\n",
+               static_cast<double>(allocations) / iterations);
+
+    if ((averages.size() != numRecords) || (maximums.size() != numRecords))
+    {
+        fmt::print(stderr, "Expected {} records, got {} and {}\n", numRecords,
+                   averages.size(), maximums.size());
+        return 1;
+    }
+
+    return 0;
+}
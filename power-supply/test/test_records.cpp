@@ -16,6 +16,10 @@
 #include "../record_manager.hpp"
 #include "names_values.hpp"
 
+#include <stdlib.h>
+
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 
 #include <gtest/gtest.h>
@@ -178,3 +182,309 @@ TEST(ManagerTest, TestRecordAdds)
     mgr.add(std::vector<uint8_t>{});
     EXPECT_EQ(0, mgr.getNumRecords());
 }
+
+/**
+ * Test that the records are returned newest first after the
+ * circular buffer wraps around, and that the D-Bus record lists
+ * are filled in place.
+ */
+TEST(ManagerTest, TestRecordWrap)
+{
+    // Hold 3 max records.  IDs roll over at 0xFF.
+    RecordManager mgr{3};
+
+    RecordManager::DBusRecordList avgRecords;
+    RecordManager::DBusRecordList maxRecords;
+
+    for (uint8_t id = 0; id < 7; id++)
+    {
+        EXPECT_TRUE(mgr.add(makeRawRecord(id, id, id + 10)));
+    }
+    EXPECT_EQ(3, mgr.getNumRecords());
+
+    mgr.getAverageRecords(avgRecords);
+    mgr.getMaximumRecords(maxRecords);
+    ASSERT_EQ(3, avgRecords.size());
+    ASSERT_EQ(3, maxRecords.size());
+    for (size_t i = 0; i < avgRecords.size(); i++)
+    {
+        EXPECT_EQ(6 - i, std::get<1>(avgRecords[i]));
+        EXPECT_EQ(16 - i, std::get<1>(maxRecords[i]));
+        EXPECT_EQ(std::get<0>(avgRecords[i]), std::get<0>(maxRecords[i]));
+    }
+    EXPECT_EQ(avgRecords, mgr.getAverageRecords());
+    EXPECT_EQ(maxRecords, mgr.getMaximumRecords());
+
+    // The newest record, without filling in the lists
+    RecordManager::DBusRecord newestAverage;
+    RecordManager::DBusRecord newestMaximum;
+    mgr.getNewest(newestAverage, newestMaximum);
+    EXPECT_EQ(avgRecords.front(), newestAverage);
+    EXPECT_EQ(maxRecords.front(), newestMaximum);
+
+    // Same ID again.  No change.
+    EXPECT_FALSE(mgr.add(makeRawRecord(6, 0, 0)));
+    EXPECT_EQ(3, mgr.getNumRecords());
+
+    // Sync.  Only the new record is left.
+    EXPECT_TRUE(mgr.add(makeRawRecord(0, 20, 30)));
+    EXPECT_EQ(1, mgr.getNumRecords());
+
+    mgr.getAverageRecords(avgRecords);
+    mgr.getMaximumRecords(maxRecords);
+    ASSERT_EQ(1, avgRecords.size());
+    EXPECT_EQ(20, std::get<1>(avgRecords[0]));
+    ASSERT_EQ(1, maxRecords.size());
+    EXPECT_EQ(30, std::get<1>(maxRecords[0]));
+
+    // No records to keep
+    RecordManager empty{0};
+    EXPECT_TRUE(empty.add(makeRawRecord(0, 1, 1)));
+    EXPECT_EQ(0, empty.getNumRecords());
+    EXPECT_TRUE(empty.getAverageRecords().empty());
+}
+
+/**
+ * Test the lower resolution rollup tiers
+ */
+TEST(ManagerTest, TestRollupTiers)
+{
+    RecordManager mgr{4, 0xFF};
+
+    // 3 records per tier 0 record, 2 tier 0 records per tier 1 record
+    mgr.addTier("tier0", 3, 2);
+    mgr.addTier("tier1", 2, 5);
+    ASSERT_EQ(2, mgr.getTiers().size());
+    EXPECT_EQ("tier0", mgr.getTiers()[0].getName());
+    EXPECT_EQ("tier1", mgr.getTiers()[1].getName());
+
+    EXPECT_THROW(mgr.addTier("bad", 0, 1), std::invalid_argument);
+    EXPECT_THROW(mgr.addTier("bad", 1, 0), std::invalid_argument);
+    EXPECT_EQ(2, mgr.getTiers().size());
+
+    RecordManager::DBusRecordList avgRecords;
+    RecordManager::DBusRecordList maxRecords;
+
+    // Averages 0, 1, 2 and maximums 10, 12, 11
+    mgr.add(makeRawRecord(0, 0, 10));
+    mgr.add(makeRawRecord(1, 1, 12));
+    EXPECT_EQ(0, mgr.getTiers()[0].getNumRecords());
+    mgr.add(makeRawRecord(2, 2, 11));
+    EXPECT_EQ(1, mgr.getTiers()[0].getNumRecords());
+    EXPECT_EQ(0, mgr.getTiers()[1].getNumRecords());
+
+    mgr.getTiers()[0].getAverageRecords(avgRecords);
+    mgr.getTiers()[0].getMaximumRecords(maxRecords);
+    ASSERT_EQ(1, avgRecords.size());
+    EXPECT_EQ(1, std::get<1>(avgRecords[0]));
+    ASSERT_EQ(1, maxRecords.size());
+    EXPECT_EQ(12, std::get<1>(maxRecords[0]));
+
+    // Averages 6, 6, 6 and maximums 20, 20, 20
+    mgr.add(makeRawRecord(3, 6, 20));
+    mgr.add(makeRawRecord(4, 6, 20));
+    mgr.add(makeRawRecord(5, 6, 20));
+    EXPECT_EQ(2, mgr.getTiers()[0].getNumRecords());
+    EXPECT_EQ(1, mgr.getTiers()[1].getNumRecords());
+
+    mgr.getTiers()[0].getAverageRecords(avgRecords);
+    ASSERT_EQ(2, avgRecords.size());
+    EXPECT_EQ(6, std::get<1>(avgRecords[0]));
+    EXPECT_EQ(1, std::get<1>(avgRecords[1]));
+
+    mgr.getTiers()[1].getAverageRecords(avgRecords);
+    mgr.getTiers()[1].getMaximumRecords(maxRecords);
+    ASSERT_EQ(1, avgRecords.size());
+    EXPECT_EQ(3, std::get<1>(avgRecords[0]));
+    ASSERT_EQ(1, maxRecords.size());
+    EXPECT_EQ(20, std::get<1>(maxRecords[0]));
+
+    // A sync discards the current interval but keeps the tier records
+    mgr.add(makeRawRecord(6, 100, 100));
+    mgr.add(std::vector<uint8_t>{});
+    EXPECT_EQ(0, mgr.getNumRecords());
+    EXPECT_EQ(2, mgr.getTiers()[0].getNumRecords());
+
+    mgr.add(makeRawRecord(0, 3, 3));
+    mgr.add(makeRawRecord(1, 3, 3));
+    mgr.add(makeRawRecord(2, 3, 3));
+    EXPECT_EQ(2, mgr.getTiers()[0].getNumRecords());
+
+    mgr.getTiers()[0].getAverageRecords(avgRecords);
+    ASSERT_EQ(2, avgRecords.size());
+    EXPECT_EQ(3, std::get<1>(avgRecords[0]));
+    EXPECT_EQ(6, std::get<1>(avgRecords[1]));
+}
+
+/**
+ * Test keeping the records in a file
+ */
+TEST(ManagerTest, TestRecordFile)
+{
+    char dir[] = "/tmp/test_records_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(dir));
+    std::filesystem::path path{std::string{dir} + "/history/ps0"};
+
+    RecordManager::DBusRecordList avgRecords;
+    RecordManager::DBusRecordList maxRecords;
+
+    {
+        RecordManager mgr{3, 0xFF, path};
+        EXPECT_TRUE(mgr.isPersistent());
+        EXPECT_EQ(0, mgr.getNumRecords());
+
+        for (uint8_t id = 10; id < 15; id++)
+        {
+            mgr.add(makeRawRecord(id, id, id + 10));
+        }
+        EXPECT_EQ(3, mgr.getNumRecords());
+        mgr.getAverageRecords(avgRecords);
+        mgr.getMaximumRecords(maxRecords);
+    }
+
+    {
+        // Same size.  The records are loaded.
+        RecordManager mgr{3, 0xFF, path};
+        EXPECT_TRUE(mgr.isPersistent());
+        EXPECT_EQ(3, mgr.getNumRecords());
+        EXPECT_EQ(avgRecords, mgr.getAverageRecords());
+        EXPECT_EQ(maxRecords, mgr.getMaximumRecords());
+
+        // Already have this record
+        EXPECT_FALSE(mgr.add(makeRawRecord(14, 0, 0)));
+
+        // The sequence continues
+        EXPECT_TRUE(mgr.add(makeRawRecord(15, 15, 25)));
+        EXPECT_EQ(3, mgr.getNumRecords());
+        EXPECT_EQ(15, std::get<1>(mgr.getAverageRecords()[0]));
+        EXPECT_EQ(13, std::get<1>(mgr.getAverageRecords()[2]));
+    }
+
+    {
+        // The SYNC at startup restarts the sequence IDs.  The loaded
+        // records are kept.
+        RecordManager mgr{3, 0xFF, path};
+        EXPECT_EQ(3, mgr.getNumRecords());
+        EXPECT_FALSE(mgr.add(std::vector<uint8_t>{}));
+        EXPECT_EQ(3, mgr.getNumRecords());
+
+        EXPECT_TRUE(mgr.add(makeRawRecord(0, 16, 26)));
+        EXPECT_EQ(3, mgr.getNumRecords());
+        EXPECT_EQ(16, std::get<1>(mgr.getAverageRecords()[0]));
+        EXPECT_EQ(14, std::get<1>(mgr.getAverageRecords()[2]));
+
+        // After that, a SYNC clears them as usual
+        EXPECT_TRUE(mgr.add(std::vector<uint8_t>{}));
+        EXPECT_EQ(0, mgr.getNumRecords());
+    }
+
+    {
+        RecordManager mgr{3, 0xFF, path};
+        mgr.add(makeRawRecord(1, 1, 1));
+        mgr.add(makeRawRecord(2, 2, 2));
+    }
+
+    {
+        // A noncontiguous ID right after loading also continues them
+        RecordManager mgr{3, 0xFF, path};
+        EXPECT_TRUE(mgr.add(makeRawRecord(40, 40, 40)));
+        EXPECT_EQ(3, mgr.getNumRecords());
+
+        // After that, it clears them as usual
+        EXPECT_TRUE(mgr.add(makeRawRecord(50, 50, 50)));
+        EXPECT_EQ(1, mgr.getNumRecords());
+    }
+
+    {
+        // Different size.  The file starts over.
+        RecordManager mgr{5, 0xFF, path};
+        EXPECT_TRUE(mgr.isPersistent());
+        EXPECT_EQ(0, mgr.getNumRecords());
+        mgr.add(makeRawRecord(1, 1, 1));
+    }
+
+    {
+        // A corrupted header starts over
+        RecordManager mgr{5, 0xFF, path};
+        EXPECT_EQ(1, mgr.getNumRecords());
+    }
+    {
+        std::fstream file{path, std::ios::in | std::ios::out |
+                                    std::ios::binary};
+        file.seekp(0);
+        file.put(0);
+    }
+    {
+        RecordManager mgr{5, 0xFF, path};
+        EXPECT_TRUE(mgr.isPersistent());
+        EXPECT_EQ(0, mgr.getNumRecords());
+    }
+
+    // The file cannot be created.  Only memory is used.
+    {
+        RecordManager mgr{5, 0xFF, path / "ps1"};
+        EXPECT_FALSE(mgr.isPersistent());
+        mgr.add(makeRawRecord(1, 1, 1));
+        EXPECT_EQ(1, mgr.getNumRecords());
+    }
+
+    EXPECT_THROW((RecordManager{5, 0x10000, ""}), std::invalid_argument);
+
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * Test keeping the rollup tier records in files
+ */
+TEST(ManagerTest, TestRollupTierFiles)
+{
+    char dir[] = "/tmp/test_records_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(dir));
+    std::filesystem::path path{std::string{dir} + "/ps0"};
+
+    RecordManager::DBusRecordList avgRecords;
+
+    {
+        RecordManager mgr{2, 0xFF, path};
+        mgr.addTier("tier0", 2, 3);
+        EXPECT_TRUE(mgr.getTiers()[0].isPersistent());
+        EXPECT_TRUE(std::filesystem::exists(path.string() + "_tier0"));
+
+        // Wrap the tier around, then start a new interval
+        for (uint8_t id = 0; id < 9; id++)
+        {
+            mgr.add(makeRawRecord(id, id * 2, id * 2));
+        }
+        EXPECT_EQ(3, mgr.getTiers()[0].getNumRecords());
+        mgr.getTiers()[0].getAverageRecords(avgRecords);
+    }
+
+    {
+        // The tier records are loaded, but not the current interval
+        RecordManager mgr{2, 0xFF, path};
+        mgr.addTier("tier0", 2, 3);
+        RecordManager::DBusRecordList loaded;
+        mgr.getTiers()[0].getAverageRecords(loaded);
+        EXPECT_EQ(avgRecords, loaded);
+        ASSERT_EQ(3, loaded.size());
+        EXPECT_EQ(13, std::get<1>(loaded[0]));
+        EXPECT_EQ(5, std::get<1>(loaded[2]));
+
+        mgr.add(makeRawRecord(0, 20, 20));
+        EXPECT_EQ(3, mgr.getTiers()[0].getNumRecords());
+        mgr.add(makeRawRecord(1, 30, 30));
+        mgr.getTiers()[0].getAverageRecords(loaded);
+        ASSERT_EQ(3, loaded.size());
+        EXPECT_EQ(25, std::get<1>(loaded[0]));
+        EXPECT_EQ(13, std::get<1>(loaded[1]));
+    }
+
+    {
+        // The tiers of a history kept in memory are kept in memory too
+        RecordManager mgr{2};
+        mgr.addTier("tier0", 2, 3);
+        EXPECT_FALSE(mgr.getTiers()[0].isPersistent());
+    }
+
+    std::filesystem::remove_all(dir);
+}
@@ -1,5 +1,7 @@
 #include "i2c.hpp"
 
+#include "i2c_trace.hpp"
+
 #include <fcntl.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
@@ -371,6 +373,14 @@ std::unique_ptr<I2CInterface> create(uint8_t busId, uint8_t devAddr,
                                      I2CInterface::InitialState initialState,
                                      int maxRetries)
 {
+    // Record or replay I2C operations if a trace has been started
+    auto traceInterface =
+        createTraceInterface(busId, devAddr, initialState, maxRetries);
+    if (traceInterface)
+    {
+        return traceInterface;
+    }
+
     return I2CDevice::create(busId, devAddr, initialState, maxRetries);
 }
 
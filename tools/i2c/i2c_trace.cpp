@@ -0,0 +1,442 @@
+#include "i2c_trace.hpp"
+
+#include "i2c.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <thread>
+
+namespace i2c
+{
+
+namespace
+{
+
+/** @brief Identifies the file as an I2C trace */
+constexpr std::array<char, 4> traceMagic{'I', '2', 'C', 'T'};
+
+/** @brief Version of the trace file format */
+constexpr uint8_t traceVersion = 1;
+
+/** @brief Trace being recorded, if any */
+std::shared_ptr<TraceWriter> activeWriter;
+
+/** @brief Trace being replayed, if any */
+std::shared_ptr<TraceReplayer> activeReplayer;
+
+/** @brief Write an integer to a stream in little-endian byte order */
+template <typename T>
+void writeInt(std::ostream& stream, T value)
+{
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        stream.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+/** @brief Read an integer from a stream in little-endian byte order */
+template <typename T>
+T readInt(std::istream& stream)
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    Unsigned value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        int byte = stream.get();
+        if (byte == std::char_traits<char>::eof())
+        {
+            throw std::runtime_error("Truncated I2C trace record");
+        }
+        value |= static_cast<Unsigned>(static_cast<uint8_t>(byte)) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+/** @brief Get the error description from an I2CException
+ *
+ * The description is the text between the "I2CException: " prefix and the
+ * bus information.
+ */
+std::string getErrorInfo(const I2CException& e)
+{
+    const std::string prefix = "I2CException: ";
+    std::string info = e.errStr;
+    if (info.compare(0, prefix.size(), prefix) == 0)
+    {
+        info.erase(0, prefix.size());
+    }
+    auto pos = info.rfind(": bus ");
+    if (pos != std::string::npos)
+    {
+        info.erase(pos);
+    }
+    return info;
+}
+
+} // namespace
+
+TraceWriter::TraceWriter(const std::string& path) :
+    file(path, std::ios::binary | std::ios::trunc)
+{
+    if (!file)
+    {
+        throw std::runtime_error("Unable to create I2C trace file " + path);
+    }
+    file.write(traceMagic.data(), traceMagic.size());
+    writeInt<uint8_t>(file, traceVersion);
+    flush();
+}
+
+void TraceWriter::write(const TraceRecord& record)
+{
+    // Record size and error info length are limited to one byte
+    uint8_t size = std::min<size_t>(record.data.size(), UINT8_MAX);
+    uint8_t infoLength = std::min<size_t>(record.errorInfo.size(), UINT8_MAX);
+
+    writeInt<uint8_t>(file, static_cast<uint8_t>(record.operation));
+    writeInt<uint8_t>(file, record.busId);
+    writeInt<uint8_t>(file, record.devAddr);
+    writeInt<uint8_t>(file, record.addr);
+    writeInt<uint8_t>(file, static_cast<uint8_t>(record.mode));
+    writeInt<uint8_t>(file, record.failed ? 1 : 0);
+    writeInt<uint32_t>(file, static_cast<uint32_t>(record.latency.count()));
+    writeInt<uint8_t>(file, size);
+    file.write(reinterpret_cast<const char*>(record.data.data()), size);
+    if (record.failed)
+    {
+        writeInt<int32_t>(file, record.errorCode);
+        writeInt<uint8_t>(file, infoLength);
+        file.write(record.errorInfo.data(), infoLength);
+    }
+
+    if (std::chrono::steady_clock::now() - lastFlush >= flushInterval)
+    {
+        flush();
+    }
+}
+
+void TraceWriter::flush()
+{
+    file.flush();
+    lastFlush = std::chrono::steady_clock::now();
+}
+
+std::vector<TraceRecord> readTrace(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Unable to open I2C trace file " + path);
+    }
+
+    std::array<char, traceMagic.size()> magic{};
+    file.read(magic.data(), magic.size());
+    if (!file || (magic != traceMagic) || (readInt<uint8_t>(file) != traceVersion))
+    {
+        throw std::runtime_error("Invalid I2C trace file " + path);
+    }
+
+    std::vector<TraceRecord> records;
+    while (file.peek() != std::char_traits<char>::eof())
+    {
+        TraceRecord record;
+        record.operation = static_cast<TraceOperation>(readInt<uint8_t>(file));
+        record.busId = readInt<uint8_t>(file);
+        record.devAddr = readInt<uint8_t>(file);
+        record.addr = readInt<uint8_t>(file);
+        record.mode = static_cast<I2CInterface::Mode>(readInt<uint8_t>(file));
+        record.failed = (readInt<uint8_t>(file) != 0);
+        record.latency = std::chrono::microseconds(readInt<uint32_t>(file));
+        record.data.resize(readInt<uint8_t>(file));
+        file.read(reinterpret_cast<char*>(record.data.data()),
+                  record.data.size());
+        if (record.failed)
+        {
+            record.errorCode = readInt<int32_t>(file);
+            record.errorInfo.resize(readInt<uint8_t>(file));
+            file.read(record.errorInfo.data(), record.errorInfo.size());
+        }
+        if (!file)
+        {
+            throw std::runtime_error("Truncated I2C trace record");
+        }
+        records.emplace_back(std::move(record));
+    }
+    return records;
+}
+
+template <typename Operation>
+void RecordingI2CInterface::perform(TraceRecord& record, Operation&& operation)
+{
+    record.busId = busId;
+    record.devAddr = devAddr;
+
+    auto start = std::chrono::steady_clock::now();
+    try
+    {
+        operation();
+    }
+    catch (const I2CException& e)
+    {
+        record.latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        record.failed = true;
+        record.errorCode = e.errorCode;
+        record.errorInfo = getErrorInfo(e);
+        record.data.clear();
+        writer->write(record);
+        throw;
+    }
+    record.latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    writer->write(record);
+}
+
+void RecordingI2CInterface::open()
+{
+    TraceRecord record{.operation = TraceOperation::open};
+    perform(record, [this]() { device->open(); });
+}
+
+void RecordingI2CInterface::close()
+{
+    TraceRecord record{.operation = TraceOperation::close};
+    perform(record, [this]() { device->close(); });
+}
+
+void RecordingI2CInterface::read(uint8_t& data)
+{
+    TraceRecord record{.operation = TraceOperation::readByte};
+    perform(record, [&]() {
+        device->read(data);
+        record.data = {data};
+    });
+}
+
+void RecordingI2CInterface::read(uint8_t addr, uint8_t& data)
+{
+    TraceRecord record{.operation = TraceOperation::readByteData,
+                       .addr = addr};
+    perform(record, [&]() {
+        device->read(addr, data);
+        record.data = {data};
+    });
+}
+
+void RecordingI2CInterface::read(uint8_t addr, uint16_t& data)
+{
+    TraceRecord record{.operation = TraceOperation::readWordData,
+                       .addr = addr};
+    perform(record, [&]() {
+        device->read(addr, data);
+        record.data = {static_cast<uint8_t>(data & 0xFF),
+                       static_cast<uint8_t>(data >> 8)};
+    });
+}
+
+void RecordingI2CInterface::read(uint8_t addr, uint8_t& size, uint8_t* data,
+                                 Mode mode)
+{
+    TraceRecord record{.operation = TraceOperation::readBlockData,
+                       .addr = addr,
+                       .mode = mode};
+    perform(record, [&]() {
+        device->read(addr, size, data, mode);
+        record.data.assign(data, data + size);
+    });
+}
+
+void RecordingI2CInterface::write(uint8_t data)
+{
+    TraceRecord record{.operation = TraceOperation::writeByte, .data = {data}};
+    perform(record, [&]() { device->write(data); });
+}
+
+void RecordingI2CInterface::write(uint8_t addr, uint8_t data)
+{
+    TraceRecord record{.operation = TraceOperation::writeByteData,
+                       .addr = addr,
+                       .data = {data}};
+    perform(record, [&]() { device->write(addr, data); });
+}
+
+void RecordingI2CInterface::write(uint8_t addr, uint16_t data)
+{
+    TraceRecord record{.operation = TraceOperation::writeWordData,
+                       .addr = addr,
+                       .data = {static_cast<uint8_t>(data & 0xFF),
+                                static_cast<uint8_t>(data >> 8)}};
+    perform(record, [&]() { device->write(addr, data); });
+}
+
+void RecordingI2CInterface::write(uint8_t addr, uint8_t size,
+                                  const uint8_t* data, Mode mode)
+{
+    TraceRecord record{.operation = TraceOperation::writeBlockData,
+                       .addr = addr,
+                       .mode = mode,
+                       .data = std::vector<uint8_t>(data, data + size)};
+    perform(record, [&]() { device->write(addr, size, data, mode); });
+}
+
+TraceReplayer::TraceReplayer(std::vector<TraceRecord> records,
+                             bool simulateLatency) :
+    simulateLatency(simulateLatency)
+{
+    for (auto& record : records)
+    {
+        queues[{record.busId, record.devAddr}].emplace_back(std::move(record));
+    }
+}
+
+bool TraceReplayer::next(uint8_t busId, uint8_t devAddr, TraceRecord& record)
+{
+    auto it = queues.find({busId, devAddr});
+    if ((it == queues.end()) || it->second.empty())
+    {
+        return false;
+    }
+    record = std::move(it->second.front());
+    it->second.pop_front();
+    return true;
+}
+
+std::vector<uint8_t> ReplayI2CInterface::replay(
+    TraceOperation operation, uint8_t addr, Mode mode,
+    const std::vector<uint8_t>& writeData, uint8_t readSize)
+{
+    TraceRecord record;
+    if (!replayer->next(busId, devAddr, record))
+    {
+        throw I2CException("End of I2C trace", busStr, devAddr);
+    }
+
+    // Verify operation matches the recorded operation
+    bool isMatch = (record.operation == operation) && (record.addr == addr) &&
+                   (record.mode == mode);
+    if (isMatch && !record.failed)
+    {
+        if (!writeData.empty())
+        {
+            isMatch = (record.data == writeData);
+        }
+        else if ((operation == TraceOperation::readBlockData) &&
+                 (mode == Mode::I2C))
+        {
+            isMatch = (record.data.size() == readSize);
+        }
+    }
+    if (!isMatch)
+    {
+        throw I2CException("I2C trace mismatch", busStr, devAddr);
+    }
+
+    if (replayer->isLatencySimulated())
+    {
+        std::this_thread::sleep_for(record.latency);
+    }
+
+    if (record.failed)
+    {
+        throw I2CException(record.errorInfo, busStr, devAddr,
+                           record.errorCode);
+    }
+    return record.data;
+}
+
+void ReplayI2CInterface::open()
+{
+    replay(TraceOperation::open, 0, Mode::SMBUS);
+    opened = true;
+}
+
+void ReplayI2CInterface::close()
+{
+    replay(TraceOperation::close, 0, Mode::SMBUS);
+    opened = false;
+}
+
+void ReplayI2CInterface::read(uint8_t& data)
+{
+    data = replay(TraceOperation::readByte, 0, Mode::SMBUS).at(0);
+}
+
+void ReplayI2CInterface::read(uint8_t addr, uint8_t& data)
+{
+    data = replay(TraceOperation::readByteData, addr, Mode::SMBUS).at(0);
+}
+
+void ReplayI2CInterface::read(uint8_t addr, uint16_t& data)
+{
+    auto values = replay(TraceOperation::readWordData, addr, Mode::SMBUS);
+    data = static_cast<uint16_t>(values.at(0) | (values.at(1) << 8));
+}
+
+void ReplayI2CInterface::read(uint8_t addr, uint8_t& size, uint8_t* data,
+                              Mode mode)
+{
+    auto values =
+        replay(TraceOperation::readBlockData, addr, mode, {}, size);
+    std::copy(values.begin(), values.end(), data);
+    size = static_cast<uint8_t>(values.size());
+}
+
+void ReplayI2CInterface::write(uint8_t data)
+{
+    replay(TraceOperation::writeByte, 0, Mode::SMBUS, {data});
+}
+
+void ReplayI2CInterface::write(uint8_t addr, uint8_t data)
+{
+    replay(TraceOperation::writeByteData, addr, Mode::SMBUS, {data});
+}
+
+void ReplayI2CInterface::write(uint8_t addr, uint16_t data)
+{
+    replay(TraceOperation::writeWordData, addr, Mode::SMBUS,
+           {static_cast<uint8_t>(data & 0xFF), static_cast<uint8_t>(data >> 8)});
+}
+
+void ReplayI2CInterface::write(uint8_t addr, uint8_t size, const uint8_t* data,
+                               Mode mode)
+{
+    replay(TraceOperation::writeBlockData, addr, mode,
+           std::vector<uint8_t>(data, data + size));
+}
+
+void startTraceRecording(const std::string& path)
+{
+    activeReplayer.reset();
+    activeWriter = std::make_shared<TraceWriter>(path);
+}
+
+void startTraceReplay(const std::string& path, bool simulateLatency)
+{
+    activeWriter.reset();
+    activeReplayer =
+        std::make_shared<TraceReplayer>(readTrace(path), simulateLatency);
+}
+
+std::unique_ptr<I2CInterface>
+    createTraceInterface(uint8_t busId, uint8_t devAddr,
+                         I2CInterface::InitialState initialState,
+                         int maxRetries)
+{
+    if (activeReplayer)
+    {
+        return std::make_unique<ReplayI2CInterface>(busId, devAddr,
+                                                    initialState,
+                                                    activeReplayer);
+    }
+    if (activeWriter)
+    {
+        return std::make_unique<RecordingI2CInterface>(
+            busId, devAddr,
+            I2CDevice::create(busId, devAddr, initialState, maxRetries),
+            activeWriter);
+    }
+    return nullptr;
+}
+
+} // namespace i2c
@@ -0,0 +1,396 @@
+#pragma once
+
+#include "i2c_interface.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace i2c
+{
+
+/** @brief I2C operation recorded in a trace */
+enum class TraceOperation : uint8_t
+{
+    open = 0,
+    close = 1,
+    readByte = 2,
+    readByteData = 3,
+    readWordData = 4,
+    readBlockData = 5,
+    writeByte = 6,
+    writeByteData = 7,
+    writeWordData = 8,
+    writeBlockData = 9
+};
+
+/** @brief One I2C transaction recorded in a trace */
+struct TraceRecord
+{
+    /** @brief I2C operation */
+    TraceOperation operation = TraceOperation::open;
+
+    /** @brief The i2c bus ID */
+    uint8_t busId = 0;
+
+    /** @brief The i2c device address in the bus */
+    uint8_t devAddr = 0;
+
+    /** @brief Register address (command code); 0 if not applicable */
+    uint8_t addr = 0;
+
+    /** @brief Block transfer mode; only used by block operations */
+    I2CInterface::Mode mode = I2CInterface::Mode::SMBUS;
+
+    /** @brief Data read from or written to the device */
+    std::vector<uint8_t> data{};
+
+    /** @brief Whether the operation threw an I2CException */
+    bool failed = false;
+
+    /** @brief Error description if the operation failed */
+    std::string errorInfo{};
+
+    /** @brief errno value if the operation failed */
+    int32_t errorCode = 0;
+
+    /** @brief Time required to perform the operation */
+    std::chrono::microseconds latency{0};
+};
+
+/** @class TraceWriter
+ *  @brief Writes I2C trace records to a compact binary file
+ *
+ * Records are buffered and flushed to the file at most every flushInterval,
+ * and when the writer is destroyed, so tracing does not add a system call to
+ * every I2C operation.  If the process is terminated, up to flushInterval of
+ * records at the end of the trace may be lost.
+ */
+class TraceWriter
+{
+  public:
+    TraceWriter() = delete;
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    /** @brief Constructor
+     *
+     * Creates the trace file and writes the file header.
+     *
+     * @param[in] path - Path of the trace file
+     *
+     * @throw std::runtime_error if the file cannot be created
+     */
+    explicit TraceWriter(const std::string& path);
+
+    /** @brief Write one record to the trace file
+     *
+     * @param[in] record - The trace record
+     */
+    void write(const TraceRecord& record);
+
+    /** @brief Flush the buffered records to the trace file */
+    void flush();
+
+  private:
+    /** @brief Maximum time records are buffered before they are flushed */
+    static constexpr std::chrono::seconds flushInterval{1};
+
+    /** @brief The trace file */
+    std::ofstream file;
+
+    /** @brief Time the records were last flushed */
+    std::chrono::steady_clock::time_point lastFlush;
+};
+
+/** @brief Read all records from a binary trace file
+ *
+ * @param[in] path - Path of the trace file
+ *
+ * @throw std::runtime_error if the file cannot be read or has an invalid format
+ * @return The trace records in the order they were recorded
+ */
+std::vector<TraceRecord> readTrace(const std::string& path);
+
+/** @class RecordingI2CInterface
+ *  @brief I2CInterface that records all operations of another I2CInterface
+ *
+ * Each operation is passed to the wrapped interface.  The operation, data,
+ * result, and latency are then written to a TraceWriter.  Exceptions from the
+ * wrapped interface are recorded and re-thrown.
+ */
+class RecordingI2CInterface : public I2CInterface
+{
+  public:
+    RecordingI2CInterface() = delete;
+
+    /** @brief Constructor
+     *
+     * @param[in] busId - The i2c bus ID
+     * @param[in] devAddr - The device address of the I2C device
+     * @param[in] device - The I2CInterface to record
+     * @param[in] writer - The TraceWriter shared by all recorded devices
+     */
+    RecordingI2CInterface(uint8_t busId, uint8_t devAddr,
+                          std::unique_ptr<I2CInterface> device,
+                          std::shared_ptr<TraceWriter> writer) :
+        busId(busId),
+        devAddr(devAddr), device(std::move(device)), writer(std::move(writer))
+    {}
+
+    /** @copydoc I2CInterface::open() */
+    void open() override;
+
+    /** @copydoc I2CInterface::isOpen() */
+    bool isOpen() const override
+    {
+        return device->isOpen();
+    }
+
+    /** @copydoc I2CInterface::close() */
+    void close() override;
+
+    /** @copydoc I2CInterface::read(uint8_t&) */
+    void read(uint8_t& data) override;
+
+    /** @copydoc I2CInterface::read(uint8_t,uint8_t&) */
+    void read(uint8_t addr, uint8_t& data) override;
+
+    /** @copydoc I2CInterface::read(uint8_t,uint16_t&) */
+    void read(uint8_t addr, uint16_t& data) override;
+
+    /** @copydoc I2CInterface::read(uint8_t,uint8_t&,uint8_t*,Mode) */
+    void read(uint8_t addr, uint8_t& size, uint8_t* data,
+              Mode mode = Mode::SMBUS) override;
+
+    /** @copydoc I2CInterface::write(uint8_t) */
+    void write(uint8_t data) override;
+
+    /** @copydoc I2CInterface::write(uint8_t,uint8_t) */
+    void write(uint8_t addr, uint8_t data) override;
+
+    /** @copydoc I2CInterface::write(uint8_t,uint16_t) */
+    void write(uint8_t addr, uint16_t data) override;
+
+    /** @copydoc I2CInterface::write(uint8_t,uint8_t,const uint8_t*,Mode) */
+    void write(uint8_t addr, uint8_t size, const uint8_t* data,
+               Mode mode = Mode::SMBUS) override;
+
+  private:
+    /** @brief Perform an operation on the wrapped device and record it
+     *
+     * @param[in] record - Record describing the operation.  The data field
+     *                     contains the data to write, if any.
+     * @param[in] operation - Function that performs the operation.  Stores
+     *                        any data read in the record.
+     */
+    template <typename Operation>
+    void perform(TraceRecord& record, Operation&& operation);
+
+    /** @brief The i2c bus ID */
+    uint8_t busId;
+
+    /** @brief The i2c device address in the bus */
+    uint8_t devAddr;
+
+    /** @brief The I2CInterface being recorded */
+    std::unique_ptr<I2CInterface> device;
+
+    /** @brief The TraceWriter shared by all recorded devices */
+    std::shared_ptr<TraceWriter> writer;
+};
+
+/** @class TraceReplayer
+ *  @brief Provides the recorded operations of each device during a replay
+ *
+ * The records of a trace are split into one queue per device.  Devices can
+ * therefore be replayed independently of the order in which they were
+ * accessed.
+ */
+class TraceReplayer
+{
+  public:
+    TraceReplayer() = delete;
+    TraceReplayer(const TraceReplayer&) = delete;
+    TraceReplayer& operator=(const TraceReplayer&) = delete;
+
+    /** @brief Constructor
+     *
+     * @param[in] records - The trace records
+     * @param[in] simulateLatency - Whether to sleep for the recorded latency
+     *                              of each operation
+     */
+    TraceReplayer(std::vector<TraceRecord> records, bool simulateLatency);
+
+    /** @brief Get the next recorded operation of a device
+     *
+     * @param[in] busId - The i2c bus ID
+     * @param[in] devAddr - The device address of the I2C device
+     * @param[out] record - The next trace record of the device
+     *
+     * @return true if a record was found, false if the trace is exhausted
+     */
+    bool next(uint8_t busId, uint8_t devAddr, TraceRecord& record);
+
+    /** @brief Whether the recorded latency of each operation is simulated */
+    bool isLatencySimulated() const
+    {
+        return simulateLatency;
+    }
+
+  private:
+    /** @brief Queue of trace records for each (bus, address) pair */
+    std::map<std::pair<uint8_t, uint8_t>, std::deque<TraceRecord>> queues;
+
+    /** @brief Whether to sleep for the recorded latency of each operation */
+    bool simulateLatency;
+};
+
+/** @class ReplayI2CInterface
+ *  @brief I2CInterface that replays the recorded operations of a device
+ *
+ * Each operation must match the next recorded operation of the device,
+ * including the register address, size, and any data written.  Recorded read
+ * data is returned and recorded failures are thrown as I2CExceptions.
+ *
+ * An I2CException is thrown if the operation does not match the trace or the
+ * trace has no more operations for the device.
+ */
+class ReplayI2CInterface : public I2CInterface
+{
+  public:
+    ReplayI2CInterface() = delete;
+
+    /** @brief Constructor
+     *
+     * @param[in] busId - The i2c bus ID
+     * @param[in] devAddr - The device address of the I2C device
+     * @param[in] initialState - Initial state of the interface.  Opening the
+     *                           interface initially does not use a record.
+     * @param[in] replayer - The TraceReplayer shared by all replayed devices
+     */
+    ReplayI2CInterface(uint8_t busId, uint8_t devAddr,
+                       InitialState initialState,
+                       std::shared_ptr<TraceReplayer> replayer) :
+        busId(busId),
+        devAddr(devAddr), busStr("/dev/i2c-" + std::to_string(busId)),
+        opened(initialState == InitialState::OPEN),
+        replayer(std::move(replayer))
+    {}
+
+    /** @copydoc I2CInterface::open() */
+    void open() override;
+
+    /** @copydoc I2CInterface::isOpen() */
+    bool isOpen() const override
+    {
+        return opened;
+    }
+
+    /** @copydoc I2CInterface::close() */
+    void close() override;
+
+    /** @copydoc I2CInterface::read(uint8_t&) */
+    void read(uint8_t& data) override;
+
+    /** @copydoc I2CInterface::read(uint8_t,uint8_t&) */
+    void read(uint8_t addr, uint8_t& data) override;
+
+    /** @copydoc I2CInterface::read(uint8_t,uint16_t&) */
+    void read(uint8_t addr, uint16_t& data) override;
+
+    /** @copydoc I2CInterface::read(uint8_t,uint8_t&,uint8_t*,Mode) */
+    void read(uint8_t addr, uint8_t& size, uint8_t* data,
+              Mode mode = Mode::SMBUS) override;
+
+    /** @copydoc I2CInterface::write(uint8_t) */
+    void write(uint8_t data) override;
+
+    /** @copydoc I2CInterface::write(uint8_t,uint8_t) */
+    void write(uint8_t addr, uint8_t data) override;
+
+    /** @copydoc I2CInterface::write(uint8_t,uint16_t) */
+    void write(uint8_t addr, uint16_t data) override;
+
+    /** @copydoc I2CInterface::write(uint8_t,uint8_t,const uint8_t*,Mode) */
+    void write(uint8_t addr, uint8_t size, const uint8_t* data,
+               Mode mode = Mode::SMBUS) override;
+
+  private:
+    /** @brief Replay the next recorded operation of the device
+     *
+     * @param[in] operation - The operation being performed
+     * @param[in] addr - Register address; 0 if not applicable
+     * @param[in] mode - Block transfer mode
+     * @param[in] writeData - Data being written, if any
+     * @param[in] readSize - Number of bytes to read for I2C block reads;
+     *                       otherwise ignored
+     *
+     * @throw I2CException on mismatch or if a failure was recorded
+     * @return The data recorded for the operation
+     */
+    std::vector<uint8_t> replay(TraceOperation operation, uint8_t addr,
+                                Mode mode,
+                                const std::vector<uint8_t>& writeData = {},
+                                uint8_t readSize = 0);
+
+    /** @brief The i2c bus ID */
+    uint8_t busId;
+
+    /** @brief The i2c device address in the bus */
+    uint8_t devAddr;
+
+    /** @brief The i2c bus path in /dev */
+    std::string busStr;
+
+    /** @brief Whether the interface is open */
+    bool opened;
+
+    /** @brief The TraceReplayer shared by all replayed devices */
+    std::shared_ptr<TraceReplayer> replayer;
+};
+
+/** @brief Record all I2C operations of interfaces created by create()
+ *
+ * Only affects interfaces created after this function is called.
+ *
+ * @param[in] path - Path of the trace file to write
+ *
+ * @throw std::runtime_error if the file cannot be created
+ */
+void startTraceRecording(const std::string& path);
+
+/** @brief Replay a trace file using interfaces created by create()
+ *
+ * Interfaces created after this function is called do not access hardware.
+ *
+ * @param[in] path - Path of the trace file to read
+ * @param[in] simulateLatency - Whether to sleep for the recorded latency of
+ *                              each operation
+ *
+ * @throw std::runtime_error if the file cannot be read
+ */
+void startTraceReplay(const std::string& path, bool simulateLatency = false);
+
+/** @brief Create an I2CInterface that records or replays a trace if enabled
+ *
+ * @param[in] busId - The i2c bus ID
+ * @param[in] devAddr - The device address of the i2c
+ * @param[in] initialState - Initial state of the I2CInterface object
+ * @param[in] maxRetries - Maximum number of times to retry an I2C operation
+ *
+ * @return The I2CInterface, or nullptr if no trace is being recorded or
+ *         replayed
+ */
+std::unique_ptr<I2CInterface>
+    createTraceInterface(uint8_t busId, uint8_t devAddr,
+                         I2CInterface::InitialState initialState,
+                         int maxRetries);
+
+} // namespace i2c
@@ -0,0 +1,457 @@
+#include "i2c_trace.hpp"
+#include "mocked_i2c_interface.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace i2c;
+
+using ::testing::_;
+using ::testing::An;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+using ::testing::SetArgReferee;
+using ::testing::Throw;
+using ::testing::TypedEq;
+
+using Mode = I2CInterface::Mode;
+using InitialState = I2CInterface::InitialState;
+
+class I2CTraceTests : public ::testing::Test
+{
+  protected:
+    I2CTraceTests()
+    {
+        char name[] = "/tmp/i2c_trace_tests_XXXXXX";
+        int fd = mkstemp(name);
+        EXPECT_NE(fd, -1);
+        ::close(fd);
+        path = name;
+    }
+
+    ~I2CTraceTests() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    /** @brief Path of the temporary trace file */
+    std::string path;
+};
+
+namespace
+{
+
+/** @brief Create a record that completed successfully */
+TraceRecord makeRecord(TraceOperation operation, uint8_t devAddr,
+                       uint8_t addr = 0, std::vector<uint8_t> data = {},
+                       Mode mode = Mode::SMBUS)
+{
+    return TraceRecord{.operation = operation,
+                       .busId = 1,
+                       .devAddr = devAddr,
+                       .addr = addr,
+                       .mode = mode,
+                       .data = std::move(data)};
+}
+
+/** @brief Create a record of an operation that failed */
+TraceRecord makeFailedRecord(TraceOperation operation, uint8_t devAddr,
+                             uint8_t addr, const std::string& errorInfo,
+                             int32_t errorCode)
+{
+    auto record = makeRecord(operation, devAddr, addr);
+    record.failed = true;
+    record.errorInfo = errorInfo;
+    record.errorCode = errorCode;
+    return record;
+}
+
+} // namespace
+
+TEST_F(I2CTraceTests, RecordAndRead)
+{
+    auto device = std::make_unique<MockedI2CInterface>();
+    auto& mock = *device;
+    {
+        ::testing::InSequence seq;
+        EXPECT_CALL(mock, open());
+        EXPECT_CALL(mock, read(An<uint8_t&>()))
+            .WillOnce(SetArgReferee<0>(0x12));
+        EXPECT_CALL(mock, read(0x10, An<uint8_t&>()))
+            .WillOnce(SetArgReferee<1>(0x34));
+        EXPECT_CALL(mock, read(0x11, An<uint16_t&>()))
+            .WillOnce(SetArgReferee<1>(0xBEEF));
+        EXPECT_CALL(mock, read(0x12, _, _, Mode::SMBUS))
+            .WillOnce(Invoke([](uint8_t, uint8_t& size, uint8_t* data, Mode) {
+                size = 2;
+                data[0] = 0xA1;
+                data[1] = 0xA2;
+            }));
+        EXPECT_CALL(mock, read(0x13, _, _, Mode::I2C))
+            .WillOnce(Invoke([](uint8_t, uint8_t& size, uint8_t* data, Mode) {
+                EXPECT_EQ(size, 3);
+                data[0] = 0xB1;
+                data[1] = 0xB2;
+                data[2] = 0xB3;
+            }));
+        EXPECT_CALL(mock, write(TypedEq<uint8_t>(0x55)));
+        EXPECT_CALL(mock, write(0x20, TypedEq<uint8_t>(0x66)));
+        EXPECT_CALL(mock, write(0x21, TypedEq<uint16_t>(0x1234)));
+        EXPECT_CALL(mock, write(0x22, 2, _, Mode::SMBUS));
+        EXPECT_CALL(mock, write(0x23, 1, _, Mode::I2C));
+        EXPECT_CALL(mock, read(0x30, An<uint8_t&>()))
+            .WillOnce(Throw(I2CException("Failed to read byte", "/dev/i2c-1",
+                                         0x70, EIO)));
+        EXPECT_CALL(mock, close());
+    }
+
+    {
+        auto writer = std::make_shared<TraceWriter>(path);
+        RecordingI2CInterface interface{1, 0x70, std::move(device), writer};
+
+        interface.open();
+
+        uint8_t byte = 0;
+        interface.read(byte);
+        EXPECT_EQ(byte, 0x12);
+        interface.read(0x10, byte);
+        EXPECT_EQ(byte, 0x34);
+
+        uint16_t word = 0;
+        interface.read(0x11, word);
+        EXPECT_EQ(word, 0xBEEF);
+
+        uint8_t size = 0;
+        uint8_t block[32] = {};
+        interface.read(0x12, size, block, Mode::SMBUS);
+        EXPECT_EQ(size, 2);
+        size = 3;
+        interface.read(0x13, size, block, Mode::I2C);
+
+        interface.write(uint8_t{0x55});
+        interface.write(0x20, uint8_t{0x66});
+        interface.write(0x21, uint16_t{0x1234});
+        const uint8_t writeData[] = {0xC1, 0xC2};
+        interface.write(0x22, 2, writeData, Mode::SMBUS);
+        interface.write(0x23, 1, writeData, Mode::I2C);
+
+        try
+        {
+            interface.read(0x30, byte);
+            ADD_FAILURE() << "Should not have reached this line.";
+        }
+        catch (const I2CException& e)
+        {
+            EXPECT_EQ(e.errorCode, EIO);
+        }
+
+        interface.close();
+    }
+
+    auto records = readTrace(path);
+    ASSERT_EQ(records.size(), 13);
+
+    for (const auto& record : records)
+    {
+        EXPECT_EQ(record.busId, 1);
+        EXPECT_EQ(record.devAddr, 0x70);
+    }
+
+    EXPECT_EQ(records[0].operation, TraceOperation::open);
+    EXPECT_TRUE(records[0].data.empty());
+
+    EXPECT_EQ(records[1].operation, TraceOperation::readByte);
+    EXPECT_THAT(records[1].data, ElementsAre(0x12));
+
+    EXPECT_EQ(records[2].operation, TraceOperation::readByteData);
+    EXPECT_EQ(records[2].addr, 0x10);
+    EXPECT_THAT(records[2].data, ElementsAre(0x34));
+
+    EXPECT_EQ(records[3].operation, TraceOperation::readWordData);
+    EXPECT_EQ(records[3].addr, 0x11);
+    EXPECT_THAT(records[3].data, ElementsAre(0xEF, 0xBE));
+
+    EXPECT_EQ(records[4].operation, TraceOperation::readBlockData);
+    EXPECT_EQ(records[4].addr, 0x12);
+    EXPECT_EQ(records[4].mode, Mode::SMBUS);
+    EXPECT_THAT(records[4].data, ElementsAre(0xA1, 0xA2));
+
+    EXPECT_EQ(records[5].operation, TraceOperation::readBlockData);
+    EXPECT_EQ(records[5].addr, 0x13);
+    EXPECT_EQ(records[5].mode, Mode::I2C);
+    EXPECT_THAT(records[5].data, ElementsAre(0xB1, 0xB2, 0xB3));
+
+    EXPECT_EQ(records[6].operation, TraceOperation::writeByte);
+    EXPECT_THAT(records[6].data, ElementsAre(0x55));
+
+    EXPECT_EQ(records[7].operation, TraceOperation::writeByteData);
+    EXPECT_EQ(records[7].addr, 0x20);
+    EXPECT_THAT(records[7].data, ElementsAre(0x66));
+
+    EXPECT_EQ(records[8].operation, TraceOperation::writeWordData);
+    EXPECT_EQ(records[8].addr, 0x21);
+    EXPECT_THAT(records[8].data, ElementsAre(0x34, 0x12));
+
+    EXPECT_EQ(records[9].operation, TraceOperation::writeBlockData);
+    EXPECT_EQ(records[9].addr, 0x22);
+    EXPECT_EQ(records[9].mode, Mode::SMBUS);
+    EXPECT_THAT(records[9].data, ElementsAre(0xC1, 0xC2));
+
+    EXPECT_EQ(records[10].operation, TraceOperation::writeBlockData);
+    EXPECT_EQ(records[10].addr, 0x23);
+    EXPECT_EQ(records[10].mode, Mode::I2C);
+    EXPECT_THAT(records[10].data, ElementsAre(0xC1));
+
+    EXPECT_EQ(records[11].operation, TraceOperation::readByteData);
+    EXPECT_EQ(records[11].addr, 0x30);
+    EXPECT_TRUE(records[11].failed);
+    EXPECT_EQ(records[11].errorCode, EIO);
+    EXPECT_EQ(records[11].errorInfo, "Failed to read byte");
+    EXPECT_TRUE(records[11].data.empty());
+
+    EXPECT_EQ(records[12].operation, TraceOperation::close);
+
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        EXPECT_EQ(records[i].failed, i == 11);
+    }
+}
+
+TEST_F(I2CTraceTests, WriteAndRead)
+{
+    std::vector<TraceRecord> written{
+        makeRecord(TraceOperation::readBlockData, 0x70, 0x12, {1, 2, 3},
+                   Mode::I2C),
+        makeFailedRecord(TraceOperation::writeWordData, 0x71, 0x21,
+                         "Failed to write word", ENXIO),
+        makeFailedRecord(TraceOperation::open, 0x72, 0, "", 0)};
+    written[0].latency = std::chrono::microseconds(1234);
+
+    {
+        TraceWriter writer{path};
+        for (const auto& record : written)
+        {
+            writer.write(record);
+        }
+    }
+
+    auto records = readTrace(path);
+    ASSERT_EQ(records.size(), written.size());
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        EXPECT_EQ(records[i].operation, written[i].operation);
+        EXPECT_EQ(records[i].busId, written[i].busId);
+        EXPECT_EQ(records[i].devAddr, written[i].devAddr);
+        EXPECT_EQ(records[i].addr, written[i].addr);
+        EXPECT_EQ(records[i].mode, written[i].mode);
+        EXPECT_EQ(records[i].data, written[i].data);
+        EXPECT_EQ(records[i].failed, written[i].failed);
+        EXPECT_EQ(records[i].errorInfo, written[i].errorInfo);
+        EXPECT_EQ(records[i].errorCode, written[i].errorCode);
+        EXPECT_EQ(records[i].latency, written[i].latency);
+    }
+
+    // Flushing makes the records readable while the writer is open
+    TraceWriter writer{path};
+    writer.write(written[0]);
+    writer.flush();
+    EXPECT_EQ(readTrace(path).size(), 1);
+}
+
+TEST_F(I2CTraceTests, ReadInvalidTrace)
+{
+    // Missing file
+    EXPECT_THROW(readTrace(path + ".missing"), std::runtime_error);
+
+    // Invalid header
+    {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        file << "I2CX";
+    }
+    EXPECT_THROW(readTrace(path), std::runtime_error);
+
+    // Truncated record
+    {
+        TraceWriter writer{path};
+        writer.write(makeRecord(TraceOperation::readWordData, 0x70, 0x11,
+                                {0x34, 0x12}));
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_THROW(readTrace(path), std::runtime_error);
+}
+
+TEST_F(I2CTraceTests, ReplayMatch)
+{
+    // The records of the two devices are interleaved
+    std::vector<TraceRecord> records{
+        makeRecord(TraceOperation::open, 0x70),
+        makeRecord(TraceOperation::readByte, 0x71, 0, {0x99}),
+        makeRecord(TraceOperation::readByte, 0x70, 0, {0x12}),
+        makeRecord(TraceOperation::readByteData, 0x70, 0x10, {0x34}),
+        makeRecord(TraceOperation::readWordData, 0x70, 0x11, {0xEF, 0xBE}),
+        makeRecord(TraceOperation::readBlockData, 0x70, 0x12, {0xA1, 0xA2}),
+        makeRecord(TraceOperation::readBlockData, 0x70, 0x13,
+                   {0xB1, 0xB2, 0xB3}, Mode::I2C),
+        makeRecord(TraceOperation::writeByte, 0x70, 0, {0x55}),
+        makeRecord(TraceOperation::writeByteData, 0x70, 0x20, {0x66}),
+        makeRecord(TraceOperation::writeWordData, 0x70, 0x21, {0x34, 0x12}),
+        makeRecord(TraceOperation::writeBlockData, 0x70, 0x22, {0xC1, 0xC2}),
+        makeRecord(TraceOperation::writeBlockData, 0x70, 0x23, {0xC1},
+                   Mode::I2C),
+        makeFailedRecord(TraceOperation::readByteData, 0x70, 0x30,
+                         "Failed to read byte", EIO),
+        makeRecord(TraceOperation::close, 0x70)};
+    auto replayer = std::make_shared<TraceReplayer>(records, false);
+
+    ReplayI2CInterface interface{1, 0x70, InitialState::CLOSED, replayer};
+    EXPECT_FALSE(interface.isOpen());
+    interface.open();
+    EXPECT_TRUE(interface.isOpen());
+
+    uint8_t byte = 0;
+    interface.read(byte);
+    EXPECT_EQ(byte, 0x12);
+    interface.read(0x10, byte);
+    EXPECT_EQ(byte, 0x34);
+
+    uint16_t word = 0;
+    interface.read(0x11, word);
+    EXPECT_EQ(word, 0xBEEF);
+
+    uint8_t size = 0;
+    uint8_t block[32] = {};
+    interface.read(0x12, size, block, Mode::SMBUS);
+    EXPECT_EQ(size, 2);
+    EXPECT_EQ(block[0], 0xA1);
+    EXPECT_EQ(block[1], 0xA2);
+    size = 3;
+    interface.read(0x13, size, block, Mode::I2C);
+    EXPECT_EQ(size, 3);
+    EXPECT_EQ(block[2], 0xB3);
+
+    interface.write(uint8_t{0x55});
+    interface.write(0x20, uint8_t{0x66});
+    interface.write(0x21, uint16_t{0x1234});
+    const uint8_t writeData[] = {0xC1, 0xC2};
+    interface.write(0x22, 2, writeData, Mode::SMBUS);
+    interface.write(0x23, 1, writeData, Mode::I2C);
+
+    // Recorded failure is thrown
+    try
+    {
+        interface.read(0x30, byte);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const I2CException& e)
+    {
+        EXPECT_EQ(e.errorCode, EIO);
+        EXPECT_THAT(e.what(), HasSubstr("Failed to read byte"));
+        EXPECT_THAT(e.what(), HasSubstr("/dev/i2c-1"));
+    }
+
+    interface.close();
+    EXPECT_FALSE(interface.isOpen());
+
+    // The other device is replayed independently
+    ReplayI2CInterface other{1, 0x71, InitialState::OPEN, replayer};
+    EXPECT_TRUE(other.isOpen());
+    other.read(byte);
+    EXPECT_EQ(byte, 0x99);
+}
+
+TEST_F(I2CTraceTests, ReplayMismatch)
+{
+    std::vector<TraceRecord> records{
+        makeRecord(TraceOperation::readByteData, 0x70, 0x10, {0x34}),
+        makeRecord(TraceOperation::writeByteData, 0x70, 0x20, {0x66}),
+        makeRecord(TraceOperation::readBlockData, 0x70, 0x13, {0xB1, 0xB2},
+                   Mode::I2C),
+        makeRecord(TraceOperation::writeBlockData, 0x70, 0x22, {0xC1},
+                   Mode::I2C),
+        makeRecord(TraceOperation::readWordData, 0x70, 0x11, {0x34, 0x12})};
+    auto replayer = std::make_shared<TraceReplayer>(records, false);
+    ReplayI2CInterface interface{1, 0x70, InitialState::OPEN, replayer};
+
+    uint8_t byte = 0;
+    uint16_t word = 0;
+    uint8_t size = 3;
+    uint8_t block[32] = {};
+
+    // Different register address
+    try
+    {
+        interface.read(0x11, byte);
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const I2CException& e)
+    {
+        EXPECT_THAT(e.what(), HasSubstr("I2C trace mismatch"));
+    }
+
+    // Different data written
+    EXPECT_THROW(interface.write(0x20, uint8_t{0x67}), I2CException);
+
+    // Different I2C block read size
+    EXPECT_THROW(interface.read(0x13, size, block, Mode::I2C), I2CException);
+
+    // Different block mode
+    EXPECT_THROW(interface.write(0x22, 1, block, Mode::SMBUS), I2CException);
+
+    // Different operation
+    EXPECT_THROW(interface.read(0x11, byte), I2CException);
+
+    // Each mismatch used a record
+    EXPECT_THROW(interface.read(0x11, word), I2CException);
+}
+
+TEST_F(I2CTraceTests, ReplayEndOfTrace)
+{
+    std::vector<TraceRecord> records{
+        makeRecord(TraceOperation::writeByte, 0x70, 0, {0x55})};
+    auto replayer = std::make_shared<TraceReplayer>(records, false);
+
+    ReplayI2CInterface interface{1, 0x70, InitialState::OPEN, replayer};
+    interface.write(uint8_t{0x55});
+    try
+    {
+        interface.write(uint8_t{0x55});
+        ADD_FAILURE() << "Should not have reached this line.";
+    }
+    catch (const I2CException& e)
+    {
+        EXPECT_THAT(e.what(), HasSubstr("End of I2C trace"));
+    }
+
+    // A device that is not in the trace
+    ReplayI2CInterface missing{2, 0x70, InitialState::CLOSED, replayer};
+    EXPECT_THROW(missing.open(), I2CException);
+}
+
+TEST_F(I2CTraceTests, ReplayFile)
+{
+    {
+        TraceWriter writer{path};
+        writer.write(makeRecord(TraceOperation::readWordData, 0x70, 0x11,
+                                {0xEF, 0xBE}));
+    }
+
+    startTraceReplay(path);
+    auto interface = createTraceInterface(1, 0x70, InitialState::OPEN, 0);
+    ASSERT_NE(interface, nullptr);
+
+    uint16_t word = 0;
+    interface->read(0x11, word);
+    EXPECT_EQ(word, 0xBEEF);
+    EXPECT_THROW(interface->read(0x11, word), I2CException);
+}
@@ -26,10 +26,6 @@ namespace power
 namespace util
 {
 
-constexpr auto MAPPER_BUSNAME = "xyz.openbmc_project.ObjectMapper";
-constexpr auto MAPPER_PATH = "/xyz/openbmc_project/object_mapper";
-constexpr auto MAPPER_INTERFACE = "xyz.openbmc_project.ObjectMapper";
-
 using namespace phosphor::logging;
 using json = nlohmann::json;
 